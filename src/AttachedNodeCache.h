@@ -0,0 +1,61 @@
+#pragma once
+
+namespace frik
+{
+    /**
+     * True if the node is the root or its parent chain reaches the root, walking parent pointers only.
+     * Detached nodes have a null parent at the top of their sub-tree so the walk stops before the root.
+     */
+    inline bool isAttachedUnder(const RE::NiAVObject* node, const RE::NiAVObject* root)
+    {
+        while (node && node != root) {
+            node = node->parent;
+        }
+        return node != nullptr;
+    }
+
+    /**
+     * Node resolved by name under a root where it can be removed and re-created while cached (e.g. the Power Armor
+     * pauldrons that come and go with the armor pieces).
+     * The node is held by reference so a removed node isn't freed while cached, and verified on every get by walking its
+     * parents to the root, a few pointer reads instead of the name search of the whole tree.
+     * A detached node is searched again right away, a missing node is searched again at low frequency.
+     */
+    class AttachedNodeCache
+    {
+    public:
+        // gets between searches while the node is missing (~1 second at 90 FPS)
+        static constexpr int RETRY_SEARCH_GETS = 90;
+
+        /**
+         * Get the cached node if still attached under the root, otherwise search it with "find(root)".
+         */
+        template <typename Find>
+        RE::NiNode* get(RE::NiNode* root, Find&& find)
+        {
+            if (_node) {
+                if (isAttachedUnder(_node.get(), root)) {
+                    return _node.get();
+                }
+                _node.reset();
+                _getsToRetry = 0;
+            }
+            if (--_getsToRetry > 0) {
+                return nullptr;
+            }
+            _getsToRetry = RETRY_SEARCH_GETS;
+            _node.reset(find(root));
+            return _node.get();
+        }
+
+        void reset()
+        {
+            _node.reset();
+            _getsToRetry = 0;
+        }
+
+    private:
+        RE::NiPointer<RE::NiNode> _node;
+        int _getsToRetry = 0;
+    };
+}
@@ -10,6 +10,35 @@
 
 using namespace common;
 
+namespace
+{
+    /**
+     * Get the view over the weapons offsets blob embedded resource memory, no copy or parsing.
+     */
+    frik::weapon_offsets_blob::View getEmbeddedWeaponsOffsetsBlob(const HMODULE module)
+    {
+        const auto resource = FindResource(module, MAKEINTRESOURCE(IDR_WEAPONS_OFFSETS_BLOB), RT_RCDATA);
+        const auto loaded = resource ? LoadResource(module, resource) : nullptr;
+        if (!loaded) {
+            logger::error("Failed to load embedded weapons offsets resource");
+            return {};
+        }
+        frik::weapon_offsets_blob::View view(LockResource(loaded), SizeofResource(module, resource));
+        if (!view.isValid()) {
+            logger::error("Invalid embedded weapons offsets blob");
+        }
+        return view;
+    }
+
+    /**
+     * The file of the custom weapon offsets, same path (and write-behind key) for save and remove.
+     */
+    std::string getWeaponOffsetsFilePath(const std::string& fullName)
+    {
+        return (std::filesystem::path{ frik::WEAPONS_OFFSETS_PATH } / (common::sanitizePathWindows(fullName) + ".json")).string();
+    }
+}
+
 namespace frik
 {
     /**
@@ -19,11 +48,14 @@ namespace frik
      */
     void Config::load()
     {
+        _writeBehind.flush();
         setupFolders();
         migrateConfigFilesIfNeeded();
 
         logger::info("Load ini config...");
+        _isExplicitLoad = true;
         loadIniConfig();
+        _isExplicitLoad = false;
 
         logger::info("Load hide meshes...");
         loadHideMeshes();
@@ -41,7 +73,47 @@ namespace frik
     void Config::loadIniOnly()
     {
         logger::info("Load ini config only...");
+        _writeBehind.flush();
+        _isExplicitLoad = true;
         loadIniConfig();
+        _isExplicitLoad = false;
+    }
+
+    /**
+     * Save all the config values to the ini file now.
+     * Serialized with the write-behind worker (after the pending writes) so it never races a worker write of the ini.
+     */
+    void Config::save()
+    {
+        _writeBehind.writeNow([this] { updateIniFileAtomically([this](CSimpleIniA& ini) { saveIniConfigInternal(ini); }); }, _iniFilePath);
+    }
+
+    /**
+     * Update values in the ini file through a temp file (see replaceFileAtomically), same as the offsets JSON files, so a
+     * crash or failure mid-write never leaves a truncated FRIK.ini. The current file is loaded first to keep the comments
+     * and all the values not set by the update.
+     */
+    void Config::updateIniFileAtomically(const std::function<void(CSimpleIniA&)>& update) const
+    {
+        const bool saved = replaceFileAtomically(_iniFilePath, [&update](const std::string& tempPath) {
+            CSimpleIniA ini;
+            if (ini.LoadFile(tempPath.c_str()) < 0) {
+                return false;
+            }
+            update(ini);
+            return ini.SaveFile(tempPath.c_str()) >= 0;
+        });
+        if (!saved) {
+            logger::warn("Failed to save ini config file: {}", _iniFilePath);
+        }
+    }
+
+    /**
+     * Write all the pending config changes now, called on safe points before the game may exit (pause/loading menu).
+     */
+    void Config::flushPendingWrites()
+    {
+        _writeBehind.flush();
     }
 
     /**
@@ -51,6 +123,8 @@ namespace frik
     void Config::reloadForFalloutLondonVR()
     {
         stopIniConfigFileWatch();
+        // pending writes are of the previous ini file
+        _writeBehind.flush();
         _iniFilePath = FRIK_FOLVR_INI_PATH;
         loadIniOnly();
     }
@@ -58,124 +132,149 @@ namespace frik
     void Config::setFlashlightLocation(const FlashlightLocation location)
     {
         flashlightLocation = location;
-        saveIniConfigValue(INI_SECTION_MAIN, "iFlashlightLocation", static_cast<int>(flashlightLocation));
+        queueIniConfigValueSave(INI_SECTION_MAIN, "iFlashlightLocation", static_cast<int>(flashlightLocation));
     }
 
     void Config::toggleIsHoloPipboy()
     {
         isHoloPipboy = !isHoloPipboy;
-        saveIniConfigValue(INI_SECTION_MAIN, "HoloPipBoyEnabled", isHoloPipboy);
+        queueIniConfigValueSave(INI_SECTION_MAIN, "HoloPipBoyEnabled", isHoloPipboy);
     }
 
     void Config::toggleDampenPipboyScreen()
     {
         dampenPipboyScreenMode = static_cast<DampenPipboyScreenMode>((static_cast<uint8_t>(dampenPipboyScreenMode) + 1) % 3);
-        saveIniConfigValue(INI_SECTION_MAIN, "iDampenPipboyScreenMode", static_cast<int>(dampenPipboyScreenMode));
+        queueIniConfigValueSave(INI_SECTION_MAIN, "iDampenPipboyScreenMode", static_cast<int>(dampenPipboyScreenMode));
     }
 
     void Config::togglePipBoyOpenWhenLookAt()
     {
         pipboyOpenWhenLookAt = !pipboyOpenWhenLookAt;
-        saveIniConfigValue(INI_SECTION_MAIN, "PipBoyOpenWhenLookAt", pipboyOpenWhenLookAt);
+        queueIniConfigValueSave(INI_SECTION_MAIN, "PipBoyOpenWhenLookAt", pipboyOpenWhenLookAt);
     }
 
     void Config::savePipboyScale(const float scale)
     {
         pipBoyScale = scale;
-        saveIniConfigValue(INI_SECTION_MAIN, "PipboyScale", pipBoyScale);
+        queueIniConfigValueSave(INI_SECTION_MAIN, "PipboyScale", pipBoyScale);
     }
 
     void Config::saveIsPlayingSeated(const bool iIsPlayingSeated)
     {
         this->isPlayingSeated = iIsPlayingSeated;
-        saveIniConfigValue(INI_SECTION_MAIN, "bIsPlayingSeated", iIsPlayingSeated);
+        rebuildActiveProfile();
+        queueIniConfigValueSave(INI_SECTION_MAIN, "bIsPlayingSeated", iIsPlayingSeated);
     }
 
     void Config::saveHideHeadEquipment(const bool hide)
     {
         hideHeadEquipment = hide;
-        saveIniConfigValue(INI_SECTION_MAIN, "bHidePlayerHeadEquipment", hide);
+        queueIniConfigValueSave(INI_SECTION_MAIN, "bHidePlayerHeadEquipment", hide);
     }
 
     void Config::saveDampenHands(const bool iDampenHands)
     {
         this->dampenHands = iDampenHands;
-        saveIniConfigValue(INI_SECTION_MAIN, "DampenHands", iDampenHands);
+        queueIniConfigValueSave(INI_SECTION_MAIN, "DampenHands", iDampenHands);
     }
 
-    float Config::getPlayerBodyOffsetUp() const
+    /**
+     * Set the PA state of the active profile, called on skeleton init as the skeleton is re-created on PA change.
+     */
+    void Config::setActiveProfileInPowerArmor(const bool inPowerArmor)
+    {
+        _activeProfileInPowerArmor = inPowerArmor;
+        rebuildActiveProfile();
+    }
+
+    /**
+     * Build a new immutable active profile snapshot from the current values and swap it in.
+     */
+    void Config::rebuildActiveProfile()
     {
+        const bool inPA = _activeProfileInPowerArmor;
+        auto profile = std::make_shared<ActiveProfileConfig>();
+        profile->inPowerArmor = inPA;
+        profile->isPlayingSeated = isPlayingSeated;
         if (isPlayingSeated) {
-            return f4vr::isInPowerArmor() ? playerBodyOffsetUpSittingInPA : playerBodyOffsetUpSitting;
+            profile->playerHMDOffsetUp = inPA ? playerHMDOffsetUpSittingInPA : playerHMDOffsetUpSitting;
+            profile->playerBodyOffsetUp = inPA ? playerBodyOffsetUpSittingInPA : playerBodyOffsetUpSitting;
+            profile->playerBodyOffsetForward = inPA ? playerBodyOffsetForwardSittingInPA : playerBodyOffsetForwardSitting;
+        } else {
+            profile->playerHMDOffsetUp = inPA ? playerHMDOffsetUpStandingInPA : playerHMDOffsetUpStanding;
+            profile->playerBodyOffsetUp = inPA ? playerBodyOffsetUpStandingInPA : playerBodyOffsetUpStanding;
+            profile->playerBodyOffsetForward = inPA ? playerBodyOffsetForwardStandingInPA : playerBodyOffsetForwardStanding;
         }
-        return f4vr::isInPowerArmor() ? playerBodyOffsetUpStandingInPA : playerBodyOffsetUpStanding;
+        _activeProfile.store(std::move(profile));
+    }
+
+    float Config::getPlayerBodyOffsetUp() const
+    {
+        return getActiveProfile()->playerBodyOffsetUp;
     }
 
     void Config::setPlayerBodyOffsetUp(const float value)
     {
         if (isPlayingSeated) {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerBodyOffsetUpSittingInPA = value;
             } else {
                 playerBodyOffsetUpSitting = value;
             }
         } else {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerBodyOffsetUpStandingInPA = value;
             } else {
                 playerBodyOffsetUpStanding = value;
             }
         }
+        rebuildActiveProfile();
     }
 
     float Config::getPlayerBodyOffsetForward() const
     {
-        if (isPlayingSeated) {
-            return f4vr::isInPowerArmor() ? playerBodyOffsetForwardSittingInPA : playerBodyOffsetForwardSitting;
-        }
-        return f4vr::isInPowerArmor() ? playerBodyOffsetForwardStandingInPA : playerBodyOffsetForwardStanding;
+        return getActiveProfile()->playerBodyOffsetForward;
     }
 
     void Config::setPlayerBodyOffsetForward(const float value)
     {
         if (isPlayingSeated) {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerBodyOffsetForwardSittingInPA = value;
             } else {
                 playerBodyOffsetForwardSitting = value;
             }
         } else {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerBodyOffsetForwardStandingInPA = value;
             } else {
                 playerBodyOffsetForwardStanding = value;
             }
         }
+        rebuildActiveProfile();
     }
 
     float Config::getPlayerHMDOffsetUp() const
     {
-        if (isPlayingSeated) {
-            return f4vr::isInPowerArmor() ? playerHMDOffsetUpSittingInPA : playerHMDOffsetUpSitting;
-        }
-        return f4vr::isInPowerArmor() ? playerHMDOffsetUpStandingInPA : playerHMDOffsetUpStanding;
+        return getActiveProfile()->playerHMDOffsetUp;
     }
 
     void Config::setPlayerHMDOffsetUp(const float value)
     {
         if (isPlayingSeated) {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerHMDOffsetUpSittingInPA = value;
             } else {
                 playerHMDOffsetUpSitting = value;
             }
         } else {
-            if (f4vr::isInPowerArmor()) {
+            if (_activeProfileInPowerArmor) {
                 playerHMDOffsetUpStandingInPA = value;
             } else {
                 playerHMDOffsetUpStanding = value;
             }
         }
+        rebuildActiveProfile();
     }
 
     /**
@@ -201,32 +300,29 @@ namespace frik
     {
         const auto key = getPipboyOffsetKey();
         _pipboyOffsets[key] = transform;
-        return saveOffsetsToJsonFile(key, transform, getPipboyOffsetPath());
+        queueOffsetsJsonFileSave(key, transform, getPipboyOffsetPath());
+        return true;
     }
 
     /**
      * Get weapon offsets for given weapon name and mode.
-     * Use non-PA mode if PA mode offsets not found.
+     * Use non-PA mode if PA mode offsets not found (resolved in advance in the lookup table).
      */
     std::optional<RE::NiTransform> Config::getWeaponOffsets(const std::string& name, const WeaponOffsetsMode& mode, const bool inPA) const
     {
-        const auto it = _weaponsOffsets.find(getWeaponNameWithMode(name, mode, inPA, f4vr::isLeftHandedMode()));
-        if (it != _weaponsOffsets.end()) {
-            return it->second;
-        }
-        // Check without PA (historic)
-        return inPA ? getWeaponOffsets(name, mode, false) : std::nullopt;
+        return _weaponsResolvedOffsets.find(name, mode, inPA, f4vr::isLeftHandedMode());
     }
 
     /**
-     * Save the weapon offset to config and filesystem.
+     * Save the weapon offset to config and filesystem (file write is queued).
      */
     bool Config::saveWeaponOffsets(const std::string& name, const RE::NiTransform& transform, const WeaponOffsetsMode& mode, const bool inPA)
     {
         const auto fullName = getWeaponNameWithMode(name, mode, inPA, f4vr::isLeftHandedMode());
-        _weaponsOffsets[fullName] = transform;
-        const auto offsetFilePath = fs::path{ WEAPONS_OFFSETS_PATH } / (sanitizePathWindows(fullName) + ".json");
-        return saveOffsetsToJsonFile(fullName, transform, offsetFilePath.string());
+        _weaponsCustomOffsets.save(fullName, transform);
+        rebuildWeaponsResolvedOffsets();
+        queueOffsetsJsonFileSave(fullName, transform, getWeaponOffsetsFilePath(fullName));
+        return true;
     }
 
     /**
@@ -235,20 +331,39 @@ namespace frik
     void Config::removeWeaponOffsets(const std::string& name, const WeaponOffsetsMode& mode, const bool inPA, const bool replaceWithEmbedded)
     {
         const auto fullName = getWeaponNameWithMode(name, mode, inPA, f4vr::isLeftHandedMode());
-        _weaponsOffsets.erase(fullName);
-        if (replaceWithEmbedded && _weaponsEmbeddedOffsets.contains(fullName)) {
-            _weaponsOffsets[fullName] = _weaponsEmbeddedOffsets[fullName];
-        }
+        _weaponsCustomOffsets.remove(fullName, replaceWithEmbedded);
+        rebuildWeaponsResolvedOffsets();
 
-        const auto path = WEAPONS_OFFSETS_PATH + "\\" + fullName + ".json";
+        const auto path = getWeaponOffsetsFilePath(fullName);
         logger::info("Removing weapon offsets '{}', file: '{}'", fullName.c_str(), path.c_str());
-        if (!std::filesystem::remove(WEAPONS_OFFSETS_PATH + "\\" + fullName + ".json")) {
-            logger::warn("Failed to remove weapon offset file: {}", fullName.c_str());
-        }
+        // same key as the file save so a pending save of the file is replaced by the removal
+        _writeBehind.enqueue(path, [path, fullName] {
+            if (!std::filesystem::remove(path)) {
+                logger::warn("Failed to remove weapon offset file: {}", fullName.c_str());
+            }
+        });
+    }
+
+    /**
+     * Queue saving the offsets json file on the write-behind worker.
+     * Written to a temp file that replaces the original file so a crash mid-write never leaves a corrupted file.
+     */
+    void Config::queueOffsetsJsonFileSave(const std::string& key, const RE::NiTransform& transform, const std::string& path)
+    {
+        _writeBehind.enqueue(path, [this, key, transform, path] {
+            if (!replaceFileAtomically(path, [&](const std::string& tempPath) { return saveOffsetsToJsonFile(key, transform, tempPath); })) {
+                logger::warn("Failed to save offsets '{}' to file: '{}'", key, path);
+            }
+        }, path);
     }
 
     void Config::loadIniConfigInternal(const CSimpleIniA& ini)
     {
+        if (!_isExplicitLoad && _writeBehind.isSelfWrite(_iniFilePath)) {
+            logger::debug("Ignore ini file reload of self-originated write");
+            return;
+        }
+
         // Player/Skeleton
         setScale = ini.GetBoolValue(INI_SECTION_MAIN, "setScale", false);
         fVrScale = static_cast<float>(ini.GetDoubleValue(INI_SECTION_MAIN, "fVrScale", 70.0));
@@ -258,6 +373,7 @@ namespace frik
         // Head Geometry Hide
         hideHead = ini.GetBoolValue(INI_SECTION_MAIN, "bHidePlayerHead");
         hideHeadEquipment = ini.GetBoolValue(INI_SECTION_MAIN, "bHidePlayerHeadEquipment");
+        hideHeadEquipmentVerifyInterval = static_cast<int>(ini.GetLongValue(INI_SECTION_MAIN, "iHidePlayerHeadEquipmentVerifyInterval", 2000));
         hideSkin = ini.GetBoolValue(INI_SECTION_MAIN, "bHidePlayerSkin");
 
         // is the player playing standing or sitting
@@ -339,6 +455,7 @@ namespace frik
         selfieIgnoreHideFlags = ini.GetBoolValue(INI_SECTION_MAIN, "bSelfieIgnoreHideFlags", true);
         scopeAdjustDistance = static_cast<float>(ini.GetDoubleValue(INI_SECTION_MAIN, "ScopeAdjustDistance", 15.f));
         openConfigurationModePressDelay = static_cast<float>(ini.GetDoubleValue(INI_SECTION_MAIN, "fOpenConfigurationModePressDelay", 1.5f));
+        boneSphereEventsPerFrame = static_cast<int>(ini.GetLongValue(INI_SECTION_MAIN, "iBoneSphereEventsPerFrame", 16));
 
         // special disable of Fallout London so Pipboy can be used - a hacky hack for a specific player
         ignoreFalloutLondonVR = ini.GetBoolValue(INI_SECTION_MAIN, "bIgnoreFalloutLondonVR", true);
@@ -353,6 +470,8 @@ namespace frik
         stoppingMultiplierHorizontal = static_cast<float>(ini.GetDoubleValue(INI_SECTION_SMOOTH_MOVEMENT, "StoppingMultiplierHorizontal", 0.6f));
         disableInteriorSmoothing = ini.GetBoolValue(INI_SECTION_SMOOTH_MOVEMENT, "DisableInteriorSmoothing", true);
         disableInteriorSmoothingHorizontal = ini.GetBoolValue(INI_SECTION_SMOOTH_MOVEMENT, "DisableInteriorSmoothingHorizontal", true);
+
+        rebuildActiveProfile();
     }
 
     void Config::saveIniConfigInternal(CSimpleIniA& ini)
@@ -400,6 +519,7 @@ namespace frik
 
         createFileFromResourceIfNotExists(MESH_HIDE_SKINS_INI_PATH, _module, IDR_MESH_HIDE_SKINS, true);
         _skinGeometry = loadListFromFile(MESH_HIDE_SKINS_INI_PATH);
+        _hideMeshesVersion++;
 
         createFileFromResourceIfNotExists(MESH_HIDE_SLOTS_INI_PATH, _module, IDR_MESH_HIDE_SLOTS, true);
         loadHideEquipmentSlots();
@@ -447,19 +567,28 @@ namespace frik
     }
 
     /**
-     * Load all the weapons offsets embedded in resource and override custom from filesystem.
+     * Load the weapons offsets embedded in resource (precompiled blob used in-place) and the custom from filesystem.
+     * Custom offsets override embedded offsets on lookup.
      */
     void Config::loadWeaponsOffsets()
     {
-        _weaponsOffsets.clear();
-        _weaponsEmbeddedOffsets = loadEmbeddedOffsets(200, 600);
-        _weaponsOffsets.insert(_weaponsEmbeddedOffsets.begin(), _weaponsEmbeddedOffsets.end());
-
-        const auto weaponCustomOffsets = loadOffsetsFromFilesystem(WEAPONS_OFFSETS_PATH);
-        for (auto& [key, value] : weaponCustomOffsets) {
-            _weaponsOffsets.insert_or_assign(key, value);
+        _weaponsEmbeddedOffsets = getEmbeddedWeaponsOffsetsBlob(_module);
+        _weaponsCustomOffsets.clear();
+        for (auto& [key, value] : loadOffsetsFromFilesystem(WEAPONS_OFFSETS_PATH)) {
+            _weaponsCustomOffsets.load(key, value);
         }
-        logger::info("Loaded weapon offsets ; Total:{}, Embedded:{}, Custom:{}", _weaponsOffsets.size(), _weaponsEmbeddedOffsets.size(), weaponCustomOffsets.size());
+        rebuildWeaponsResolvedOffsets();
+        logger::info("Loaded weapon offsets ; Embedded:{}, Custom:{}, Resolved:{}", _weaponsEmbeddedOffsets.size(), _weaponsCustomOffsets.offsets().size(),
+            _weaponsResolvedOffsets.size());
+    }
+
+    /**
+     * Build the weapon offsets lookup table from the embedded and custom offsets.
+     */
+    void Config::rebuildWeaponsResolvedOffsets()
+    {
+        _weaponsResolvedOffsets.rebuild(_weaponsEmbeddedOffsets, _weaponsCustomOffsets.embeddedRemoved(), _weaponsCustomOffsets.offsets());
+        _weaponOffsetsVersion++;
     }
 
     /**
@@ -491,34 +620,6 @@ namespace frik
         moveAllFilesInFolderSafe(R"(.\Data\F4SE\plugins\FRIK_weapon_offsets)", WEAPONS_OFFSETS_PATH);
     }
 
-    /**
-     * Get the name for the weapon offset to use depending on the mode.
-     * Basically a hack to store multiple modes of the same weapon by adding suffix to the name.
-     */
-    std::string Config::getWeaponNameWithMode(const std::string& name, const WeaponOffsetsMode& mode, const bool inPA, const bool leftHanded)
-    {
-        static const std::string POWER_ARMOR_SUFFIX{ "-PowerArmor" };
-        static const std::string PRIM_HAND_SUFFIX{ "-primHand" };
-        static const std::string OFF_HAND_SUFFIX{ "-offHand" };
-        static const std::string THROWABLE_SUFFIX{ "-throwable" };
-        static const std::string BACK_OF_HAND_SUFFIX{ "-backOfHand" };
-        static const std::string LEFT_HANDED_SUFFIX{ "-leftHanded" };
-        switch (mode) {
-        case WeaponOffsetsMode::Weapon:
-            return name + (inPA ? POWER_ARMOR_SUFFIX : "") + (leftHanded ? LEFT_HANDED_SUFFIX : "");
-        case WeaponOffsetsMode::PrimaryHand:
-            return name + PRIM_HAND_SUFFIX + (inPA ? POWER_ARMOR_SUFFIX : "") + (leftHanded ? LEFT_HANDED_SUFFIX : "");
-        case WeaponOffsetsMode::OffHand:
-            return name + OFF_HAND_SUFFIX + (inPA ? POWER_ARMOR_SUFFIX : "") + (leftHanded ? LEFT_HANDED_SUFFIX : "");
-        case WeaponOffsetsMode::Throwable:
-            return name + THROWABLE_SUFFIX + (inPA ? POWER_ARMOR_SUFFIX : "") + (leftHanded ? LEFT_HANDED_SUFFIX : "");
-        case WeaponOffsetsMode::BackOfHandUI:
-            return name + BACK_OF_HAND_SUFFIX + (inPA ? POWER_ARMOR_SUFFIX : "") + (leftHanded ? LEFT_HANDED_SUFFIX : "");
-        default:
-            throw std::invalid_argument("Invalid weapon offset mode");
-        }
-    }
-
     std::string Config::getPipboyOffsetKey() const
     {
         if (isFalloutLondonVR) {
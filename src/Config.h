@@ -1,10 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <Version.h>
 
 #include "ConfigBase.h"
+#include "ConfigWriteBehind.h"
 #include "resources.h"
+#include "WeaponOffsetsBlob.h"
+#include "WeaponOffsetsLookup.h"
 #include "common/CommonUtils.h"
 
 namespace frik
@@ -22,25 +28,12 @@ namespace frik
     static const auto PIPBOY_SCREEN_OFFSETS_PATH = BASE_PATH + R"(\Pipboy_Offsets\PipboyPosition_v2.json)";
     static const auto PIPBOY_ATTABOY_OFFSETS_PATH = BASE_PATH + R"(\Pipboy_Offsets\AttaboyPosition_v2.json)";
     static const auto WEAPONS_OFFSETS_PATH = BASE_PATH + R"(\Weapons_Offsets)";
+    static const auto FRAME_CAPTURE_PATH = BASE_PATH + R"(\Captures\frame_capture.bin)";
 
     constexpr float DEFAULT_CAMERA_HEIGHT = 120.4828f;
 
-    /**
-     * Type of weapon related position offsets.
-     */
-    enum class WeaponOffsetsMode : uint8_t
-    {
-        // The weapon offset in the primary hand.
-        Weapon = 0,
-        // The primary hand holding the stock.
-        PrimaryHand,
-        // The secondary hand gripping on the weapon.
-        OffHand,
-        // The throwable weapon offset in the primary hand.
-        Throwable,
-        // Back of hand UI (HP,Ammo,etc.) offset on hand.
-        BackOfHandUI,
-    };
+    // how long to wait after the last config change before writing the changes to the files
+    constexpr int CONFIG_WRITE_BEHIND_DEBOUNCE_MILLIS = 500;
 
     enum class FlashlightLocation : uint8_t
     {
@@ -56,6 +49,19 @@ namespace frik
         HoldInPlace
     };
 
+    /**
+     * Immutable snapshot of the config values that depend on the active profile (standing/sitting and in/out of PA).
+     * Rebuilt when the ini is loaded, a profile value changes, or PA state changes.
+     */
+    struct ActiveProfileConfig
+    {
+        bool inPowerArmor = false;
+        bool isPlayingSeated = false;
+        float playerHMDOffsetUp = 0;
+        float playerBodyOffsetUp = 0;
+        float playerBodyOffsetForward = 0;
+    };
+
     /**
      * Holds all the configuration variables used in the mod.
      * Most of the configuration variables are loaded from the FRIK.ini file.
@@ -69,6 +75,8 @@ namespace frik
 
         virtual void load() override;
         void loadIniOnly();
+        void save();
+        void flushPendingWrites();
 
         void reloadForFalloutLondonVR();
         void setFlashlightLocation(FlashlightLocation location);
@@ -80,6 +88,9 @@ namespace frik
         void saveHideHeadEquipment(bool hide);
         void saveDampenHands(bool iDampenHands);
 
+        std::shared_ptr<const ActiveProfileConfig> getActiveProfile() const { return _activeProfile.load(); }
+        void setActiveProfileInPowerArmor(bool inPowerArmor);
+
         float getPlayerBodyOffsetUp() const;
         void setPlayerBodyOffsetUp(float value);
         float getPlayerBodyOffsetForward() const;
@@ -91,6 +102,7 @@ namespace frik
         RE::NiTransform getPipboyOffset();
         bool savePipboyOffset(const RE::NiTransform& transform);
         std::optional<RE::NiTransform> getWeaponOffsets(const std::string& name, const WeaponOffsetsMode& mode, bool inPA) const;
+        std::uint32_t getWeaponOffsetsVersion() const { return _weaponOffsetsVersion; }
         bool saveWeaponOffsets(const std::string& name, const RE::NiTransform& transform, const WeaponOffsetsMode& mode, bool inPA);
         void removeWeaponOffsets(const std::string& name, const WeaponOffsetsMode& mode, bool inPA, bool replaceWithEmbedded);
 
@@ -105,9 +117,11 @@ namespace frik
         // Head Geometry Hide
         bool hideHead = false;
         bool hideHeadEquipment = false;
+        int hideHeadEquipmentVerifyInterval = 0;
         bool hideSkin = false;
         const std::vector<std::string>& faceGeometry() const { return _faceGeometry; }
         const std::vector<std::string>& skinGeometry() const { return _skinGeometry; }
+        std::uint32_t getHideMeshesVersion() const { return _hideMeshesVersion; }
         const std::vector<int>& hideEquipSlotIndexes() const { return _hideEquipSlotIndexes; }
 
         // is the player playing standing or sitting
@@ -188,6 +202,7 @@ namespace frik
         bool selfieIgnoreHideFlags = false;
         float scopeAdjustDistance = 0;
         float openConfigurationModePressDelay = 0;
+        int boneSphereEventsPerFrame = 0;
 
         // Smooth Movement
         bool disableSmoothMovement = false;
@@ -215,7 +230,30 @@ namespace frik
         void loadWeaponsOffsets();
         static void setupFolders();
         static void migrateConfigFilesIfNeeded();
-        static std::string getWeaponNameWithMode(const std::string& name, const WeaponOffsetsMode& mode, bool inPA, bool leftHanded);
+        void rebuildWeaponsResolvedOffsets();
+        void rebuildActiveProfile();
+        void queueOffsetsJsonFileSave(const std::string& key, const RE::NiTransform& transform, const std::string& path);
+
+        void updateIniFileAtomically(const std::function<void(CSimpleIniA&)>& update) const;
+
+        /**
+         * Queue saving a single ini value on the write-behind worker, latest value of the same key wins.
+         */
+        template <typename T>
+        void queueIniConfigValueSave(const char* section, const char* key, const T value)
+        {
+            _writeBehind.enqueue(std::string(section) + ":" + key, [this, section, key, value] {
+                updateIniFileAtomically([section, key, value](CSimpleIniA& ini) {
+                    if constexpr (std::is_same_v<T, bool>) {
+                        ini.SetBoolValue(section, key, value);
+                    } else if constexpr (std::is_integral_v<T>) {
+                        ini.SetLongValue(section, key, value);
+                    } else {
+                        ini.SetDoubleValue(section, key, value);
+                    }
+                });
+            }, _iniFilePath);
+        }
         std::string getPipboyOffsetKey() const;
         std::string getPipboyOffsetPath() const;
 
@@ -223,11 +261,29 @@ namespace frik
         std::vector<std::string> _faceGeometry;
         std::vector<std::string> _skinGeometry;
         std::vector<int> _hideEquipSlotIndexes;
+        // incremented on every load of the hide meshes lists so compiled matchers know to rebuild
+        std::uint32_t _hideMeshesVersion = 0;
 
         // offsets
         std::unordered_map<std::string, RE::NiTransform> _pipboyOffsets;
-        std::unordered_map<std::string, RE::NiTransform> _weaponsOffsets;
-        std::unordered_map<std::string, RE::NiTransform> _weaponsEmbeddedOffsets;
+        weapon_offsets_blob::View _weaponsEmbeddedOffsets;
+        // custom (filesystem) weapons offsets override the embedded offsets
+        WeaponCustomOffsets _weaponsCustomOffsets;
+
+        // lookup table of the embedded and custom offsets resolved in advance
+        WeaponOffsetsLookup _weaponsResolvedOffsets;
+        // incremented on every change of the weapon offsets so derived caches know to refresh
+        std::uint32_t _weaponOffsetsVersion = 0;
+
+        // the active profile values swapped atomically so readers on other threads never see a partially updated profile
+        bool _activeProfileInPowerArmor = false;
+        std::atomic<std::shared_ptr<const ActiveProfileConfig>> _activeProfile{ std::make_shared<const ActiveProfileConfig>() };
+
+        // set during explicit loads to not confuse them with file watcher reload of self-originated writes
+        std::atomic<bool> _isExplicitLoad = false;
+
+        // last member so the worker is stopped on destruction before anything else is released
+        ConfigWriteBehind _writeBehind{ CONFIG_WRITE_BEHIND_DEBOUNCE_MILLIS };
     };
 
     // Global singleton for easy access
@@ -0,0 +1,156 @@
+#include "ConfigWriteBehind.h"
+
+namespace frik
+{
+    /**
+     * Stop the worker without writing the pending writes (see class doc).
+     */
+    ConfigWriteBehind::~ConfigWriteBehind()
+    {
+        if (_worker.joinable()) {
+            _worker.request_stop();
+            _worker.join();
+        }
+    }
+
+    /**
+     * Queue a write for the given key replacing any pending write of the same key.
+     * @param filePath the file the write changes, stamped after the write for "isSelfWrite"
+     */
+    void ConfigWriteBehind::enqueue(const std::string& key, std::function<void()> write, const std::string& filePath)
+    {
+        {
+            std::scoped_lock lock(_mutex);
+            _pending.insert_or_assign(key, PendingWrite{ std::move(write), filePath });
+            _lastEnqueueTime = std::chrono::steady_clock::now();
+            if (!_worker.joinable()) {
+                _worker = std::jthread([this](const std::stop_token& stopToken) { run(stopToken); });
+            }
+        }
+        _cv.notify_one();
+    }
+
+    /**
+     * Write all pending writes now on the calling thread, waiting for writes in progress on the worker.
+     */
+    void ConfigWriteBehind::flush()
+    {
+        std::scoped_lock writeLock(_writeMutex);
+        writePending();
+    }
+
+    /**
+     * Execute the write now on the calling thread after all the pending writes, so it never interleaves with a worker
+     * write of the same file and older pending writes don't override it.
+     */
+    void ConfigWriteBehind::writeNow(const std::function<void()>& write, const std::string& filePath)
+    {
+        std::scoped_lock writeLock(_writeMutex);
+        writePending();
+        execute("write now", { write, filePath });
+    }
+
+    /**
+     * Check if the file is unchanged since the last write done here, to ignore file watcher notifications of our own
+     * writes. Waits for a write in progress so a notification fired mid-write is checked against the finished write.
+     */
+    bool ConfigWriteBehind::isSelfWrite(const std::string& filePath)
+    {
+        std::scoped_lock writeLock(_writeMutex);
+        const auto it = _selfWriteStamps.find(filePath);
+        return it != _selfWriteStamps.end() && getFileStamp(filePath) == it->second;
+    }
+
+    void ConfigWriteBehind::run(const std::stop_token& stopToken)
+    {
+        std::unique_lock lock(_mutex);
+        while (!stopToken.stop_requested()) {
+            if (!_cv.wait(lock, stopToken, [this] { return !_pending.empty(); })) {
+                break;
+            }
+
+            // debounce: wait until no new write was queued for the debounce time
+            while (!stopToken.stop_requested() && std::chrono::steady_clock::now() < _lastEnqueueTime + _debounce) {
+                _cv.wait_until(lock, stopToken, _lastEnqueueTime + _debounce, [] { return false; });
+            }
+            if (stopToken.stop_requested()) {
+                break;
+            }
+
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    /**
+     * Take all the pending writes and execute them, the write mutex must be held.
+     * Holding the write mutex while taking the pending writes ensures a newer write of a key never executes before
+     * an older one.
+     */
+    void ConfigWriteBehind::writePending()
+    {
+        std::unordered_map<std::string, PendingWrite> pending;
+        {
+            std::scoped_lock lock(_mutex);
+            pending.swap(_pending);
+        }
+        for (const auto& [key, write] : pending) {
+            execute(key, write);
+        }
+    }
+
+    void ConfigWriteBehind::execute(const std::string& key, const PendingWrite& pending)
+    {
+        try {
+            pending.write();
+        } catch (const std::exception& e) {
+            logger::warn("Failed to write config '{}': {}", key, e.what());
+        }
+        if (!pending.filePath.empty()) {
+            if (const auto stamp = getFileStamp(pending.filePath)) {
+                _selfWriteStamps.insert_or_assign(pending.filePath, stamp.value());
+            } else {
+                _selfWriteStamps.erase(pending.filePath);
+            }
+        }
+    }
+
+    std::optional<ConfigWriteBehind::FileStamp> ConfigWriteBehind::getFileStamp(const std::string& filePath)
+    {
+        std::error_code ec;
+        const auto time = std::filesystem::last_write_time(filePath, ec);
+        const auto size = ec ? 0 : std::filesystem::file_size(filePath, ec);
+        return ec ? std::nullopt : std::optional(FileStamp{ time, size });
+    }
+
+    /**
+     * Write a file through a temp file that replaces the original file only if fully written, so a failure or crash
+     * mid-write never leaves a corrupted file. The temp file starts as a copy of the original (for partial updates).
+     * @param writeTemp write the content to the given temp path, return false on failure
+     */
+    bool replaceFileAtomically(const std::string& path, const std::function<bool(const std::string& tempPath)>& writeTemp)
+    {
+        const auto tempPath = path + ".tmp";
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            std::filesystem::copy_file(path, tempPath, std::filesystem::copy_options::overwrite_existing, ec);
+            if (ec) {
+                return false;
+            }
+        }
+        bool written;
+        try {
+            written = writeTemp(tempPath);
+        } catch (...) {
+            std::filesystem::remove(tempPath, ec);
+            throw;
+        }
+        if (!written) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        std::filesystem::rename(tempPath, path, ec);
+        return !ec;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace frik
+{
+    /**
+     * Write-behind persistence of config changes.
+     * Writes are queued by key (file path or ini key) so only the last write of the same key is executed, and run on a
+     * worker thread after no new write was queued for the debounce time, keeping file IO out of the frame update.
+     * Writes are executed one at a time (worker, flush, or writeNow), pending writes must be flushed before reading the
+     * files. The file each write changes is stamped after the write so file watcher notifications of self-originated
+     * writes can be ignored.
+     * Pending writes are NOT written on destruction as it runs in static destruction where the worker may already be
+     * terminated by the process exit, the owner must flush on shutdown (or any other safe point).
+     */
+    class ConfigWriteBehind
+    {
+    public:
+        explicit ConfigWriteBehind(const int debounceMillis) :
+            _debounce(debounceMillis) {}
+
+        ~ConfigWriteBehind();
+
+        void enqueue(const std::string& key, std::function<void()> write, const std::string& filePath = {});
+        void flush();
+        void writeNow(const std::function<void()>& write, const std::string& filePath = {});
+        bool isSelfWrite(const std::string& filePath);
+
+        ConfigWriteBehind(const ConfigWriteBehind&) = delete;
+        ConfigWriteBehind& operator=(const ConfigWriteBehind&) = delete;
+
+    private:
+        struct PendingWrite
+        {
+            std::function<void()> write;
+            // the file changed by the write to stamp, empty if none
+            std::string filePath;
+        };
+
+        struct FileStamp
+        {
+            std::filesystem::file_time_type time;
+            std::uintmax_t size;
+
+            bool operator==(const FileStamp&) const = default;
+        };
+
+        void run(const std::stop_token& stopToken);
+        void writePending();
+        void execute(const std::string& key, const PendingWrite& pending);
+        static std::optional<FileStamp> getFileStamp(const std::string& filePath);
+
+        std::chrono::milliseconds _debounce;
+
+        std::mutex _mutex;
+        std::condition_variable_any _cv;
+        std::unordered_map<std::string, PendingWrite> _pending;
+        std::chrono::steady_clock::time_point _lastEnqueueTime;
+
+        // serialize executing writes between the worker, flush, and writeNow
+        std::mutex _writeMutex;
+        // stamp of the files after the last self write, guarded by the write mutex
+        std::unordered_map<std::string, FileStamp> _selfWriteStamps;
+
+        // started on first write to not create thread during DLL load
+        std::jthread _worker;
+    };
+
+    bool replaceFileAtomically(const std::string& path, const std::function<bool(const std::string& tempPath)>& writeTemp);
+}
@@ -1,6 +1,7 @@
 #include "FRIK.h"
 
 #include "Config.h"
+#include "FrameProfiler.h"
 #include "GameHooks.h"
 #include "PapyrusApi.h"
 #include "utils.h"
@@ -9,6 +10,7 @@
 #include "f4vr/F4VRSkelly.h"
 #include "f4vr/F4VRUtils.h"
 #include "pipboy/Pipboy.h"
+#include "skeleton/FrameCapture.h"
 #include "skeleton/HandPose.h"
 #include "skeleton/Skeleton.h"
 #include "smooth-movement/SmoothMovementVR.h"
@@ -134,6 +136,10 @@ namespace frik
      */
     void FRIK::onFrameUpdate()
     {
+        // sample frame time once for all the frame logic
+        g_frameCapture.onFrameClockTick(_frameClock);
+        _frameClock.tick();
+
         if (!RE::PlayerCharacter::GetSingleton()) {
             // game not loaded or existing
             return;
@@ -157,29 +163,59 @@ namespace frik
             initSkeleton();
         }
 
-        logger::trace("Update Skeleton...");
-        _skelly->onFrameUpdate();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::Frame);
+
+            logger::trace("Update Skeleton...");
+            _skelly->onFrameUpdate();
 
-        logger::trace("Update Bone Sphere...");
-        _boneSpheres.onFrameUpdate();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::BoneSpheres);
+                logger::trace("Update Bone Sphere...");
+                _boneSpheres.onFrameUpdate();
+            }
 
-        logger::trace("Update player controls...");
-        _playerControlsHandler.onFrameUpdate(_mainConfigMode, _pipboy, _weaponPosition, _configurationMode);
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::PlayerControls);
+                logger::trace("Update player controls...");
+                _playerControlsHandler.onFrameUpdate(_mainConfigMode, _pipboy, _weaponPosition, _configurationMode);
+            }
 
-        logger::trace("Update Weapon Position...");
-        _weaponPosition->onFrameUpdate();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::WeaponPosition);
+                logger::trace("Update Weapon Position...");
+                _weaponPosition->onFrameUpdate();
+            }
 
-        logger::trace("Update Pipboy...");
-        _pipboy->onFrameUpdate();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::Pipboy);
+                logger::trace("Update Pipboy...");
+                _pipboy->onFrameUpdate();
+            }
 
-        FrameUpdateContext context(_skelly);
-        vrui::g_uiManager->onFrameUpdate(&context);
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::UIManager);
+                FrameUpdateContext context(_skelly);
+                vrui::g_uiManager->onFrameUpdate(&context);
+            }
 
-        _mainConfigMode.onFrameUpdate();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::ConfigModes);
+                _mainConfigMode.onFrameUpdate();
+                _configurationMode->onFrameUpdate();
+            }
 
-        _configurationMode->onFrameUpdate();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::UpdateWorldFinal);
+                updateWorldFinal();
+            }
 
-        updateWorldFinal();
+            {
+                FRIK_PROFILE_SCOPE(ProfileStage::BoneSpheres);
+                _boneSpheres.flushEvents();
+            }
+        }
+        FRIK_PROFILE_FRAME_END();
     }
 
     void FRIK::smoothMovement()
@@ -194,6 +230,7 @@ namespace frik
     void FRIK::initSkeleton()
     {
         _inPowerArmor = f4vr::isInPowerArmor();
+        g_config.setActiveProfileInPowerArmor(_inPowerArmor);
 
         const auto player = f4vr::getPlayer();
         logger::info("Initialize Skeleton ({}) ; Nodes: Player={}, Data={}, Root={}, Skeleton={}, Common={}",
@@ -206,12 +243,12 @@ namespace frik
 
         // init skeleton
         _workingRootNode = f4vr::getRootNode();
-        _skelly = new Skeleton(f4vr::getRootNode(), _inPowerArmor);
+        _skelly = new Skeleton(f4vr::getRootNode(), _inPowerArmor, _frameClock);
 
         // init handlers depending on skeleton
         _pipboy = new Pipboy(_skelly);
         _configurationMode = new ConfigurationMode(_skelly);
-        _weaponPosition = new WeaponPositionAdjuster(_skelly);
+        _weaponPosition = new WeaponPositionAdjuster(_skelly, _weaponOffsetsBundles);
     }
 
     /**
@@ -272,9 +309,14 @@ namespace frik
     /**
      * On game menu open check is loading menu is open and reset skelly if it does.
      * We want to reinit skeleton after player moves to a new location by fast travel or other.
+     * Flush pending config writes on pause (save/quit) and loading menus.
      */
     void FRIK::onGameMenuOpened(const std::string& name, const bool isOpened)
     {
+        if (isOpened && (_gameMenusHandler.isPauseMenuOpen() || _gameMenusHandler.isLoadingMenuOpen())) {
+            // persist pending config changes before the game is saved or exited, static destruction on exit is not safe
+            g_config.flushPendingWrites();
+        }
         if (isOpened && _skelly && _gameMenusHandler.isLoadingMenuOpen()) {
             logger::info("Loading menu is open, reset skeleton...");
             releaseSkeleton();
@@ -400,5 +442,19 @@ namespace frik
                 f4vr::DebugDump::printNodes(muzzle->projectileNode);
             }
         }
+        if (_skelly && g_config.checkDebugDumpDataOnceFor("hand_bones_tree")) {
+            const auto& kernel = _skelly->getHandBonesTreeKernel();
+            logger::info("Hand bones tree kernel: {} entries in {} levels, {} updates, SIMD: {}", kernel.size(), kernel.levelsCount(), kernel.getUpdatesCount(),
+                BoneTreeTransformsKernel::isSimdAvailable());
+        }
+        if (g_config.checkDebugDumpDataOnceFor("pipboy_nodes")) {
+            logger::info("Pipboy nodes name lookups count: {}", PipboyNodes::getNameLookupsCount());
+        }
+        g_frameCapture.checkDebugCommands(FRAME_CAPTURE_PATH);
+#ifdef FRIK_FRAME_PROFILER
+        if (g_config.checkDebugDumpDataOnceFor("frame_profiler")) {
+            FRIK_PROFILE_DUMP();
+        }
+#endif
     }
 }
@@ -64,6 +64,13 @@ namespace frik
 
         void registerOpenSettingButton(const OpenExternalModConfigData& data) { _mainConfigMode.registerOpenExternalModSettingButton(data); }
 
+        std::uint32_t registerNativeBoneSphere(const float radius, const char* bone, const RE::NiPoint3& offset, BoneSphereNativeCallback callback)
+        {
+            return _boneSpheres.registerNativeBoneSphere(radius, bone, offset, std::move(callback));
+        }
+
+        bool unregisterNativeBoneSphere(const std::uint32_t handle) { return _boneSpheres.unregisterNativeBoneSphere(handle); }
+
         bool isMeleeWeaponDrawn() const { return _weaponPosition && _weaponPosition->isMeleeWeaponDrawn(); }
         bool isOffHandGrippingWeapon() const { return _weaponPosition && _weaponPosition->isOffHandGrippingWeapon(); }
 
@@ -107,11 +114,17 @@ namespace frik
         ConfigurationMode* _configurationMode = nullptr;
         WeaponPositionAdjuster* _weaponPosition = nullptr;
 
+        // resolved weapon offsets kept across skeleton re-creation (PA change)
+        WeaponOffsetsBundleCache _weaponOffsetsBundles;
+
         // handler for the interaction spheres around the skeleton
         BoneSpheresHandler _boneSpheres;
 
+        // single frame time source shared by skeleton and smooth movement
+        FrameClock _frameClock;
+
         // handler for smooth movement logic
-        SmoothMovementVR _smoothMovement;
+        SmoothMovementVR _smoothMovement{ _frameClock };
 
         // handler for game menus checking
         f4vr::GameMenusHandler _gameMenusHandler;
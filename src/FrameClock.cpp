@@ -0,0 +1,32 @@
+#include "FrameClock.h"
+
+namespace frik
+{
+    /**
+     * Sample the clock for a new frame, must be called exactly once per frame before any consumer reads the frame time.
+     */
+    void FrameClock::tick()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (isFixedStep()) {
+            _frameTime = _fixedStep;
+        } else if (_frameIndex > 0) {
+            _frameTime = std::chrono::duration<float>(now - _lastTick).count();
+        }
+        _lastTick = now;
+        _frameIndex++;
+    }
+
+    /**
+     * The time in seconds since the consumer previous call, "lastLap" is the consumer owned time of the previous call.
+     * Returns the fixed step in fixed-step mode and the default frame time on the consumer first call.
+     */
+    float FrameClock::lap(std::chrono::steady_clock::time_point& lastLap) const
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const bool first = lastLap == std::chrono::steady_clock::time_point{};
+        const float elapsed = first ? DEFAULT_FRAME_TIME : std::chrono::duration<float>(now - lastLap).count();
+        lastLap = now;
+        return isFixedStep() ? _fixedStep : elapsed;
+    }
+}
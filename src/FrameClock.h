@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+
+namespace frik
+{
+    /**
+     * Single source of frame time for all time-dependent frame logic (skeleton, walking, hand pose blending, smooth movement).
+     * Sampled once per frame by calling "tick", all frame update consumers read the same frame time for the frame.
+     * Consumers that run from their own game hook (not 1:1 with frame update) measure their own delta using "lap".
+     * Fixed-step mode returns a constant frame time regardless of the real clock for deterministic replay and benchmarking.
+     */
+    class FrameClock
+    {
+    public:
+        // used for the first frame as there is no previous frame to measure against (90 FPS)
+        static constexpr float DEFAULT_FRAME_TIME = 1.0f / 90.0f;
+
+        void tick();
+
+        /**
+         * The time in seconds between the last two ticks.
+         */
+        float getFrameTime() const { return _frameTime; }
+
+        /**
+         * The number of ticks since the clock creation.
+         */
+        uint64_t getFrameIndex() const { return _frameIndex; }
+
+        float lap(std::chrono::steady_clock::time_point& lastLap) const;
+
+        bool isFixedStep() const { return _fixedStep > 0; }
+
+        /**
+         * Set fixed frame time in seconds to use instead of the real clock, 0 to return to the real clock.
+         */
+        void setFixedStep(const float fixedStep) { _fixedStep = fixedStep; }
+
+    private:
+        std::chrono::steady_clock::time_point _lastTick;
+        float _frameTime = DEFAULT_FRAME_TIME;
+        float _fixedStep = 0;
+        uint64_t _frameIndex = 0;
+    };
+}
@@ -0,0 +1,84 @@
+#include "FrameProfiler.h"
+
+#ifdef FRIK_FRAME_PROFILER
+
+#include <algorithm>
+#include <vector>
+
+namespace frik
+{
+    FrameProfiler g_frameProfiler;
+
+    namespace
+    {
+        constexpr std::array<const char*, PROFILE_STAGES_COUNT> PROFILE_STAGE_NAMES = {
+            "Frame",
+            "Skeleton.Restore",
+            "Skeleton.Body",
+            "Skeleton.Legs",
+            "Skeleton.Arms",
+            "Skeleton.Misc",
+            "Skeleton.CullGeometry",
+            "Skeleton.Selfie",
+            "Skeleton.Hands",
+            "BoneSpheres",
+            "PlayerControls",
+            "WeaponPosition",
+            "WeaponPosition.Scope",
+            "Pipboy",
+            "UIManager",
+            "ConfigModes",
+            "UpdateWorldFinal",
+        };
+
+        double toMicros(const std::chrono::steady_clock::rep ticks)
+        {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::duration(ticks)).count();
+        }
+
+        /**
+         * Get the value at the given percentile (0-1) of the sorted values.
+         */
+        std::chrono::steady_clock::rep percentile(const std::vector<std::chrono::steady_clock::rep>& sorted, const double pct)
+        {
+            const auto idx = static_cast<std::size_t>(pct * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(idx, sorted.size() - 1)];
+        }
+    }
+
+    /**
+     * Commit the spans of the frame in progress to the ring buffer and start a new frame.
+     */
+    void FrameProfiler::endFrame()
+    {
+        const auto written = _framesWritten.load(std::memory_order_relaxed);
+        _frames[written % FRAMES_COUNT] = _current;
+        _framesWritten.store(written + 1, std::memory_order_release);
+        _current.fill(0);
+    }
+
+    /**
+     * Log p50/p95/p99 and max of each stage over the frames in the ring buffer.
+     */
+    void FrameProfiler::dumpPercentiles() const
+    {
+        const auto framesCount = std::min(_framesWritten.load(std::memory_order_acquire), FRAMES_COUNT);
+        if (framesCount == 0) {
+            logger::info("Frame profiler: no frames recorded");
+            return;
+        }
+
+        logger::info("Frame profiler over last {} frames (micro-seconds):", framesCount);
+        std::vector<std::chrono::steady_clock::rep> spans(framesCount);
+        for (std::size_t stage = 0; stage < PROFILE_STAGES_COUNT; stage++) {
+            for (std::size_t i = 0; i < framesCount; i++) {
+                spans[i] = _frames[i][stage];
+            }
+            std::ranges::sort(spans);
+            logger::info("  {:<22} p50: {:>8.1f}  p95: {:>8.1f}  p99: {:>8.1f}  max: {:>8.1f}", PROFILE_STAGE_NAMES[stage], toMicros(percentile(spans, 0.5)),
+                toMicros(percentile(spans, 0.95)), toMicros(percentile(spans, 0.99)), toMicros(spans.back()));
+        }
+    }
+}
+
+#endif
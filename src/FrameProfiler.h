@@ -0,0 +1,103 @@
+#pragma once
+
+/**
+ * Low-overhead per-stage profiler for the mod frame update.
+ * Enabled only when built with FRIK_FRAME_PROFILER defined (cmake -DFRIK_FRAME_PROFILER=ON), otherwise all the macros
+ * compile out to nothing.
+ * Usage: FRIK_PROFILE_SCOPE(ProfileStage::X) at the start of a scope, FRIK_PROFILE_FRAME_END() once per frame.
+ * Percentiles of the last frames are dumped to the log using "frame_profiler" in "sDebugDumpDataOnceNames" INI flag.
+ */
+
+#ifdef FRIK_FRAME_PROFILER
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace frik
+{
+    enum class ProfileStage : uint8_t
+    {
+        Frame = 0,
+        SkeletonRestore,
+        SkeletonBody,
+        SkeletonLegs,
+        SkeletonArms,
+        SkeletonMisc,
+        SkeletonCullGeometry,
+        SkeletonSelfie,
+        SkeletonHands,
+        BoneSpheres,
+        PlayerControls,
+        WeaponPosition,
+        WeaponScope,
+        Pipboy,
+        UIManager,
+        ConfigModes,
+        UpdateWorldFinal,
+
+        Count
+    };
+
+    constexpr auto PROFILE_STAGES_COUNT = static_cast<std::size_t>(ProfileStage::Count);
+
+    class FrameProfiler
+    {
+    public:
+        // number of frames kept for percentile calculation (~10 seconds at 90 FPS)
+        static constexpr std::size_t FRAMES_COUNT = 1024;
+
+        void addSpan(const ProfileStage stage, const std::chrono::steady_clock::duration span)
+        {
+            _current[static_cast<std::size_t>(stage)] += span.count();
+        }
+
+        void endFrame();
+        void dumpPercentiles() const;
+
+    private:
+        using FrameSpans = std::array<std::chrono::steady_clock::rep, PROFILE_STAGES_COUNT>;
+
+        // spans accumulated for the frame in progress (a stage may be entered more than once a frame)
+        FrameSpans _current{};
+
+        // ring buffer of completed frames, the frame thread is the only writer so publishing the index is enough
+        std::array<FrameSpans, FRAMES_COUNT> _frames{};
+        std::atomic<std::size_t> _framesWritten = 0;
+    };
+
+    extern FrameProfiler g_frameProfiler;
+
+    /**
+     * RAII span measuring the time from construction to end of scope into the given stage.
+     */
+    class ScopedProfileSpan
+    {
+    public:
+        explicit ScopedProfileSpan(const ProfileStage stage)
+            : _stage(stage), _start(std::chrono::steady_clock::now()) {}
+
+        ~ScopedProfileSpan() { g_frameProfiler.addSpan(_stage, std::chrono::steady_clock::now() - _start); }
+
+        ScopedProfileSpan(const ScopedProfileSpan&) = delete;
+        ScopedProfileSpan& operator=(const ScopedProfileSpan&) = delete;
+
+    private:
+        ProfileStage _stage;
+        std::chrono::steady_clock::time_point _start;
+    };
+}
+
+#define FRIK_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FRIK_PROFILE_CONCAT(a, b)      FRIK_PROFILE_CONCAT_IMPL(a, b)
+#define FRIK_PROFILE_SCOPE(stage)      const frik::ScopedProfileSpan FRIK_PROFILE_CONCAT(_profileSpan, __LINE__)(frik::stage)
+#define FRIK_PROFILE_FRAME_END()       frik::g_frameProfiler.endFrame()
+#define FRIK_PROFILE_DUMP()            frik::g_frameProfiler.dumpPercentiles()
+
+#else
+
+#define FRIK_PROFILE_SCOPE(stage)
+#define FRIK_PROFILE_FRAME_END()
+#define FRIK_PROFILE_DUMP()
+
+#endif
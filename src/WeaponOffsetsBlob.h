@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Binary table of the embedded weapon offsets, generated at build time from the JSON files in
+ * "data/config/weapons_offsets" by "tools/WeaponOffsetsBlobGenerator.cpp" and embedded as a single resource.
+ * Layout: header, entries sorted by name (byte-wise), names pool. All offsets are from the blob start.
+ * Used directly from the resource memory, lookup is a binary search on the names with no parsing or allocation.
+ * NOTE: no game dependencies as it is also compiled into the generator tool.
+ */
+namespace frik::weapon_offsets_blob
+{
+    constexpr std::uint32_t MAGIC = 0x424F5746; // "FWOB"
+    constexpr std::uint32_t VERSION = 1;
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t entriesCount;
+        std::uint32_t entriesOffset;
+        std::uint32_t namesOffset;
+        std::uint32_t namesSize;
+    };
+
+    struct Entry
+    {
+        std::uint32_t nameOffset;
+        std::uint32_t nameLength;
+        // 3x4 row-major rotation matrix as stored in the JSON "rotation" (4th column is padding)
+        float rotation[12];
+        float translate[3];
+        float scale;
+    };
+
+    static_assert(sizeof(Header) == 24);
+    static_assert(sizeof(Entry) == 72);
+
+    /**
+     * Read-only view over the blob memory, the memory must outlive the view.
+     */
+    class View
+    {
+    public:
+        View() = default;
+
+        /**
+         * Validate the blob header and bounds, view is empty if the blob is invalid.
+         */
+        View(const void* data, const std::size_t size)
+        {
+            const auto bytes = static_cast<const std::uint8_t*>(data);
+            if (!bytes || size < sizeof(Header)) {
+                return;
+            }
+            const auto header = reinterpret_cast<const Header*>(bytes);
+            if (header->magic != MAGIC || header->version != VERSION
+                || header->entriesOffset + static_cast<std::size_t>(header->entriesCount) * sizeof(Entry) > size
+                || header->namesOffset + static_cast<std::size_t>(header->namesSize) > size) {
+                return;
+            }
+            _entries = reinterpret_cast<const Entry*>(bytes + header->entriesOffset);
+            _count = header->entriesCount;
+            _names = reinterpret_cast<const char*>(bytes + header->namesOffset);
+        }
+
+        bool isValid() const { return _entries != nullptr; }
+        std::size_t size() const { return _count; }
+        const Entry& operator[](const std::size_t index) const { return _entries[index]; }
+        std::string_view nameOf(const Entry& entry) const { return { _names + entry.nameOffset, entry.nameLength }; }
+
+        const Entry* find(const std::string_view name) const
+        {
+            const auto end = _entries + _count;
+            const auto it = std::lower_bound(_entries, end, name, [this](const Entry& entry, const std::string_view value) {
+                return nameOf(entry) < value;
+            });
+            return it != end && nameOf(*it) == name ? it : nullptr;
+        }
+
+    private:
+        const Entry* _entries = nullptr;
+        std::size_t _count = 0;
+        const char* _names = nullptr;
+    };
+}
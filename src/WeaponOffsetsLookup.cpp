@@ -0,0 +1,147 @@
+#include "WeaponOffsetsLookup.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view POWER_ARMOR_SUFFIX{ "-PowerArmor" };
+    constexpr std::string_view LEFT_HANDED_SUFFIX{ "-leftHanded" };
+
+    constexpr std::pair<std::string_view, frik::WeaponOffsetsMode> WEAPON_MODE_SUFFIXES[] = {
+        { "-primHand", frik::WeaponOffsetsMode::PrimaryHand },
+        { "-offHand", frik::WeaponOffsetsMode::OffHand },
+        { "-throwable", frik::WeaponOffsetsMode::Throwable },
+        { "-backOfHand", frik::WeaponOffsetsMode::BackOfHandUI },
+    };
+
+    std::string_view getWeaponModeSuffix(const frik::WeaponOffsetsMode mode)
+    {
+        if (mode == frik::WeaponOffsetsMode::Weapon) {
+            return "";
+        }
+        for (const auto& [suffix, suffixMode] : WEAPON_MODE_SUFFIXES) {
+            if (suffixMode == mode) {
+                return suffix;
+            }
+        }
+        throw std::invalid_argument("Invalid weapon offset mode");
+    }
+
+    constexpr std::uint64_t WEAPON_OFFSETS_KEY_PA_BIT = 1 << 1;
+
+    constexpr std::uint64_t makeWeaponOffsetsKey(const std::uint32_t nameId, const frik::WeaponOffsetsMode mode, const bool inPA, const bool leftHanded)
+    {
+        return static_cast<std::uint64_t>(nameId) << 8 | static_cast<std::uint64_t>(mode) << 2 | (inPA ? WEAPON_OFFSETS_KEY_PA_BIT : 0) | (leftHanded ? 1 : 0);
+    }
+
+    RE::NiTransform toTransform(const frik::weapon_offsets_blob::Entry& entry)
+    {
+        RE::NiTransform transform;
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                transform.rotate.entry[r][c] = entry.rotation[r * 4 + c];
+            }
+        }
+        transform.translate = RE::NiPoint3(entry.translate[0], entry.translate[1], entry.translate[2]);
+        transform.scale = entry.scale;
+        return transform;
+    }
+}
+
+namespace frik
+{
+    /**
+     * Get the name for the weapon offset to use depending on the mode.
+     * Basically a hack to store multiple modes of the same weapon by adding suffix to the name.
+     */
+    std::string getWeaponNameWithMode(const std::string_view name, const WeaponOffsetsMode mode, const bool inPA, const bool leftHanded)
+    {
+        std::string fullName{ name };
+        fullName += getWeaponModeSuffix(mode);
+        if (inPA) {
+            fullName += POWER_ARMOR_SUFFIX;
+        }
+        if (leftHanded) {
+            fullName += LEFT_HANDED_SUFFIX;
+        }
+        return fullName;
+    }
+
+    /**
+     * Reverse of "getWeaponNameWithMode", split the full offsets name into the weapon name and the mode suffixes.
+     */
+    WeaponNameWithMode parseWeaponNameWithMode(const std::string_view fullName)
+    {
+        WeaponNameWithMode parsed{ fullName, WeaponOffsetsMode::Weapon, false, false };
+        const auto removeSuffix = [&parsed](const std::string_view suffix) {
+            if (!parsed.name.ends_with(suffix)) {
+                return false;
+            }
+            parsed.name.remove_suffix(suffix.size());
+            return true;
+        };
+        parsed.leftHanded = removeSuffix(LEFT_HANDED_SUFFIX);
+        parsed.inPA = removeSuffix(POWER_ARMOR_SUFFIX);
+        for (const auto& [suffix, mode] : WEAPON_MODE_SUFFIXES) {
+            if (removeSuffix(suffix)) {
+                parsed.mode = mode;
+                break;
+            }
+        }
+        return parsed;
+    }
+
+    /**
+     * Build the lookup table: embedded offsets (except removed), overridden by custom offsets, and PA keys that have
+     * no offsets of their own pointing to the non-PA offsets (historic fallback).
+     */
+    void WeaponOffsetsLookup::rebuild(const weapon_offsets_blob::View& embedded, const std::unordered_set<std::string>& embeddedRemoved,
+        const std::unordered_map<std::string, RE::NiTransform>& custom)
+    {
+        _nameIds.clear();
+        _resolvedOffsets.clear();
+
+        for (std::size_t i = 0; i < embedded.size(); i++) {
+            const auto& entry = embedded[i];
+            const auto fullName = embedded.nameOf(entry);
+            if (!embeddedRemoved.contains(std::string(fullName))) {
+                add(fullName, toTransform(entry));
+            }
+        }
+        for (const auto& [fullName, transform] : custom) {
+            add(fullName, transform);
+        }
+
+        std::vector<std::pair<std::uint64_t, RE::NiTransform>> paFallbacks;
+        for (const auto& [key, transform] : _resolvedOffsets) {
+            if (!(key & WEAPON_OFFSETS_KEY_PA_BIT) && !_resolvedOffsets.contains(key | WEAPON_OFFSETS_KEY_PA_BIT)) {
+                paFallbacks.emplace_back(key | WEAPON_OFFSETS_KEY_PA_BIT, transform);
+            }
+        }
+        _resolvedOffsets.insert(paFallbacks.begin(), paFallbacks.end());
+    }
+
+    /**
+     * Get the offsets of the weapon name and mode, PA mode falls back to non-PA offsets (resolved in advance).
+     */
+    std::optional<RE::NiTransform> WeaponOffsetsLookup::find(const std::string_view name, const WeaponOffsetsMode mode, const bool inPA, const bool leftHanded) const
+    {
+        const auto nameIt = _nameIds.find(name);
+        if (nameIt == _nameIds.end()) {
+            return std::nullopt;
+        }
+        const auto it = _resolvedOffsets.find(makeWeaponOffsetsKey(nameIt->second, mode, inPA, leftHanded));
+        return it != _resolvedOffsets.end() ? std::optional(it->second) : std::nullopt;
+    }
+
+    void WeaponOffsetsLookup::add(const std::string_view fullName, const RE::NiTransform& transform)
+    {
+        const auto parsed = parseWeaponNameWithMode(fullName);
+        auto nameIt = _nameIds.find(parsed.name);
+        if (nameIt == _nameIds.end()) {
+            nameIt = _nameIds.emplace(std::string(parsed.name), static_cast<std::uint32_t>(_nameIds.size())).first;
+        }
+        _resolvedOffsets.insert_or_assign(makeWeaponOffsetsKey(nameIt->second, parsed.mode, parsed.inPA, parsed.leftHanded), transform);
+    }
+}
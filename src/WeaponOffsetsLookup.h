@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "WeaponOffsetsBlob.h"
+
+namespace frik
+{
+    /**
+     * Type of weapon related position offsets.
+     */
+    enum class WeaponOffsetsMode : uint8_t
+    {
+        // The weapon offset in the primary hand.
+        Weapon = 0,
+        // The primary hand holding the stock.
+        PrimaryHand,
+        // The secondary hand gripping on the weapon.
+        OffHand,
+        // The throwable weapon offset in the primary hand.
+        Throwable,
+        // Back of hand UI (HP,Ammo,etc.) offset on hand.
+        BackOfHandUI,
+    };
+
+    struct WeaponNameWithMode
+    {
+        std::string_view name;
+        WeaponOffsetsMode mode;
+        bool inPA;
+        bool leftHanded;
+    };
+
+    std::string getWeaponNameWithMode(std::string_view name, WeaponOffsetsMode mode, bool inPA, bool leftHanded);
+    WeaponNameWithMode parseWeaponNameWithMode(std::string_view fullName);
+
+    /**
+     * Lookup table of the embedded and custom weapon offsets resolved by (weapon name id, mode, PA, left-handed) packed
+     * key, including the PA to non-PA fallback, so a lookup is a single probe without building the name with mode string.
+     * NOTE: no game dependencies other than the transform type so it can be tested and benchmarked off-target.
+     */
+    class WeaponOffsetsLookup
+    {
+    public:
+        void rebuild(const weapon_offsets_blob::View& embedded, const std::unordered_set<std::string>& embeddedRemoved,
+            const std::unordered_map<std::string, RE::NiTransform>& custom);
+
+        std::optional<RE::NiTransform> find(std::string_view name, WeaponOffsetsMode mode, bool inPA, bool leftHanded) const;
+
+        std::size_t size() const { return _resolvedOffsets.size(); }
+
+    private:
+        void add(std::string_view fullName, const RE::NiTransform& transform);
+
+        struct TransparentStringHash
+        {
+            using is_transparent = void;
+            std::size_t operator()(const std::string_view str) const { return std::hash<std::string_view>{}(str); }
+        };
+
+        std::unordered_map<std::string, std::uint32_t, TransparentStringHash, std::equal_to<>> _nameIds;
+        std::unordered_map<std::uint64_t, RE::NiTransform> _resolvedOffsets;
+    };
+
+    /**
+     * The custom (filesystem) weapon offsets that override the embedded offsets, and the embedded offsets removed without
+     * replacing (until next load), as changed by config mode saves and removals.
+     */
+    class WeaponCustomOffsets
+    {
+    public:
+        void clear()
+        {
+            _offsets.clear();
+            _embeddedRemoved.clear();
+        }
+
+        void load(const std::string& fullName, const RE::NiTransform& transform) { _offsets.insert_or_assign(fullName, transform); }
+
+        void save(const std::string& fullName, const RE::NiTransform& transform)
+        {
+            _offsets[fullName] = transform;
+            _embeddedRemoved.erase(fullName);
+        }
+
+        /**
+         * Remove the custom offset, either falling back to the embedded offset or removing the embedded offset as well.
+         */
+        void remove(const std::string& fullName, const bool replaceWithEmbedded)
+        {
+            _offsets.erase(fullName);
+            if (replaceWithEmbedded) {
+                _embeddedRemoved.erase(fullName);
+            } else {
+                _embeddedRemoved.insert(fullName);
+            }
+        }
+
+        const std::unordered_map<std::string, RE::NiTransform>& offsets() const { return _offsets; }
+        const std::unordered_set<std::string>& embeddedRemoved() const { return _embeddedRemoved; }
+
+    private:
+        std::unordered_map<std::string, RE::NiTransform> _offsets;
+        std::unordered_set<std::string> _embeddedRemoved;
+    };
+}
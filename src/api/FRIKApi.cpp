@@ -140,6 +140,22 @@ namespace
         return true;
     }
 
+    std::uint32_t FRIK_CALL registerBoneSphere(const float radius, const char* boneName, const RE::NiPoint3& offset, const FRIKApi::BoneSphereCallback callback,
+        void* userData)
+    {
+        if (!callback) {
+            return 0;
+        }
+        return g_frik.registerNativeBoneSphere(radius, boneName, offset, [callback, userData](const std::uint32_t handle, const BoneSphereEvent event, const std::uint32_t device) {
+            callback(handle, static_cast<FRIKApi::BoneSphereEvent>(event), device == 2 ? FRIKApi::Hand::Left : FRIKApi::Hand::Right, userData);
+        });
+    }
+
+    bool FRIK_CALL unregisterBoneSphere(const std::uint32_t handle)
+    {
+        return g_frik.unregisterNativeBoneSphere(handle);
+    }
+
     constexpr FRIKApi FRIK_API_FUNCTIONS_TABLE{
         .getVersion = &getVersion,
         .getModVersion = &getModVersion,
@@ -157,7 +173,9 @@ namespace
         .clearHandPose = &clearHandPose,
         .setHandPoseFingerPositions = &setHandPoseFingerPositions,
         .clearHandPoseFingerPositions = &clearHandPoseFingerPositions,
-        .registerOpenModSettingButtonToMainConfig = &registerOpenModSettingButtonToMainConfig
+        .registerOpenModSettingButtonToMainConfig = &registerOpenModSettingButtonToMainConfig,
+        .registerBoneSphere = &registerBoneSphere,
+        .unregisterBoneSphere = &unregisterBoneSphere
     };
 }
 
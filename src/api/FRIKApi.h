@@ -29,6 +29,10 @@
 //
 //     // Later:
 //     frik::api::FRIKApi::inst->clearHandPose("MyMod_Interaction", frik::api::FRIKApi::Hand::Primary);
+//
+//     // Get a callback when a hand enters/exits a sphere around a bone
+//     const auto handle = frik::api::FRIKApi::inst->registerBoneSphere(5, "Head", RE::NiPoint3(0, 0, 0), onBoneSphereEvent, nullptr);
+//     frik::api::FRIKApi::inst->unregisterBoneSphere(handle);
 // }
 
 namespace frik::api
@@ -42,7 +46,8 @@ namespace frik::api
 #define FRIK_CALL __cdecl
 
     // API version for compatibility checking
-    inline constexpr std::uint32_t FRIK_API_VERSION = 2;
+    // New functions are only appended to the end of FRIKApi struct so older versions clients keep working.
+    inline constexpr std::uint32_t FRIK_API_VERSION = 3;
 
     struct FRIKApi
     {
@@ -103,6 +108,21 @@ namespace frik::api
             std::uint32_t callbackMessageType;
         };
 
+        /**
+         * Bone sphere event type passed to native bone sphere callback.
+         */
+        enum class BoneSphereEvent : std::uint8_t
+        {
+            Enter = 1,
+            Exit = 2,
+        };
+
+        /**
+         * Native bone sphere callback, called on the game main thread in the same frame the hand entered/exited the sphere.
+         * The hand is Right or Left. It is safe to register/unregister bone spheres inside the callback.
+         */
+        using BoneSphereCallback = void (FRIK_CALL*)(std::uint32_t handle, BoneSphereEvent event, Hand hand, void* userData);
+
         /**
          * Get the API version number.
          * Use this to check compatibility before calling other functions.
@@ -198,6 +218,21 @@ namespace frik::api
          */
         bool (FRIK_CALL*registerOpenModSettingButtonToMainConfig)(const OpenExternalModConfigData& data);
 
+        /**
+         * Register a sphere around the given bone (with offset in bone space) to get callback when the player index
+         * finger enters/exits it. Same as Papyrus RegisterBoneSphereOffset without Papyrus VM events.
+         * Added in version 3.
+         * @return sphere handle to unregister with, 0 if failed.
+         */
+        std::uint32_t (FRIK_CALL*registerBoneSphere)(float radius, const char* boneName, const RE::NiPoint3& offset, BoneSphereCallback callback, void* userData);
+
+        /**
+         * Unregister a sphere registered with "registerBoneSphere", no more callbacks are called for it.
+         * Added in version 3.
+         * @return true if the sphere was registered.
+         */
+        bool (FRIK_CALL*unregisterBoneSphere)(std::uint32_t handle);
+
         /**
          * Initialize the FRIK API object.
          * NOTE: call after all mods have been loaded in the game (GameLoaded event).
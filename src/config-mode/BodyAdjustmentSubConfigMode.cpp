@@ -230,7 +230,9 @@ namespace frik
     {
         Config defaultConfig;
         defaultConfig.loadEmbeddedDefaultOnly();
+        // the profile snapshot was built on load, rebuild it for the seated and PA state of the edited profile
         defaultConfig.isPlayingSeated = g_config.isPlayingSeated;
+        defaultConfig.setActiveProfileInPowerArmor(g_config.getActiveProfile()->inPowerArmor);
 
         switch (_configTarget) {
         case BodyAdjustmentConfigTarget::BodyHeight:
@@ -9,8 +9,8 @@ using namespace common;
 
 namespace frik
 {
-    Flashlight::Flashlight(Skeleton* skelly) :
-        _skelly(skelly) {}
+    Flashlight::Flashlight(Skeleton* skelly, const PipboyNodes& nodes) :
+        _skelly(skelly), _nodes(nodes) {}
 
     /**
      * Executed every frame to update to handle flashlight location and moving between hand and head.
@@ -85,9 +85,10 @@ namespace frik
             f4vr::updateTransforms(lightNode);
 
             // use the right arm node
-            const auto armNode = g_config.flashlightLocation == FlashlightLocation::LeftArm
-                ? f4vr::findNode(_skelly->getLeftArm().shoulder, "LArm_Hand")
-                : f4vr::findNode(_skelly->getRightArm().shoulder, "RArm_Hand");
+            const auto armNode = _nodes.getNode(g_config.flashlightLocation == FlashlightLocation::LeftArm ? PipboyNode::LeftHand : PipboyNode::RightHand);
+            if (!armNode) {
+                return;
+            }
 
             // calculate relocation transform and set to local
             lightNode->local = MatrixUtils::calculateRelocation(lightNode, armNode);
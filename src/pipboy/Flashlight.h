@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PipboyNodes.h"
 #include "PipboyPhysicalHandler.h"
 
 namespace frik
@@ -9,7 +10,7 @@ namespace frik
     class Flashlight
     {
     public:
-        explicit Flashlight(Skeleton* skelly);
+        Flashlight(Skeleton* skelly, const PipboyNodes& nodes);
 
         void onFrameUpdate();
 
@@ -18,6 +19,7 @@ namespace frik
         void adjustFlashlightTransformToHandOrHead() const;
 
         Skeleton* _skelly;
+        const PipboyNodes& _nodes;
 
         // to stop continuous flashlight haptic feedback
         bool _flashlightHapticActivated = false;
@@ -3,6 +3,7 @@
 #include "Config.h"
 #include "FRIK.h"
 #include "utils.h"
+#include "f4vr/F4VRUtils.h"
 #include "vrcf/VRControllersManager.h"
 #include "skeleton/HandPose.h"
 
@@ -33,6 +34,13 @@ namespace
         }
         return frik::g_config.isHoloPipboy ? "FRIK/HoloPipboyVR.nif" : "FRIK/PipboyVR.nif";
     }
+
+    const frik::PipboyNodesScene GAME_PIPBOY_NODES_SCENE = {
+        .findNode = [](RE::NiAVObject* root, const char* name, const bool asNiNode) -> RE::NiAVObject* {
+            return asNiNode ? f4vr::findNode(root, name) : f4vr::findAVObject(root, name);
+        },
+        .getFirstChild = [](RE::NiNode* node) -> RE::NiAVObject* { return f4vr::getFirstChild(node); }
+    };
 }
 
 namespace frik
@@ -42,7 +50,7 @@ namespace frik
      *
      */
     Pipboy::Pipboy(Skeleton* skelly) :
-        _skelly(skelly), _flashlight(skelly), _physicalHandler(skelly, this)
+        _skelly(skelly), _nodes(GAME_PIPBOY_NODES_SCENE), _flashlight(skelly, _nodes), _physicalHandler(skelly, this, _nodes)
     {
         // force hide if was open before like when fast traveling (force show if not wrist to allow changing mid-game)
         f4vr::getPlayerNodes()->PipboyRoot_nif_only_node->local.scale = f4vr::isPipboyOnWrist() ? 0.0f : 1.0f;
@@ -146,6 +154,9 @@ namespace frik
     {
         exitPowerArmorBugFixHack(false);
 
+        const auto pipboyArm = g_config.leftHandedPipBoy ? _skelly->getRightArm() : _skelly->getLeftArm();
+        _nodes.update({ .arm = pipboyArm.forearm3, .leftShoulder = _skelly->getLeftArm().shoulder, .rightShoulder = _skelly->getRightArm().shoulder });
+
         _flashlight.onFrameUpdate();
 
         hideShowPipboyOnArm();
@@ -643,8 +654,10 @@ namespace frik
         if (f4vr::isInPowerArmor()) {
             return nullptr;
         }
+        if (const auto boneNode = _nodes.getNode(PipboyNode::PipboyBone)) {
+            return boneNode;
+        }
         const auto arm = g_config.leftHandedPipBoy ? _skelly->getRightArm() : _skelly->getLeftArm();
-        const auto boneNode = arm.forearm3 ? f4vr::findAVObject(arm.forearm3, "PipboyBone") : nullptr;
-        return boneNode ? boneNode->IsNode() : arm.forearm3->IsNode();
+        return arm.forearm3->IsNode();
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Flashlight.h"
+#include "PipboyNodes.h"
 #include "PipboyPhysicalHandler.h"
 
 namespace frik
@@ -54,6 +55,9 @@ namespace frik
 
         Skeleton* _skelly;
 
+        // must be initialized before the handlers using it
+        PipboyNodes _nodes;
+
         Flashlight _flashlight;
 
         PipboyPhysicalHandler _physicalHandler;
@@ -0,0 +1,102 @@
+#include "PipboyNodes.h"
+
+#include <algorithm>
+
+#include "AttachedNodeCache.h"
+
+namespace
+{
+    /**
+     * Nodes that were always searched as NiNode (buttons detection and flashlight hands).
+     */
+    constexpr bool isSearchedAsNiNode(const frik::PipboyNode node)
+    {
+        return node == frik::PipboyNode::PowerDetect || node == frik::PipboyNode::LightDetect || node == frik::PipboyNode::RadioDetect
+            || node == frik::PipboyNode::LeftHand || node == frik::PipboyNode::RightHand;
+    }
+}
+
+namespace frik
+{
+    /**
+     * Check if the Pipboy nodes need to be resolved again, run every frame before any Pipboy node is used.
+     */
+    void PipboyNodes::update(const PipboyNodesRoots& roots)
+    {
+        if (_fingerprint == getFingerprint(roots.arm) && (get(PipboyNode::PowerDetect) || --_framesToRetry > 0)) {
+            if (--_framesToVerify > 0) {
+                return;
+            }
+            _framesToVerify = VERIFY_ATTACHED_FRAMES;
+            if (isResolvedAttached(roots)) {
+                return;
+            }
+            logger::info("Pipboy nodes are no longer attached to the arm, resolving again");
+        }
+
+        resolve(roots);
+        _fingerprint = getFingerprint(roots.arm);
+        _framesToRetry = RESOLVE_RETRY_FRAMES;
+        _framesToVerify = VERIFY_ATTACHED_FRAMES;
+    }
+
+    /**
+     * Identify the resolved nodes by the Pipboy arm, where the Pipboy bone is attached, and the Pipboy model on it.
+     * Uses the previously resolved Pipboy bone as it is a skeleton bone that lives as long as the skeleton.
+     */
+    PipboyNodes::Fingerprint PipboyNodes::getFingerprint(RE::NiAVObject* arm) const
+    {
+        Fingerprint fingerprint{ .arm = arm };
+        if (const auto pipboyBone = getNode(PipboyNode::PipboyBone)) {
+            fingerprint.pipboyBoneParent = pipboyBone->parent;
+            fingerprint.pipboyModel = _scene.getFirstChild(pipboyBone);
+        }
+        return fingerprint;
+    }
+
+    /**
+     * The node the given Pipboy node is searched under, the hands are under the shoulders and the rest under the Pipboy arm.
+     */
+    RE::NiAVObject* PipboyNodes::getResolveRoot(const PipboyNodesRoots& roots, const PipboyNode node)
+    {
+        if (node == PipboyNode::LeftHand) {
+            return roots.leftShoulder;
+        }
+        if (node == PipboyNode::RightHand) {
+            return roots.rightShoulder;
+        }
+        return roots.arm;
+    }
+
+    /**
+     * Check every resolved node parent chain still reaches the node it was resolved from.
+     * A replaced or detached sub-tree keeps its nodes alive but the chain stops before the root.
+     */
+    bool PipboyNodes::isResolvedAttached(const PipboyNodesRoots& roots) const
+    {
+        for (std::size_t i = 0; i < PIPBOY_NODES_COUNT; i++) {
+            if (_nodes[i] && !isAttachedUnder(_nodes[i], getResolveRoot(roots, static_cast<PipboyNode>(i)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void PipboyNodes::resolve(const PipboyNodesRoots& roots)
+    {
+        for (std::size_t i = 0; i < PIPBOY_NODES_COUNT; i++) {
+            const auto node = static_cast<PipboyNode>(i);
+            const auto root = getResolveRoot(roots, node);
+            _nodes[i] = root ? findNode(root, node) : nullptr;
+        }
+
+        const auto resolved = std::ranges::count_if(_nodes, [](const RE::NiAVObject* node) { return node != nullptr; });
+        logger::info("Pipboy nodes resolved: {} of {}", resolved, PIPBOY_NODES_COUNT);
+    }
+
+    RE::NiAVObject* PipboyNodes::findNode(RE::NiAVObject* root, const PipboyNode node) const
+    {
+        _nameLookupsCount++;
+        return _scene.findNode(root, PIPBOY_NODE_NAMES[static_cast<std::size_t>(node)], isSearchedAsNiNode(node));
+    }
+}
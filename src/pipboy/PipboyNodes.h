@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <optional>
+
+namespace frik
+{
+    /**
+     * Pipboy related nodes resolved by name once and accessed by index during frame update.
+     * Nodes are under the arm the Pipboy is on (forearm3), except the hands used by the flashlight.
+     * The 7 Pipboy control points (see PipboyOperation) are in order for bone, trans, and orb to be indexed by operation.
+     */
+    enum class PipboyNode : uint8_t
+    {
+        PipboyBone = 0,
+        PowerDetect,
+        LightDetect,
+        RadioDetect,
+        PowerTranslate,
+        LightTranslate,
+        RadioTranslate,
+        ModeKnobDuplicate,
+        ModeKnob02,
+        PowerOn,
+        PowerOff,
+        LightOn,
+        LightOff,
+        RadioOn,
+        RadioOff,
+        RadioNeedle,
+        SelectRotate,
+        ScrollItemsKnobRot,
+        ControlBone,
+        ControlTrans = ControlBone + 7,
+        ControlOrb = ControlTrans + 7,
+        // under the arms shoulders
+        LeftHand = ControlOrb + 7,
+        RightHand,
+
+        Count
+    };
+
+    constexpr auto PIPBOY_NODES_COUNT = static_cast<std::size_t>(PipboyNode::Count);
+
+    /**
+     * The scene graph node name of each Pipboy node, must match the order of PipboyNode enum.
+     */
+    constexpr std::array<const char*, PIPBOY_NODES_COUNT> PIPBOY_NODE_NAMES = {
+        "PipboyBone",
+        "PowerDetect",
+        "LightDetect",
+        "RadioDetect",
+        "PowerTranslate",
+        "LightTranslate",
+        "RadioTranslate",
+        "ModeKnobDuplicate",
+        "ModeKnob02",
+        "PowerButton_mesh:2",
+        "PowerButton_mesh:off",
+        "LightButton_mesh:2",
+        "LightButton_mesh:off",
+        "RadioOn",
+        "RadioOff",
+        "RadioNeedle_mesh",
+        "SelectRotate",
+        "ScrollItemsKnobRot",
+        "TabChangeUp", "TabChangeDown", "PageChangeUp", "PageChangeDown", "ScrollItemsUp", "ScrollItemsDown", "SelectButton02",
+        "TabChangeUpTrans", "TabChangeDownTrans", "PageChangeUpTrans", "PageChangeDownTrans", "ScrollItemsUpTrans", "ScrollItemsDownTrans", "SelectButtonTrans",
+        "TabChangeUpOrb", "TabChangeDownOrb", "PageChangeUpOrb", "PageChangeDownOrb", "ScrollItemsUpOrb", "ScrollItemsDownOrb", "SelectItemsOrb",
+        "LArm_Hand",
+        "RArm_Hand",
+    };
+
+    /**
+     * The nodes the Pipboy nodes are resolved under: the arm the Pipboy is on (forearm3) and the shoulders for the hands.
+     */
+    struct PipboyNodesRoots
+    {
+        RE::NiAVObject* arm = nullptr;
+        RE::NiAVObject* leftShoulder = nullptr;
+        RE::NiAVObject* rightShoulder = nullptr;
+    };
+
+    /**
+     * Scene graph access of the Pipboy nodes table, the f4vr utils in game.
+     */
+    struct PipboyNodesScene
+    {
+        // find node by name under the root, only NiNode nodes if "asNiNode"
+        RE::NiAVObject* (*findNode)(RE::NiAVObject* root, const char* name, bool asNiNode);
+        RE::NiAVObject* (*getFirstChild)(RE::NiNode* node);
+    };
+
+    /**
+     * Table of the Pipboy nodes resolved when the skeleton arm, the Pipboy arm side, or the Pipboy model on the arm change.
+     * The change check compares a few node pointers so in steady state frame update does no name lookups.
+     * Deeper changes (a sub-tree of the Pipboy model replaced) are caught by verifying at low frequency that every resolved
+     * node is still attached under the node it was resolved from, walking parent pointers only.
+     * If the Pipboy model isn't on the arm yet (not picked up, still loading) resolving is retried at low frequency.
+     */
+    class PipboyNodes
+    {
+    public:
+        explicit PipboyNodes(const PipboyNodesScene& scene) :
+            _scene(scene) {}
+
+        void update(const PipboyNodesRoots& roots);
+
+        RE::NiAVObject* get(const PipboyNode node) const { return _nodes[static_cast<std::size_t>(node)]; }
+        RE::NiNode* getNode(const PipboyNode node) const { return get(node) ? get(node)->IsNode() : nullptr; }
+
+        static PipboyNode controlNode(const PipboyNode first, const int operationIdx) { return static_cast<PipboyNode>(static_cast<int>(first) + operationIdx); }
+
+        /**
+         * Counter of the name lookups done by all tables, must not grow in steady state.
+         */
+        static std::uint64_t getNameLookupsCount() { return _nameLookupsCount; }
+
+    private:
+        struct Fingerprint
+        {
+            const RE::NiAVObject* arm = nullptr;
+            const RE::NiAVObject* pipboyBoneParent = nullptr;
+            const RE::NiAVObject* pipboyModel = nullptr;
+
+            bool operator==(const Fingerprint&) const = default;
+        };
+
+        // frames between resolve retries while the Pipboy model is missing (~1 second at 90 FPS)
+        static constexpr int RESOLVE_RETRY_FRAMES = 90;
+        // frames between verifying the resolved nodes are still attached (~1 second at 90 FPS)
+        static constexpr int VERIFY_ATTACHED_FRAMES = 90;
+
+        Fingerprint getFingerprint(RE::NiAVObject* arm) const;
+        static RE::NiAVObject* getResolveRoot(const PipboyNodesRoots& roots, PipboyNode node);
+        bool isResolvedAttached(const PipboyNodesRoots& roots) const;
+        void resolve(const PipboyNodesRoots& roots);
+        RE::NiAVObject* findNode(RE::NiAVObject* root, PipboyNode node) const;
+
+        PipboyNodesScene _scene;
+
+        std::array<RE::NiAVObject*, PIPBOY_NODES_COUNT> _nodes{};
+        std::optional<Fingerprint> _fingerprint;
+        int _framesToRetry = 0;
+        int _framesToVerify = 0;
+
+        inline static std::uint64_t _nameLookupsCount = 0;
+    };
+}
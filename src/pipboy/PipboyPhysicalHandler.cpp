@@ -40,10 +40,9 @@ namespace frik
 
         const auto fingerPos = f4vr::Skelly::getBoneWorldTransform(g_config.leftHandedPipBoy ? "LArm_Finger23" : "RArm_Finger23").translate;
 
-        const auto arm = getPipboyArmNode();
-        const auto powerButton = arm ? f4vr::findNode(arm, "PowerDetect") : nullptr;
-        const auto lightButton = arm ? f4vr::findNode(arm, "LightDetect") : nullptr;
-        const auto radioButton = arm ? f4vr::findNode(arm, "RadioDetect") : nullptr;
+        const auto powerButton = _nodes.getNode(PipboyNode::PowerDetect);
+        const auto lightButton = _nodes.getNode(PipboyNode::LightDetect);
+        const auto radioButton = _nodes.getNode(PipboyNode::RadioDetect);
         if (!powerButton || !lightButton || !radioButton) {
             return;
         }
@@ -106,9 +105,8 @@ namespace frik
         } else {
             disablePipboyHandPose();
             // Remove any stuck helper orbs if Pipboy times out for any reason.
-            const auto arm = getPipboyArmNode();
-            for (const auto& orbIdx : ORBS_NAMES) {
-                if (const auto orb = f4vr::findAVObject(arm, orbIdx)) {
+            for (int i = 0; i < 7; i++) {
+                if (const auto orb = _nodes.get(PipboyNodes::controlNode(PipboyNode::ControlOrb, i))) {
                     orb->local.scale = std::min<float>(orb->local.scale, 0);
                 }
             }
@@ -121,7 +119,10 @@ namespace frik
      */
     void PipboyPhysicalHandler::operatePowerButton(const RE::NiPoint3 fingerPos, const RE::NiNode* powerButton)
     {
-        const auto powerTranslate = f4vr::findAVObject(getPipboyArmNode(), "PowerTranslate");
+        const auto powerTranslate = _nodes.get(PipboyNode::PowerTranslate);
+        if (!powerTranslate) {
+            return;
+        }
 
         const float distance = MatrixUtils::vec3Len(fingerPos - powerButton->world.translate);
         if (distance > 3) {
@@ -148,7 +149,10 @@ namespace frik
      */
     void PipboyPhysicalHandler::operateLightButton(const RE::NiPoint3 fingerPos, const RE::NiNode* lightButton)
     {
-        const auto lightTranslate = f4vr::findAVObject(getPipboyArmNode(), "LightTranslate");
+        const auto lightTranslate = _nodes.get(PipboyNode::LightTranslate);
+        if (!lightTranslate) {
+            return;
+        }
 
         const float distance = MatrixUtils::vec3Len(fingerPos - lightButton->world.translate);
         if (distance > 2.0) {
@@ -177,8 +181,10 @@ namespace frik
      */
     void PipboyPhysicalHandler::operateRadioButton(const RE::NiPoint3 fingerPos, const RE::NiNode* radioButton)
     {
-        const auto arm = getPipboyArmNode();
-        const auto lightTranslate = f4vr::findAVObject(arm, "RadioTranslate");
+        const auto lightTranslate = _nodes.get(PipboyNode::RadioTranslate);
+        if (!lightTranslate) {
+            return;
+        }
 
         const float distance = MatrixUtils::vec3Len(fingerPos - radioButton->world.translate);
         if (distance > 2.0) {
@@ -207,16 +213,15 @@ namespace frik
      */
     void PipboyPhysicalHandler::updatePipboyPhysicalElements(const PipboyPage lastPipboyPage)
     {
-        const auto arm = getPipboyArmNode();
-        const auto pageKnob = f4vr::findAVObject(arm, "ModeKnobDuplicate");
-        const auto pageKnob2 = f4vr::findAVObject(arm, "ModeKnob02");
-        const auto powerOn = f4vr::findAVObject(arm, "PowerButton_mesh:2");
-        const auto powerOff = f4vr::findAVObject(arm, "PowerButton_mesh:off");
-        const auto lightOn = f4vr::findAVObject(arm, "LightButton_mesh:2");
-        const auto lightOff = f4vr::findAVObject(arm, "LightButton_mesh:off");
-        const auto radioOn = f4vr::findAVObject(arm, "RadioOn");
-        const auto radioOff = f4vr::findAVObject(arm, "RadioOff");
-        const auto radioNeedle = f4vr::findAVObject(arm, "RadioNeedle_mesh");
+        const auto pageKnob = _nodes.get(PipboyNode::ModeKnobDuplicate);
+        const auto pageKnob2 = _nodes.get(PipboyNode::ModeKnob02);
+        const auto powerOn = _nodes.get(PipboyNode::PowerOn);
+        const auto powerOff = _nodes.get(PipboyNode::PowerOff);
+        const auto lightOn = _nodes.get(PipboyNode::LightOn);
+        const auto lightOff = _nodes.get(PipboyNode::LightOff);
+        const auto radioOn = _nodes.get(PipboyNode::RadioOn);
+        const auto radioOff = _nodes.get(PipboyNode::RadioOff);
+        const auto radioNeedle = _nodes.get(PipboyNode::RadioNeedle);
         if (!powerOn || !powerOff || !lightOn || !lightOff || !radioOn || !radioOff || !radioNeedle || !pageKnob) {
             return;
         }
@@ -278,7 +283,7 @@ namespace frik
         const auto secondaryTrigger = vrcf::VRControllers.getAxisValue(vrcf::Hand::Offhand, vrcf::Axis::Trigger);
 
         // Move Pipboy trigger mesh with controller trigger position.
-        if (const auto trans = f4vr::findAVObject(arm, "SelectRotate")) {
+        if (const auto trans = _nodes.get(PipboyNode::SelectRotate)) {
             if (doinantTrigger.x > 0.00 && secondaryTrigger.x == 0.0) {
                 trans->local.translate.z = doinantTrigger.x / 3 * -1;
             } else if (secondaryTrigger.x > 0.00 && doinantTrigger.x == 0.0) {
@@ -290,7 +295,10 @@ namespace frik
 
         const bool isPBMessageBoxVisible = PipboyOperationHandler::isMessageHolderVisible(PipboyOperationHandler::getPipboyMenuRoot());
         if (lastPipboyPage != PipboyPage::MAP || isPBMessageBoxVisible) {
-            const auto scrollKnob = f4vr::findAVObject(arm, "ScrollItemsKnobRot");
+            const auto scrollKnob = _nodes.get(PipboyNode::ScrollItemsKnobRot);
+            if (!scrollKnob) {
+                return;
+            }
             if (doinantHandStick.y > 0.85) {
                 scrollKnob->local.rotate = scrollKnob->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(0.4f), 0);
             }
@@ -306,10 +314,10 @@ namespace frik
     void PipboyPhysicalHandler::operatePipboyPhysicalElement(const RE::NiPoint3 fingerPos, const PipboyOperation operation)
     {
         const int opIdx = static_cast<int>(operation);
-        const auto armBone = (g_config.leftHandedPipBoy ? _skelly->getRightArm() : _skelly->getLeftArm()).forearm3;
-        const auto bone = f4vr::findAVObject(armBone, BONES_NAMES[opIdx]);
-        const auto trans = f4vr::findAVObject(armBone, TRANS_NAMES[opIdx]);
-        const auto orbName = ORBS_NAMES[opIdx];
+        const auto bone = _nodes.get(PipboyNodes::controlNode(PipboyNode::ControlBone, opIdx));
+        const auto trans = _nodes.get(PipboyNodes::controlNode(PipboyNode::ControlTrans, opIdx));
+        const auto orb = _nodes.get(PipboyNodes::controlNode(PipboyNode::ControlOrb, opIdx));
+        const auto scrollKnob = _nodes.get(PipboyNode::ScrollItemsKnobRot);
         const float boneDistance = BONES_DISTANCES[opIdx];
         const float transDistance = TRANS_DISTANCES[opIdx];
         const float maxDistance = MAX_DISTANCES[opIdx];
@@ -320,37 +328,25 @@ namespace frik
             if (distance > boneDistance) {
                 trans->local.translate.z = 0.0;
                 controlSticky = false;
-                RE::NiAVObject* orb = g_config.leftHandedPipBoy
-                    ? f4vr::findAVObject(_skelly->getRightArm().forearm3, orbName)
-                    : f4vr::findAVObject(_skelly->getLeftArm().forearm3, orbName); //Hide helper Orbs when not near a control surface
+                //Hide helper Orbs when not near a control surface
                 if (orb != nullptr) {
                     orb->local.scale = std::min<float>(orb->local.scale, 0);
                 }
             } else if (distance <= boneDistance) {
                 const float fz = boneDistance - distance;
-                RE::NiAVObject* orb = g_config.leftHandedPipBoy
-                    ? f4vr::findAVObject(_skelly->getRightArm().forearm3, orbName)
-                    : f4vr::findAVObject(_skelly->getLeftArm().forearm3, orbName); //Show helper Orbs when not near a control surface
+                //Show helper Orbs when not near a control surface
                 if (orb != nullptr) {
                     orb->local.scale = std::max<float>(orb->local.scale, 1);
                 }
                 if (fz > 0.0 && fz < maxDistance) {
                     trans->local.translate.z = fz;
-                    if (operation == PipboyOperation::MOVE_LIST_SELECTION_UP) {
+                    if (operation == PipboyOperation::MOVE_LIST_SELECTION_UP && scrollKnob) {
                         // Move Scroll Knob Anti-Clockwise when near control surface
-                        static std::string KnobNode = "ScrollItemsKnobRot";
-                        RE::NiAVObject* ScrollKnob = g_config.leftHandedPipBoy
-                            ? f4vr::findAVObject(_skelly->getRightArm().forearm3, KnobNode)
-                            : f4vr::findAVObject(_skelly->getLeftArm().forearm3, KnobNode);
-                        ScrollKnob->local.rotate = ScrollKnob->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(fz), 0);
-                    } else if (operation == PipboyOperation::MOVE_LIST_SELECTION_DOWN) {
+                        scrollKnob->local.rotate = scrollKnob->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(fz), 0);
+                    } else if (operation == PipboyOperation::MOVE_LIST_SELECTION_DOWN && scrollKnob) {
                         // Move Scroll Knob Clockwise when near control surface
                         const float roty = fz * -1;
-                        static std::string KnobNode = "ScrollItemsKnobRot";
-                        RE::NiAVObject* ScrollKnob = g_config.leftHandedPipBoy
-                            ? f4vr::findAVObject(_skelly->getRightArm().forearm3, KnobNode)
-                            : f4vr::findAVObject(_skelly->getLeftArm().forearm3, KnobNode);
-                        ScrollKnob->local.rotate = ScrollKnob->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(roty), 0);
+                        scrollKnob->local.rotate = scrollKnob->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(roty), 0);
                     }
                 }
                 if (trans->local.translate.z > transDistance && !controlSticky) {
@@ -360,9 +356,4 @@ namespace frik
             }
         }
     }
-
-    RE::NiAVObject* PipboyPhysicalHandler::getPipboyArmNode() const
-    {
-        return (g_config.leftHandedPipBoy ? _skelly->getRightArm() : _skelly->getLeftArm()).forearm3;
-    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PipboyNodes.h"
 #include "PipboyOperationHandler.h"
 #include "skeleton/Skeleton.h"
 
@@ -15,8 +16,8 @@ namespace frik
     class PipboyPhysicalHandler
     {
     public:
-        explicit PipboyPhysicalHandler(Skeleton* skelly, Pipboy* pipboy) :
-            _skelly(skelly), _pipboy(pipboy) {}
+        PipboyPhysicalHandler(Skeleton* skelly, Pipboy* pipboy, const PipboyNodes& nodes) :
+            _skelly(skelly), _pipboy(pipboy), _nodes(nodes) {}
 
         bool isOperating() const { return _isOperatingPipboy; }
         void operate(PipboyPage lastPipboyPage);
@@ -29,10 +30,10 @@ namespace frik
         void operateRadioButton(RE::NiPoint3 fingerPos, const RE::NiNode* radioButton);
         void updatePipboyPhysicalElements(PipboyPage lastPipboyPage);
         void operatePipboyPhysicalElement(RE::NiPoint3 fingerPos, PipboyOperation operation);
-        RE::NiAVObject* getPipboyArmNode() const;
 
         Skeleton* _skelly;
         Pipboy* _pipboy;
+        const PipboyNodes& _nodes;
 
         bool _isOperatingPipboy = false;
 
@@ -43,16 +44,8 @@ namespace frik
         float _lastRadioFreq = 0.0;
 
         // the other 7 points of interaction with the Pipboy (not including power, light, and radio)
+        // the control points bone, trans, and orb nodes are in PipboyNodes (ControlBone, ControlTrans, ControlOrb)
         bool _controlsSticky[7] = { false, false, false, false, false, false, false };
-        inline static std::string BONES_NAMES[7] = {
-            "TabChangeUp", "TabChangeDown", "PageChangeUp", "PageChangeDown", "ScrollItemsUp", "ScrollItemsDown", "SelectButton02"
-        };
-        inline static std::string TRANS_NAMES[7] = {
-            "TabChangeUpTrans", "TabChangeDownTrans", "PageChangeUpTrans", "PageChangeDownTrans", "ScrollItemsUpTrans", "ScrollItemsDownTrans", "SelectButtonTrans"
-        };
-        inline static std::string ORBS_NAMES[7] = {
-            "TabChangeUpOrb", "TabChangeDownOrb", "PageChangeUpOrb", "PageChangeDownOrb", "ScrollItemsUpOrb", "ScrollItemsDownOrb", "SelectItemsOrb"
-        };
         inline static float BONES_DISTANCES[7] = { 2.0f, 2.0f, 2.0f, 2.0f, 1.5f, 1.5f, 2.0f };
         inline static float TRANS_DISTANCES[7] = { 0.6f, 0.6f, 0.6f, 0.6f, 0.1f, 0.1f, 0.4f };
         inline static float MAX_DISTANCES[7] = { 1.2f, 1.2f, 1.2f, 1.2f, 1.2f, 1.2f, 0.6f };
@@ -5,229 +5,4 @@
 #define IDR_PIPBOY_HOLO_OFFSETS            105
 #define IDR_PIPBOY_SCREEN_OFFSETS          106
 #define IDR_PIPBOY_ATTABOY_OFFSETS         107
-
-// Embedded weapon offsets JSON files
-// Created via script, must be sequentially numbered
-// Get-ChildItem -File | Select-Object -ExpandProperty Name > "..\file_names.txt"
-#define IDR_WO_44_LEFTHANDED 200
-#define IDR_WO_44_POWERARMOR 201
-#define IDR_WO_44 202
-#define IDR_WO_10MM_LEFTHANDED 203
-#define IDR_WO_10MM_POWERARMOR 204
-#define IDR_WO_10MM 205
-#define IDR_WO_ALIEN_BLASTER_POWERARMOR 206
-#define IDR_WO_ALIEN_BLASTER 207
-#define IDR_WO_AMMOFLARESIGNAL_THROWABLE 208
-#define IDR_WO_ASSAULT_RIFLE_LEFTHANDED 209
-#define IDR_WO_ASSAULT_RIFLE_OFFHAND 210
-#define IDR_WO_ASSAULT_RIFLE_POWERARMOR 211
-#define IDR_WO_ASSAULT_RIFLE 212
-#define IDR_WO_BASEBALL_BAT_POWERARMOR 213
-#define IDR_WO_BASEBALL_BAT 214
-#define IDR_WO_BASEBALLGRENADE_THROWABLE_POWERARMOR 215
-#define IDR_WO_BASEBALLGRENADE_THROWABLE 216
-#define IDR_WO_BATON_LEFTHANDED 217
-#define IDR_WO_BATON_POWERARMOR 218
-#define IDR_WO_BATON 219
-#define IDR_WO_BINOCULARS_LEFTHANDED 220
-#define IDR_WO_BINOCULARS_POWERARMOR 221
-#define IDR_WO_BINOCULARS 222
-#define IDR_WO_BOARD_POWERARMOR 223
-#define IDR_WO_BOARD 224
-#define IDR_WO_BOTTLECAPMINE_THROWABLE_POWERARMOR 225
-#define IDR_WO_BOTTLECAPMINE_THROWABLE 226
-#define IDR_WO_BOTTLEVODKA01EMPTY001_THROWABLE_POWERARMOR 227
-#define IDR_WO_BOTTLEVODKA01EMPTY001_THROWABLE 228
-#define IDR_WO_BOXING_GLOVE 229
-#define IDR_WO_BREAK_ACTION_LASER_POWERARMOR 230
-#define IDR_WO_BREAK_ACTION_LASER 231
-#define IDR_WO_BROADSIDER_OFFHAND 232
-#define IDR_WO_BROADSIDER_POWERARMOR 233
-#define IDR_WO_BROADSIDER 234
-#define IDR_WO_CHINESE_OFFICER_SWORD_POWERARMOR 235
-#define IDR_WO_CHINESE_OFFICER_SWORD 236
-#define IDR_WO_COMBAT_KNIFE_LEFTHANDED 237
-#define IDR_WO_COMBAT_KNIFE_POWERARMOR 238
-#define IDR_WO_COMBAT_KNIFE 239
-#define IDR_WO_COMBAT_RIFLE_LEFTHANDED 240
-#define IDR_WO_COMBAT_RIFLE_OFFHAND 241
-#define IDR_WO_COMBAT_RIFLE_POWERARMOR 242
-#define IDR_WO_COMBAT_RIFLE_PRIMHAND_LEFTHANDED 243
-#define IDR_WO_COMBAT_RIFLE_PRIMHAND_POWERARMOR 244
-#define IDR_WO_COMBAT_RIFLE_PRIMHAND 245
-#define IDR_WO_COMBAT_RIFLE 246
-#define IDR_WO_COMBAT_SHOTGUN_LEFTHANDED 247
-#define IDR_WO_COMBAT_SHOTGUN_OFFHAND 248
-#define IDR_WO_COMBAT_SHOTGUN_POWERARMOR 249
-#define IDR_WO_COMBAT_SHOTGUN_PRIMHAND_LEFTHANDED 250
-#define IDR_WO_COMBAT_SHOTGUN_PRIMHAND 251
-#define IDR_WO_COMBAT_SHOTGUN 252
-#define IDR_WO_CRYOGRENADE_THROWABLE 253
-#define IDR_WO_CRYOLATOR_LEFTHANDED 254
-#define IDR_WO_CRYOLATOR_OFFHAND_POWERARMOR 255
-#define IDR_WO_CRYOLATOR_OFFHAND 256
-#define IDR_WO_CRYOLATOR_POWERARMOR 257
-#define IDR_WO_CRYOLATOR 258
-#define IDR_WO_CRYOMINE_THROWABLE 259
-#define IDR_WO_DEATHCLAW_GAUNTLET 260
-#define IDR_WO_DELIVERER_LEFTHANDED 261
-#define IDR_WO_DELIVERER_POWERARMOR 262
-#define IDR_WO_DELIVERER 263
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN_LEFTHANDED 264
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN_OFFHAND 265
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN_POWERARMOR 266
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN_PRIMHAND_LEFTHANDED 267
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN_PRIMHAND 268
-#define IDR_WO_DOUBLE_BARREL_SHOTGUN 269
-#define IDR_WO_FAT_MAN_LEFTHANDED 270
-#define IDR_WO_FAT_MAN_OFFHAND_POWERARMOR 271
-#define IDR_WO_FAT_MAN_OFFHAND 272
-#define IDR_WO_FAT_MAN_POWERARMOR 273
-#define IDR_WO_FAT_MAN 274
-#define IDR_WO_FLAMER_LEFTHANDED 275
-#define IDR_WO_FLAMER_OFFHAND_POWERARMOR 276
-#define IDR_WO_FLAMER_OFFHAND 277
-#define IDR_WO_FLAMER_POWERARMOR 278
-#define IDR_WO_FLAMER 279
-#define IDR_WO_FLARE_GUN_POWERARMOR 280
-#define IDR_WO_FLARE_GUN 281
-#define IDR_WO_GAMMA_GUN_POWERARMOR 282
-#define IDR_WO_GAMMA_GUN 283
-#define IDR_WO_GASGRENADE_THROWABLE 284
-#define IDR_WO_GATLING_LASER_LEFTHANDED 285
-#define IDR_WO_GATLING_LASER_OFFHAND_POWERARMOR 286
-#define IDR_WO_GATLING_LASER_OFFHAND 287
-#define IDR_WO_GATLING_LASER_POWERARMOR 288
-#define IDR_WO_GATLING_LASER 289
-#define IDR_WO_GAUSS_RIFLE_LEFTHANDED 290
-#define IDR_WO_GAUSS_RIFLE_OFFHAND 291
-#define IDR_WO_GAUSS_RIFLE_POWERARMOR 292
-#define IDR_WO_GAUSS_RIFLE 293
-#define IDR_WO_GRENADEFRAG_THROWABLE_POWERARMOR 294
-#define IDR_WO_GRENADEFRAG_THROWABLE 295
-#define IDR_WO_GRENADEPULSE_THROWABLE_POWERARMOR 296
-#define IDR_WO_GRENADEPULSE_THROWABLE 297
-#define IDR_WO_HANDMADE_RIFLE_LEFTHANDED 298
-#define IDR_WO_HANDMADE_RIFLE 299
-#define IDR_WO_HUNTING_RIFLE_LEFTHANDED 300
-#define IDR_WO_HUNTING_RIFLE_OFFHAND_POWERARMOR 301
-#define IDR_WO_HUNTING_RIFLE_OFFHAND 302
-#define IDR_WO_HUNTING_RIFLE_POWERARMOR 303
-#define IDR_WO_HUNTING_RIFLE_PRIMHAND_LEFTHANDED 304
-#define IDR_WO_HUNTING_RIFLE_PRIMHAND_POWERARMOR 305
-#define IDR_WO_HUNTING_RIFLE_PRIMHAND 306
-#define IDR_WO_HUNTING_RIFLE 307
-#define IDR_WO_INSTITUTE_RIFLE_LEFTHANDED 308
-#define IDR_WO_INSTITUTE_RIFLE_OFFHAND 309
-#define IDR_WO_INSTITUTE_RIFLE_POWERARMOR 310
-#define IDR_WO_INSTITUTE_RIFLE_PRIMHAND_LEFTHANDED 311
-#define IDR_WO_INSTITUTE_RIFLE_PRIMHAND 312
-#define IDR_WO_INSTITUTE_RIFLE 313
-#define IDR_WO_INSTITUTE_LEFTHANDED 314
-#define IDR_WO_INSTITUTE_OFFHAND 315
-#define IDR_WO_INSTITUTE_POWERARMOR 316
-#define IDR_WO_INSTITUTE 317
-#define IDR_WO_JUNK_JET_OFFHAND 318
-#define IDR_WO_JUNK_JET_POWERARMOR 319
-#define IDR_WO_JUNK_JET 320
-#define IDR_WO_KNUCKLES 321
-#define IDR_WO_LASER_MUSKET_LEFTHANDED 322
-#define IDR_WO_LASER_MUSKET_OFFHAND 323
-#define IDR_WO_LASER_MUSKET_POWERARMOR 324
-#define IDR_WO_LASER_MUSKET_PRIMHAND_LEFTHANDED 325
-#define IDR_WO_LASER_MUSKET_PRIMHAND 326
-#define IDR_WO_LASER_MUSKET 327
-#define IDR_WO_LASER_RIFLE_LEFTHANDED 328
-#define IDR_WO_LASER_RIFLE_OFFHAND 329
-#define IDR_WO_LASER_RIFLE_POWERARMOR 330
-#define IDR_WO_LASER_RIFLE_PRIMHAND_LEFTHANDED 331
-#define IDR_WO_LASER_RIFLE 332
-#define IDR_WO_LASER_LEFTHANDED 333
-#define IDR_WO_LASER_OFFHAND_POWERARMOR 334
-#define IDR_WO_LASER_OFFHAND 335
-#define IDR_WO_LASER_POWERARMOR 336
-#define IDR_WO_LASER 337
-#define IDR_WO_LEAD_PIPE_POWERARMOR 338
-#define IDR_WO_LEAD_PIPE 339
-#define IDR_WO_MACHETE_POWERARMOR 340
-#define IDR_WO_MACHETE 341
-#define IDR_WO_MINIGUN_LEFTHANDED 342
-#define IDR_WO_MINIGUN_OFFHAND_POWERARMOR 343
-#define IDR_WO_MINIGUN_OFFHAND 344
-#define IDR_WO_MINIGUN_POWERARMOR 345
-#define IDR_WO_MINIGUN 346
-#define IDR_WO_MISSILE_LAUNCHER_LEFTHANDED 347
-#define IDR_WO_MISSILE_LAUNCHER_OFFHAND 348
-#define IDR_WO_MISSILE_LAUNCHER_POWERARMOR 349
-#define IDR_WO_MISSILE_LAUNCHER 350
-#define IDR_WO_NUKEGRENADE_THROWABLE_POWERARMOR 351
-#define IDR_WO_NUKEGRENADE_THROWABLE 352
-#define IDR_WO_NUKEMINE_THROWABLE 353
-#define IDR_WO_PIPE_BOLT_ACTION_RIFLE_POWERARMOR 354
-#define IDR_WO_PIPE_BOLT_ACTION_RIFLE 355
-#define IDR_WO_PIPE_BOLT_ACTION_LEFTHANDED 356
-#define IDR_WO_PIPE_BOLT_ACTION_OFFHAND 357
-#define IDR_WO_PIPE_BOLT_ACTION_POWERARMOR 358
-#define IDR_WO_PIPE_BOLT_ACTION 359
-#define IDR_WO_PIPE_REVOLVER_POWERARMOR 360
-#define IDR_WO_PIPE_REVOLVER 361
-#define IDR_WO_PIPE_RIFLE_LEFTHANDED 362
-#define IDR_WO_PIPE_RIFLE_POWERARMOR 363
-#define IDR_WO_PIPE_RIFLE_PRIMHAND_LEFTHANDED 364
-#define IDR_WO_PIPE_RIFLE_PRIMHAND 365
-#define IDR_WO_PIPE_RIFLE 366
-#define IDR_WO_PIPE_WRENCH_POWERARMOR 367
-#define IDR_WO_PIPE_WRENCH 368
-#define IDR_WO_PIPE_LEFTHANDED 369
-#define IDR_WO_PIPE_OFFHAND 370
-#define IDR_WO_PIPE_POWERARMOR 371
-#define IDR_WO_PIPE 372
-#define IDR_WO_PLASMA_RIFLE_LEFTHANDED 373
-#define IDR_WO_PLASMA_RIFLE_OFFHAND 374
-#define IDR_WO_PLASMA_RIFLE_POWERARMOR 375
-#define IDR_WO_PLASMA_RIFLE 376
-#define IDR_WO_PLASMA_LEFTHANDED 377
-#define IDR_WO_PLASMA_OFFHAND 378
-#define IDR_WO_PLASMA_POWERARMOR 379
-#define IDR_WO_PLASMA 380
-#define IDR_WO_PLASMAGRENADE_THROWABLE_POWERARMOR 381
-#define IDR_WO_PLASMAGRENADE_THROWABLE 382
-#define IDR_WO_PLASMAMINE_THROWABLE_POWERARMOR 383
-#define IDR_WO_PLASMAMINE_THROWABLE 384
-#define IDR_WO_POWER_FIST 385
-#define IDR_WO_PULSEMINE_THROWABLE_POWERARMOR 386
-#define IDR_WO_PULSEMINE_THROWABLE 387
-#define IDR_WO_RAILWAY_RIFLE_OFFHAND 388
-#define IDR_WO_RAILWAY_RIFLE_POWERARMOR 389
-#define IDR_WO_RAILWAY_RIFLE 390
-#define IDR_WO_REVOLUTIONARY_SWORD_POWERARMOR 391
-#define IDR_WO_REVOLUTIONARY_SWORD 392
-#define IDR_WO_RIPPER_POWERARMOR 393
-#define IDR_WO_RIPPER 394
-#define IDR_WO_SERVICE_RIFLE_OFFHAND_POWERARMOR 395
-#define IDR_WO_SERVICE_RIFLE_OFFHAND 396
-#define IDR_WO_SERVICE_RIFLE_POWERARMOR 397
-#define IDR_WO_SERVICE_RIFLE 398
-#define IDR_WO_SHISHKEBAB_POWERARMOR 399
-#define IDR_WO_SHISHKEBAB 400
-#define IDR_WO_SLEDGEHAMMER_POWERARMOR 401
-#define IDR_WO_SLEDGEHAMMER 402
-#define IDR_WO_SUBMACHINE_GUN_LEFTHANDED 403
-#define IDR_WO_SUBMACHINE_GUN_OFFHAND 404
-#define IDR_WO_SUBMACHINE_GUN_POWERARMOR 405
-#define IDR_WO_SUBMACHINE_GUN 406
-#define IDR_WO_SUPER_SLEDGE_POWERARMOR 407
-#define IDR_WO_SUPER_SLEDGE 408
-#define IDR_WO_SWITCHBLADE_LEFTHANDED 409
-#define IDR_WO_SWITCHBLADE_POWERARMOR 410
-#define IDR_WO_SWITCHBLADE 411
-#define IDR_WO_SYRINGER_POWERARMOR 412
-#define IDR_WO_SYRINGER 413
-#define IDR_WO_TESTMINE_THROWABLE_POWERARMOR 414
-#define IDR_WO_TESTMINE_THROWABLE 415
-#define IDR_WO_TIRE_IRON_POWERARMOR 416
-#define IDR_WO_TIRE_IRON 417
-#define IDR_WO_WALKING_CANE 418
-#define IDR_WO_RANGED_FLARE_GUN_LEFTHANDED 419
-#define IDR_WO_RANGED_FLARE_GUN_POWERARMOR 420
-#define IDR_WO_RANGED_FLARE_GUN 421
+#define IDR_WEAPONS_OFFSETS_BLOB           108
@@ -0,0 +1,96 @@
+#include "BoneKinematics.h"
+
+namespace frik
+{
+    BoneKinematics::Handle BoneKinematics::addTrack()
+    {
+        _tracks.emplace_back();
+        return static_cast<Handle>(_tracks.size() - 1);
+    }
+
+    void BoneKinematics::clear()
+    {
+        _tracks.clear();
+    }
+
+    /**
+     * Drop all the samples but keep the tracks, used when positions jump (teleport, skeleton re-init).
+     */
+    void BoneKinematics::resetHistory()
+    {
+        for (auto& track : _tracks) {
+            track.head = 0;
+            track.count = 0;
+        }
+    }
+
+    void BoneKinematics::push(const Handle handle, const RE::NiPoint3& position, const float frameTime)
+    {
+        auto& track = _tracks[handle];
+        track.head = (track.head + 1) % HISTORY_SIZE;
+        track.positions[track.head] = position;
+        track.frameTimes[track.head] = frameTime;
+        track.count = (std::min)(track.count + 1, HISTORY_SIZE);
+    }
+
+    /**
+     * The sampled position "framesAgo" frames back, zero if there is no such sample.
+     */
+    RE::NiPoint3 BoneKinematics::position(const Handle handle, const std::uint32_t framesAgo) const
+    {
+        const auto& track = _tracks[handle];
+        return framesAgo < track.count ? track.positions[index(track, framesAgo)] : RE::NiPoint3(0, 0, 0);
+    }
+
+    /**
+     * The position change of a single frame "framesAgo" frames back.
+     */
+    RE::NiPoint3 BoneKinematics::displacement(const Handle handle, const std::uint32_t framesAgo) const
+    {
+        const auto& track = _tracks[handle];
+        if (framesAgo + 1 >= track.count) {
+            return { 0, 0, 0 };
+        }
+        return track.positions[index(track, framesAgo)] - track.positions[index(track, framesAgo + 1)];
+    }
+
+    /**
+     * Backward difference velocity of a single frame "framesAgo" frames back (units per second).
+     */
+    RE::NiPoint3 BoneKinematics::velocity(const Handle handle, const std::uint32_t framesAgo) const
+    {
+        const auto& track = _tracks[handle];
+        const float frameTime = track.frameTimes[index(track, framesAgo)];
+        if (framesAgo + 1 >= track.count || frameTime <= 0) {
+            return { 0, 0, 0 };
+        }
+        return displacement(handle, framesAgo) / frameTime;
+    }
+
+    /**
+     * Difference of two consecutive frame velocities over the time between their mid-points (units per second^2).
+     */
+    RE::NiPoint3 BoneKinematics::acceleration(const Handle handle, const std::uint32_t framesAgo) const
+    {
+        const auto& track = _tracks[handle];
+        const float time = (track.frameTimes[index(track, framesAgo)] + track.frameTimes[index(track, framesAgo + 1)]) / 2;
+        if (framesAgo + 2 >= track.count || time <= 0) {
+            return { 0, 0, 0 };
+        }
+        return (velocity(handle, framesAgo) - velocity(handle, framesAgo + 1)) / time;
+    }
+
+    /**
+     * Difference of the two latest accelerations over the time between their centers (units per second^3).
+     * Each acceleration is centered between two velocity mid-points, so the centers are dt0/4 + dt1/2 + dt2/4 apart.
+     */
+    RE::NiPoint3 BoneKinematics::jerk(const Handle handle) const
+    {
+        const auto& track = _tracks[handle];
+        const float time = track.frameTimes[index(track, 0)] / 4 + track.frameTimes[index(track, 1)] / 2 + track.frameTimes[index(track, 2)] / 4;
+        if (track.count < 4 || time <= 0) {
+            return { 0, 0, 0 };
+        }
+        return (acceleration(handle, 0) - acceleration(handle, 1)) / time;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+namespace frik
+{
+    /**
+     * Short history of tracked bones world positions, sampled once per frame, with finite-difference estimates of the
+     * bones velocity, acceleration, and jerk.
+     * Tracks are added on skeleton init and read by handle, reading has no lookup or allocation.
+     * Estimates use the frame time of each sample and are zero until enough samples exist.
+     */
+    class BoneKinematics
+    {
+    public:
+        using Handle = std::uint32_t;
+
+        // number of samples kept per track, enough for jerk (4 samples) and short averages
+        static constexpr std::uint32_t HISTORY_SIZE = 8;
+
+        Handle addTrack();
+        void clear();
+        void resetHistory();
+
+        /**
+         * Add the track position sample of the current frame, "frameTime" is the time since the previous sample.
+         */
+        void push(Handle handle, const RE::NiPoint3& position, float frameTime);
+
+        std::uint32_t samplesCount(const Handle handle) const { return _tracks[handle].count; }
+
+        RE::NiPoint3 position(Handle handle, std::uint32_t framesAgo = 0) const;
+        RE::NiPoint3 displacement(Handle handle, std::uint32_t framesAgo = 0) const;
+        RE::NiPoint3 velocity(Handle handle, std::uint32_t framesAgo = 0) const;
+        RE::NiPoint3 acceleration(Handle handle, std::uint32_t framesAgo = 0) const;
+        RE::NiPoint3 jerk(Handle handle) const;
+
+    private:
+        struct Track
+        {
+            std::array<RE::NiPoint3, HISTORY_SIZE> positions{};
+            std::array<float, HISTORY_SIZE> frameTimes{};
+            std::uint32_t head = 0;
+            std::uint32_t count = 0;
+        };
+
+        static std::uint32_t index(const Track& track, const std::uint32_t framesAgo) { return (track.head + HISTORY_SIZE - framesAgo) % HISTORY_SIZE; }
+
+        std::vector<Track> _tracks;
+    };
+}
@@ -0,0 +1,28 @@
+#include "BoneSphereEventQueue.h"
+
+#include <algorithm>
+
+namespace frik
+{
+    /**
+     * Add event to the queue, coalescing it with the last pending event of the same handle and device.
+     */
+    void BoneSphereEventQueue::push(const BoneSphereEvent event, const std::uint32_t handle, const std::uint32_t device)
+    {
+        const auto last = std::find_if(_events.rbegin(), _events.rend(), [&](const BoneSphereQueuedEvent& evt) {
+            return evt.handle == handle && evt.device == device;
+        });
+
+        if (last != _events.rend()) {
+            if (last->event == event) {
+                return;
+            }
+            if (last->event == BoneSphereEvent::Enter && event == BoneSphereEvent::Exit) {
+                _events.erase(std::next(last).base());
+                return;
+            }
+        }
+
+        _events.push_back({ event, handle, device });
+    }
+}
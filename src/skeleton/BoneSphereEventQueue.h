@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+
+namespace frik
+{
+    enum class BoneSphereEvent : uint8_t
+    {
+        None = 0,
+        Enter = 1,
+        Exit = 2,
+    };
+
+    struct BoneSphereQueuedEvent
+    {
+        BoneSphereEvent event;
+        std::uint32_t handle;
+        std::uint32_t device;
+    };
+
+    /**
+     * Queue of bone sphere events detected during the frame, dispatched once at the end of the frame.
+     * An exit of a sphere the device entered in the same frame (or that is still pending from a previous frame) removes
+     * the pending enter instead of queueing the exit as nothing changed from the listener point of view.
+     * A repeated event for the same handle and device is ignored.
+     * Flush dispatches up to the per-frame cap in detection order, the rest is carried over to the next frame.
+     */
+    class BoneSphereEventQueue
+    {
+    public:
+        void push(BoneSphereEvent event, std::uint32_t handle, std::uint32_t device);
+
+        /**
+         * Dispatch up to "maxEvents" pending events (0 for no limit) in order and return the number dispatched.
+         */
+        template <typename Dispatch>
+        std::size_t flush(const std::size_t maxEvents, Dispatch&& dispatch)
+        {
+            const auto count = maxEvents == 0 ? _events.size() : (std::min)(maxEvents, _events.size());
+            for (std::size_t i = 0; i < count; i++) {
+                const auto evt = _events.front();
+                _events.pop_front();
+                dispatch(evt);
+            }
+            return count;
+        }
+
+        std::size_t pending() const { return _events.size(); }
+        void clear() { _events.clear(); }
+
+    private:
+        std::deque<BoneSphereQueuedEvent> _events;
+    };
+}
@@ -1,7 +1,5 @@
 #include "BoneSpheresHandler.h"
 
-#include <ranges>
-
 #include "FRIK.h"
 #include "f4sevr/PapyrusNativeFunctions.h"
 #include "f4sevr/PapyrusUtils.h"
@@ -72,6 +70,24 @@ namespace frik
         handleDebugBoneSpheres();
     }
 
+    /**
+     * Send the bone sphere events queued in this frame to registered scripts, called once at the end of the frame.
+     * Limited to configured number of events per frame to prevent VM call bursts, the rest are sent in the next frames.
+     */
+    void BoneSpheresHandler::flushEvents()
+    {
+        if (_boneSphereEventRegs.empty()) {
+            _events.clear();
+            return;
+        }
+        _events.flush(static_cast<std::size_t>((std::max)(0, g_config.boneSphereEventsPerFrame)), [this](const BoneSphereQueuedEvent& evt) {
+            sendPapyrusEventToRegisteredScripts(evt.event, evt.handle, evt.device);
+        });
+        if (_events.pending() > 0) {
+            logger::debug("BoneSphere events over per-frame limit, {} carried over to next frame", _events.pending());
+        }
+    }
+
     std::uint32_t BoneSpheresHandler::registerBoneSphere(const float radius, const BSFixedString& bone)
     {
         if (radius == 0.0) {
@@ -84,12 +100,7 @@ namespace frik
             return 0;
         }
 
-        const auto sphere = new BoneSphere(radius, boneNode, RE::NiPoint3(0, 0, 0));
-        const std::uint32_t handle = _nextBoneSphereHandle++;
-
-        _boneSphereRegisteredObjects[handle] = sphere;
-
-        return handle;
+        return _boneSpheres.add(boneNode, radius, RE::NiPoint3(0, 0, 0), BONE_SPHERE_PAPYRUS_OWNER);
     }
 
     std::uint32_t BoneSpheresHandler::registerBoneSphereOffset(const float radius, const BSFixedString& bone, VMArray<float> pos)
@@ -107,20 +118,10 @@ namespace frik
             return 0;
         }
 
-        auto n = f4vr::getWorldRootNode();
-        auto boneNode = f4vr::findNode(n, bone.c_str());
-
+        const auto boneNode = findBoneSphereNode(bone.c_str());
         if (!boneNode) {
-            while (n->parent) {
-                n = n->parent;
-            }
-
-            boneNode = f4vr::findNode(n, bone.c_str()); // ObjectLODRoot
-
-            if (!boneNode) {
-                logger::info("RegisterBoneSphere: BONE DOES NOT EXIST!!");
-                return 0;
-            }
+            logger::info("RegisterBoneSphere: BONE DOES NOT EXIST!!");
+            return 0;
         }
 
         RE::NiPoint3 offsetVec;
@@ -129,25 +130,84 @@ namespace frik
         pos.Get(&offsetVec.y, 1);
         pos.Get(&offsetVec.z, 2);
 
-        const auto sphere = new BoneSphere(radius, boneNode, offsetVec);
-        const std::uint32_t handle = _nextBoneSphereHandle++;
+        return _boneSpheres.add(boneNode, radius, offsetVec, BONE_SPHERE_PAPYRUS_OWNER);
+    }
+
+    void BoneSpheresHandler::destroyBoneSphere(const std::uint32_t handle)
+    {
+        const auto index = _boneSpheres.indexOf(handle);
+        if (index < 0 || _boneSpheres.owner(index) != BONE_SPHERE_PAPYRUS_OWNER) {
+            return;
+        }
+        removeBoneSphere(index, handle);
+    }
 
-        _boneSphereRegisteredObjects[handle] = sphere;
+    /**
+     * Register a bone sphere for native plugin (FRIK API) with a callback for its events instead of Papyrus event.
+     * @return the sphere handle or 0 if failed.
+     */
+    std::uint32_t BoneSpheresHandler::registerNativeBoneSphere(const float radius, const char* bone, const RE::NiPoint3& offset, BoneSphereNativeCallback callback)
+    {
+        if (radius == 0.0 || !bone || !callback) {
+            return 0;
+        }
 
+        if (!f4vr::getPlayer()->unkF0) {
+            logger::info("can't register native bone sphere yet as new game");
+            return 0;
+        }
+
+        const auto boneNode = findBoneSphereNode(bone);
+        if (!boneNode) {
+            logger::warn("Register native bone sphere failed, bone '{}' does not exist", bone);
+            return 0;
+        }
+
+        const auto handle = _boneSpheres.add(boneNode, radius, offset, BONE_SPHERE_NATIVE_OWNER);
+        if (handle != 0) {
+            _nativeCallbacks[handle] = std::move(callback);
+        }
         return handle;
     }
 
-    void BoneSpheresHandler::destroyBoneSphere(const std::uint32_t handle)
+    bool BoneSpheresHandler::unregisterNativeBoneSphere(const std::uint32_t handle)
     {
-        if (_boneSphereRegisteredObjects.contains(handle)) {
-            if (const auto sphere = _boneSphereRegisteredObjects[handle]->debugSphere) {
-                sphere->flags.flags |= 0x1;
-                sphere->local.scale = 0;
-                sphere->parent->DetachChild(sphere);
-            }
+        const auto index = _boneSpheres.indexOf(handle);
+        if (index < 0 || _boneSpheres.owner(index) != BONE_SPHERE_NATIVE_OWNER) {
+            return false;
+        }
+        removeBoneSphere(index, handle);
+        _nativeCallbacks.erase(handle);
+        return true;
+    }
+
+    /**
+     * Find the bone node by name in the world root, fallback to the top root node (ObjectLODRoot).
+     */
+    RE::NiNode* BoneSpheresHandler::findBoneSphereNode(const char* bone)
+    {
+        auto n = f4vr::getWorldRootNode();
+        if (const auto boneNode = f4vr::findNode(n, bone)) {
+            return boneNode;
+        }
 
-            delete _boneSphereRegisteredObjects[handle];
-            _boneSphereRegisteredObjects.erase(handle);
+        while (n->parent) {
+            n = n->parent;
+        }
+        return f4vr::findNode(n, bone);
+    }
+
+    void BoneSpheresHandler::removeBoneSphere(const int index, const std::uint32_t handle)
+    {
+        if (const auto sphere = _boneSpheres.debugNode(index)) {
+            sphere->flags.flags |= 0x1;
+            sphere->local.scale = 0;
+            sphere->parent->DetachChild(sphere);
+        }
+
+        _boneSpheres.remove(handle);
+        for (auto& stickyHandles : _stickyHandles) {
+            std::erase(stickyHandles, handle);
         }
     }
 
@@ -177,17 +237,18 @@ namespace frik
         _boneSphereEventRegs.erase(scriptHandle);
     }
 
-    void BoneSpheresHandler::toggleDebugBoneSpheres(const bool turnOn) const
+    void BoneSpheresHandler::toggleDebugBoneSpheres(const bool turnOn)
     {
-        for (const auto& val : _boneSphereRegisteredObjects | std::views::values) {
-            val->turnOnDebugSpheres = turnOn;
+        for (std::size_t i = 0; i < _boneSpheres.size(); i++) {
+            _boneSpheres.setDebugOn(i, turnOn);
         }
     }
 
     void BoneSpheresHandler::toggleDebugBoneSpheresAtBone(const std::uint32_t handle, const bool turnOn)
     {
-        if (_boneSphereRegisteredObjects.contains(handle)) {
-            _boneSphereRegisteredObjects[handle]->turnOnDebugSpheres = turnOn;
+        const auto index = _boneSpheres.indexOf(handle);
+        if (index >= 0) {
+            _boneSpheres.setDebugOn(index, turnOn);
         }
     }
 
@@ -218,52 +279,71 @@ namespace frik
             return;
         }
 
-        for (const auto& element : _boneSphereRegisteredObjects) {
-            RE::NiPoint3 offset = element.second->bone->world.rotate.Transpose() * (element.second->offset);
-            offset = element.second->bone->world.translate + offset;
-
-            double dist = MatrixUtils::vec3Len(rFinger->world.translate - offset);
-
-            if (dist <= static_cast<double>(element.second->radius) - 0.1) {
-                if (!element.second->stickyRight) {
-                    element.second->stickyRight = true;
+        _boneSpheres.updateCenters();
+        detectBoneSphereForDevice(rFinger->world.translate, 1);
+        detectBoneSphereForDevice(lFinger->world.translate, 2);
+        dispatchNativeEvents();
+    }
 
-                    const std::uint32_t handle = element.first;
-                    constexpr std::uint32_t device = 1;
-                    _curDevice = 1;
-                    sendPapyrusEventToRegisteredScripts(BoneSphereEvent::Enter, handle, device);
-                }
-            } else if (dist >= static_cast<double>(element.second->radius) + 0.1) {
-                if (element.second->stickyRight) {
-                    element.second->stickyRight = false;
+    /**
+     * Detect the finger of the given device entering/exiting bone spheres, exit must be further than enter by 0.2 to prevent jitter.
+     * Only entered spheres can exit so they are checked directly, enter is checked only on the broad-phase candidates.
+     */
+    void BoneSpheresHandler::detectBoneSphereForDevice(const RE::NiPoint3& fingerPos, const std::uint32_t device)
+    {
+        constexpr float HYSTERESIS = 0.1f;
 
-                    const std::uint32_t handle = element.first;
-                    _curDevice = 0;
-                    sendPapyrusEventToRegisteredScripts(BoneSphereEvent::Exit, handle, 1);
-                }
+        std::erase_if(_stickyHandles[device], [&](const std::uint32_t handle) {
+            const auto index = _boneSpheres.indexOf(handle);
+            if (MatrixUtils::vec3Len(fingerPos - _boneSpheres.center(index)) < _boneSpheres.radius(index) + HYSTERESIS) {
+                return false;
             }
+            _boneSpheres.setSticky(index, device, false);
+            _curDevice = 0;
+            queueEvent(index, BoneSphereEvent::Exit, device);
+            return true;
+        });
+
+        _boneSpheres.forEachNear(fingerPos, HYSTERESIS, [&](const std::size_t index) {
+            if (_boneSpheres.isSticky(index, device) || MatrixUtils::vec3Len(fingerPos - _boneSpheres.center(index)) > _boneSpheres.radius(index) - HYSTERESIS) {
+                return;
+            }
+            _boneSpheres.setSticky(index, device, true);
+            _stickyHandles[device].push_back(_boneSpheres.handle(index));
+            _curDevice = device;
+            queueEvent(index, BoneSphereEvent::Enter, device);
+        });
+    }
 
-            dist = static_cast<double>(MatrixUtils::vec3Len(lFinger->world.translate - offset));
-
-            if (dist <= static_cast<double>(element.second->radius) - 0.1) {
-                if (!element.second->stickyLeft) {
-                    element.second->stickyLeft = true;
-
-                    const std::uint32_t handle = element.first;
-                    constexpr std::uint32_t device = 2;
-                    _curDevice = device;
-                    sendPapyrusEventToRegisteredScripts(BoneSphereEvent::Enter, handle, device);
-                }
-            } else if (dist >= static_cast<double>(element.second->radius) + 0.1) {
-                if (element.second->stickyLeft) {
-                    element.second->stickyLeft = false;
+    /**
+     * Queue the event for the sphere owner: Papyrus events are sent at the end of the frame, native events right after detection.
+     */
+    void BoneSpheresHandler::queueEvent(const std::size_t index, const BoneSphereEvent event, const std::uint32_t device)
+    {
+        const auto handle = _boneSpheres.handle(index);
+        if (_boneSpheres.owner(index) == BONE_SPHERE_NATIVE_OWNER) {
+            _nativeEvents.push_back({ event, handle, device });
+        } else {
+            _events.push(event, handle, device);
+        }
+    }
 
-                    const std::uint32_t handle = element.first;
-                    _curDevice = 0;
-                    sendPapyrusEventToRegisteredScripts(BoneSphereEvent::Exit, handle, 2);
-                }
+    /**
+     * Call the native callbacks of the events detected this frame.
+     * Done after detection is finished so callbacks can safely register/unregister spheres.
+     */
+    void BoneSpheresHandler::dispatchNativeEvents()
+    {
+        for (const auto& evt : _nativeEvents) {
+            const auto it = _nativeCallbacks.find(evt.handle);
+            if (it == _nativeCallbacks.end()) {
+                continue;
             }
+            // copy as the callback may unregister its own sphere
+            const auto callback = it->second;
+            callback(evt.handle, evt.event, evt.device);
         }
+        _nativeEvents.clear();
     }
 
     /**
@@ -281,36 +361,33 @@ namespace frik
 
     void BoneSpheresHandler::handleDebugBoneSpheres()
     {
-        for (const auto& val : _boneSphereRegisteredObjects | std::views::values) {
-            RE::NiNode* bone = val->bone;
-            RE::NiNode* sphere = val->debugSphere;
+        for (std::size_t i = 0; i < _boneSpheres.size(); i++) {
+            RE::NiNode* bone = _boneSpheres.bone(i);
+            RE::NiNode* sphere = _boneSpheres.debugNode(i);
+            const bool turnOn = _boneSpheres.isDebugOn(i);
+            const float radius = _boneSpheres.radius(i);
 
-            if (val->turnOnDebugSpheres && !val->debugSphere) {
+            if (turnOn && !sphere) {
                 sphere = f4vr::getClonedNiNodeForNifFileSetName("Data/Meshes/FRIK/1x1Sphere.nif");
                 if (sphere) {
                     sphere->name = RE::BSFixedString("Sphere01");
 
                     bone->AttachChild(sphere, true);
                     sphere->flags.flags &= 0xfffffffffffffffe;
-                    sphere->local.scale = val->radius * 2;
-                    val->debugSphere = sphere;
+                    sphere->local.scale = radius * 2;
+                    _boneSpheres.setDebugNode(i, sphere);
                 }
-            } else if (sphere && !val->turnOnDebugSpheres) {
+            } else if (sphere && !turnOn) {
                 sphere->flags.flags |= 0x1;
                 sphere->local.scale = 0;
-            } else if (sphere && val->turnOnDebugSpheres) {
+            } else if (sphere && turnOn) {
                 sphere->flags.flags &= 0xfffffffffffffffe;
-                sphere->local.scale = val->radius * 2;
+                sphere->local.scale = radius * 2;
             }
 
             if (sphere) {
-                RE::NiPoint3 offset;
-
-                offset = bone->world.rotate.Transpose() * (val->offset);
-                offset = bone->world.translate + offset;
-
                 // wp = parWp + parWr * lp =>   lp = (wp - parWp) * parWr'
-                sphere->local.translate = bone->world.rotate * ((offset - bone->world.translate));
+                sphere->local.translate = bone->world.rotate * (bone->world.rotate.Transpose() * _boneSpheres.offset(i));
             }
         }
     }
@@ -1,51 +1,22 @@
 #pragma once
 
+#include <functional>
+
+#include "BoneSphereEventQueue.h"
+#include "BoneSpheresStore.h"
 #include "f4sevr/PapyrusNativeFunctions.h"
 
 namespace frik
 {
     constexpr auto BONE_SPHERE_EVEN_NAME = "OnBoneSphereEvent";
 
-    enum class BoneSphereEvent : uint8_t
-    {
-        None = 0,
-        Enter = 1,
-        Exit = 2,
-    };
+    // owner id of spheres registered by native plugins via FRIK API
+    constexpr std::uint32_t BONE_SPHERE_NATIVE_OWNER = 1;
 
-    class BoneSphere
-    {
-    public:
-        BoneSphere()
-        {
-            radius = 0;
-            bone = nullptr;
-            stickyRight = false;
-            stickyLeft = false;
-            turnOnDebugSpheres = false;
-            offset.x = 0;
-            offset.y = 0;
-            offset.z = 0;
-            debugSphere = nullptr;
-        }
-
-        BoneSphere(const float a_radius, RE::NiNode* a_bone, const RE::NiPoint3 a_offset) :
-            radius(a_radius), bone(a_bone), offset(a_offset)
-        {
-            stickyRight = false;
-            stickyLeft = false;
-            turnOnDebugSpheres = false;
-            debugSphere = nullptr;
-        }
-
-        float radius;
-        RE::NiNode* bone;
-        RE::NiPoint3 offset;
-        bool stickyRight;
-        bool stickyLeft;
-        bool turnOnDebugSpheres;
-        RE::NiNode* debugSphere;
-    };
+    /**
+     * Native listener of a single bone sphere events, called in the same frame the event is detected.
+     */
+    using BoneSphereNativeCallback = std::function<void(std::uint32_t handle, BoneSphereEvent event, std::uint32_t device)>;
 
     class BoneSpheresHandler
     {
@@ -54,15 +25,19 @@ namespace frik
 
         void init();
         void onFrameUpdate();
+        void flushEvents();
 
         std::uint32_t registerBoneSphere(float radius, const F4SEVR::BSFixedString& bone);
         std::uint32_t registerBoneSphereOffset(float radius, const F4SEVR::BSFixedString& bone, F4SEVR::VMArray<float> pos);
         void destroyBoneSphere(std::uint32_t handle);
         void registerForBoneSphereEvents(F4SEVR::VMObject* scriptObj);
         void unRegisterForBoneSphereEvents(F4SEVR::VMObject* scriptObj);
-        void toggleDebugBoneSpheres(bool turnOn) const;
+        void toggleDebugBoneSpheres(bool turnOn);
         void toggleDebugBoneSpheresAtBone(std::uint32_t handle, bool turnOn);
 
+        std::uint32_t registerNativeBoneSphere(float radius, const char* bone, const RE::NiPoint3& offset, BoneSphereNativeCallback callback);
+        bool unregisterNativeBoneSphere(std::uint32_t handle);
+
     private:
         static std::uint32_t registerBoneSphereFunc(F4SEVR::StaticFunctionTag* base, float radius, F4SEVR::BSFixedString bone);
         static std::uint32_t registerBoneSphereOffsetFunc(F4SEVR::StaticFunctionTag* base, float radius, F4SEVR::BSFixedString bone, F4SEVR::VMArray<float> pos);
@@ -74,13 +49,24 @@ namespace frik
         void sendPapyrusEventToRegisteredScripts(BoneSphereEvent event, std::uint32_t handle, std::uint32_t device);
 
         void detectBoneSphere();
+        void detectBoneSphereForDevice(const RE::NiPoint3& fingerPos, std::uint32_t device);
         void handleDebugBoneSpheres();
+        void queueEvent(std::size_t index, BoneSphereEvent event, std::uint32_t device);
+        void dispatchNativeEvents();
+        void removeBoneSphere(int index, std::uint32_t handle);
+        static RE::NiNode* findBoneSphereNode(const char* bone);
 
         //
         std::unordered_map<std::uint64_t, std::string> _boneSphereEventRegs;
 
-        std::map<std::uint32_t, BoneSphere*> _boneSphereRegisteredObjects;
-        std::uint32_t _nextBoneSphereHandle = 1;
+        BoneSpheresStore _boneSpheres;
+        // handles of the spheres currently entered per device (right = 1, left = 2)
+        std::array<std::vector<std::uint32_t>, 3> _stickyHandles;
+        // events detected in the frame to send to registered scripts at the end of the frame
+        BoneSphereEventQueue _events;
+        // native registered spheres callbacks by sphere handle and their events detected in the frame
+        std::unordered_map<std::uint32_t, BoneSphereNativeCallback> _nativeCallbacks;
+        std::vector<BoneSphereQueuedEvent> _nativeEvents;
         std::uint32_t _curDevice = 0;
 
         // workaround as papyrus registration requires global functions.
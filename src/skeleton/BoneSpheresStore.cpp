@@ -0,0 +1,155 @@
+#include "BoneSpheresStore.h"
+
+#include <numeric>
+
+namespace
+{
+    constexpr std::uint32_t HANDLE_SLOT_BITS = 20;
+    constexpr std::uint32_t HANDLE_SLOT_MASK = (1 << HANDLE_SLOT_BITS) - 1;
+    // 11 bits generation so handle sign bit is never set
+    constexpr std::uint32_t HANDLE_GENERATION_MASK = (1 << 11) - 1;
+
+    /**
+     * Remove the given index by moving the last element into it.
+     */
+    template <typename T>
+    void swapRemove(std::vector<T>& vec, const std::size_t index)
+    {
+        vec[index] = vec.back();
+        vec.pop_back();
+    }
+}
+
+namespace frik
+{
+    /**
+     * Add a new sphere and return its handle, never 0.
+     */
+    std::uint32_t BoneSpheresStore::add(RE::NiNode* bone, const float radius, const RE::NiPoint3& offset, const std::uint32_t owner)
+    {
+        std::uint32_t slot;
+        if (!_freeSlots.empty()) {
+            slot = _freeSlots.back();
+            _freeSlots.pop_back();
+        } else {
+            if (_slots.size() >= HANDLE_SLOT_MASK) {
+                logger::warn("Bone spheres limit reached, can't add more");
+                return 0;
+            }
+            slot = static_cast<std::uint32_t>(_slots.size());
+            _slots.emplace_back();
+        }
+
+        const auto index = _handles.size();
+        _slots[slot].index = static_cast<int>(index);
+        const std::uint32_t handle = (_slots[slot].generation << HANDLE_SLOT_BITS) | (slot + 1);
+
+        _slotOfIndex.push_back(slot);
+        _handles.push_back(handle);
+        _owners.push_back(owner);
+        _bones.push_back(bone);
+        _offsets.push_back(offset);
+        _radius.push_back(radius);
+        _centerX.push_back(0);
+        _centerY.push_back(0);
+        _centerZ.push_back(0);
+        _stickyMask.push_back(0);
+        _debugOn.push_back(false);
+        _debugNodes.push_back(nullptr);
+
+        _maxRadius = (std::max)(_maxRadius, radius);
+        _sortedByXDirty = true;
+        return handle;
+    }
+
+    /**
+     * Remove the sphere of the given handle, the handle is invalid after this call.
+     */
+    bool BoneSpheresStore::remove(const std::uint32_t handle)
+    {
+        const auto found = indexOf(handle);
+        if (found < 0) {
+            return false;
+        }
+
+        const auto index = static_cast<std::size_t>(found);
+        const auto slot = _slotOfIndex[index];
+        _slots[_slotOfIndex.back()].index = found;
+        _slots[slot].index = -1;
+        // a slot that used all its generations is retired, reusing it would make its first handle valid again
+        if (_slots[slot].generation < HANDLE_GENERATION_MASK) {
+            _slots[slot].generation++;
+            _freeSlots.push_back(slot);
+        }
+
+        swapRemove(_slotOfIndex, index);
+        swapRemove(_handles, index);
+        swapRemove(_owners, index);
+        swapRemove(_bones, index);
+        swapRemove(_offsets, index);
+        swapRemove(_radius, index);
+        swapRemove(_centerX, index);
+        swapRemove(_centerY, index);
+        swapRemove(_centerZ, index);
+        swapRemove(_stickyMask, index);
+        swapRemove(_debugOn, index);
+        swapRemove(_debugNodes, index);
+
+        _maxRadius = _radius.empty() ? 0 : *std::ranges::max_element(_radius);
+        _sortedByXDirty = true;
+        return true;
+    }
+
+    /**
+     * Get the dense index of the sphere of the given handle, -1 if the handle is not valid.
+     */
+    int BoneSpheresStore::indexOf(const std::uint32_t handle) const
+    {
+        const auto slotId = handle & HANDLE_SLOT_MASK;
+        if (slotId == 0 || slotId > _slots.size()) {
+            return -1;
+        }
+        const auto& slot = _slots[slotId - 1];
+        return slot.generation == handle >> HANDLE_SLOT_BITS ? slot.index : -1;
+    }
+
+    /**
+     * Calculate the world center of all the spheres from their bone world transform and update the broad-phase order.
+     */
+    void BoneSpheresStore::updateCenters()
+    {
+        for (std::size_t i = 0; i < _handles.size(); i++) {
+            const auto& world = _bones[i]->world;
+            const auto center = world.translate + world.rotate.Transpose() * _offsets[i];
+            _centerX[i] = center.x;
+            _centerY[i] = center.y;
+            _centerZ[i] = center.z;
+        }
+        sortByCenterX();
+    }
+
+    /**
+     * Full sort after spheres were added/removed, otherwise insertion sort that is linear for the almost sorted order
+     * from the previous frame.
+     */
+    void BoneSpheresStore::sortByCenterX()
+    {
+        if (_sortedByXDirty) {
+            _sortedByX.resize(_handles.size());
+            std::iota(_sortedByX.begin(), _sortedByX.end(), 0);
+            std::ranges::sort(_sortedByX, {}, [this](const std::uint32_t i) { return _centerX[i]; });
+            _sortedByXDirty = false;
+            return;
+        }
+
+        for (std::size_t i = 1; i < _sortedByX.size(); i++) {
+            const auto value = _sortedByX[i];
+            const auto key = _centerX[value];
+            auto j = i;
+            for (; j > 0 && _centerX[_sortedByX[j - 1]] > key; j--) {
+                _sortedByX[j] = _sortedByX[j - 1];
+            }
+            _sortedByX[j] = value;
+        }
+    }
+}
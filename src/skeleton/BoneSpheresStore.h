@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace frik
+{
+    // owner id of spheres registered by Papyrus scripts
+    constexpr std::uint32_t BONE_SPHERE_PAPYRUS_OWNER = 0;
+
+    /**
+     * Dense SoA storage of the registered bone spheres with a broad-phase spatial index.
+     * Handles are "generation << 20 | slot + 1" so a destroyed sphere handle is never valid again even when the slot is
+     * reused, a slot is retired after 2048 generations instead of wrapping around. The handle never has the sign bit set
+     * as Papyrus passes it as signed int. Removal moves the last sphere into the
+     * removed index to keep the arrays dense, slots map the stable handle to the current dense index.
+     * The broad-phase keeps the dense indexes sorted by world center X (sort and sweep), re-sorted with insertion sort
+     * every frame as the order barely changes between frames.
+     */
+    class BoneSpheresStore
+    {
+    public:
+        std::uint32_t add(RE::NiNode* bone, float radius, const RE::NiPoint3& offset, std::uint32_t owner);
+        bool remove(std::uint32_t handle);
+        int indexOf(std::uint32_t handle) const;
+
+        void updateCenters();
+
+        /**
+         * Visit the index of every sphere its center is within (radius + margin) of the point on the X axis.
+         * Must be called after updateCenters.
+         */
+        template <typename Visitor>
+        void forEachNear(const RE::NiPoint3& point, const float margin, Visitor&& visit) const
+        {
+            const float reach = _maxRadius + margin;
+            const auto first = std::ranges::lower_bound(_sortedByX, point.x - reach, {}, [this](const std::uint32_t i) { return _centerX[i]; });
+            for (auto it = first; it != _sortedByX.end() && _centerX[*it] <= point.x + reach; ++it) {
+                if (std::abs(_centerX[*it] - point.x) <= _radius[*it] + margin) {
+                    visit(static_cast<std::size_t>(*it));
+                }
+            }
+        }
+
+        std::size_t size() const { return _handles.size(); }
+        std::uint32_t handle(const std::size_t index) const { return _handles[index]; }
+        std::uint32_t owner(const std::size_t index) const { return _owners[index]; }
+        RE::NiNode* bone(const std::size_t index) const { return _bones[index]; }
+        const RE::NiPoint3& offset(const std::size_t index) const { return _offsets[index]; }
+        float radius(const std::size_t index) const { return _radius[index]; }
+        RE::NiPoint3 center(const std::size_t index) const { return { _centerX[index], _centerY[index], _centerZ[index] }; }
+
+        bool isSticky(const std::size_t index, const std::size_t device) const { return _stickyMask[index] & (1 << device); }
+        void setSticky(const std::size_t index, const std::size_t device, const bool sticky)
+        {
+            _stickyMask[index] = sticky ? _stickyMask[index] | (1 << device) : _stickyMask[index] & ~(1 << device);
+        }
+
+        bool isDebugOn(const std::size_t index) const { return _debugOn[index]; }
+        void setDebugOn(const std::size_t index, const bool turnOn) { _debugOn[index] = turnOn; }
+        RE::NiNode* debugNode(const std::size_t index) const { return _debugNodes[index]; }
+        void setDebugNode(const std::size_t index, RE::NiNode* node) { _debugNodes[index] = node; }
+
+    private:
+        struct HandleSlot
+        {
+            std::uint32_t generation = 0;
+            // index in the dense arrays, -1 if the slot is free
+            int index = -1;
+        };
+
+        void sortByCenterX();
+
+        // handles slot map
+        std::vector<HandleSlot> _slots;
+        std::vector<std::uint32_t> _freeSlots;
+        // slot of each dense index, to update the slot of the sphere moved on removal
+        std::vector<std::uint32_t> _slotOfIndex;
+
+        // dense SoA columns
+        std::vector<std::uint32_t> _handles;
+        std::vector<std::uint32_t> _owners;
+        std::vector<RE::NiNode*> _bones;
+        std::vector<RE::NiPoint3> _offsets;
+        std::vector<float> _radius;
+        std::vector<float> _centerX;
+        std::vector<float> _centerY;
+        std::vector<float> _centerZ;
+        // bit per device the sphere is currently entered by
+        std::vector<std::uint8_t> _stickyMask;
+        std::vector<std::uint8_t> _debugOn;
+        std::vector<RE::NiNode*> _debugNodes;
+
+        // broad-phase
+        std::vector<std::uint32_t> _sortedByX;
+        bool _sortedByXDirty = false;
+        float _maxRadius = 0;
+    };
+}
@@ -0,0 +1,100 @@
+#include "BoneTreeTransformsKernel.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRIK_BONE_TREE_KERNEL_SSE2
+#endif
+
+namespace frik
+{
+    bool BoneTreeTransformsKernel::isSimdAvailable()
+    {
+#ifdef FRIK_BONE_TREE_KERNEL_SSE2
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void BoneTreeTransformsKernel::allocate()
+    {
+        const auto count = _entries.size();
+        for (auto* arrays : { &_localRotate, &_parentRotate, &_worldRotate }) {
+            for (auto& array : *arrays) {
+                array.assign(count, 0);
+            }
+        }
+        for (auto* arrays : { &_localTranslate, &_parentTranslate, &_worldTranslate }) {
+            for (auto& array : *arrays) {
+                array.assign(count, 0);
+            }
+        }
+        _parentScale.assign(count, 1);
+    }
+
+    /**
+     * Calculate the world transforms of a level entries [start, end), SIMD for groups of 4 and scalar for the tail.
+     */
+    void BoneTreeTransformsKernel::computeLevel(const std::size_t start, const std::size_t end)
+    {
+        const std::size_t simdEnd = _simdEnabled ? computeLevelSimd(start, end) : start;
+        computeLevelScalar(simdEnd, end);
+    }
+
+    void BoneTreeTransformsKernel::computeLevelScalar(const std::size_t start, const std::size_t end)
+    {
+        for (std::size_t i = start; i < end; i++) {
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    _worldRotate[r * 3 + c][i] = _localRotate[r * 3 + 0][i] * _parentRotate[0 * 3 + c][i]
+                        + _localRotate[r * 3 + 1][i] * _parentRotate[1 * 3 + c][i]
+                        + _localRotate[r * 3 + 2][i] * _parentRotate[2 * 3 + c][i];
+                }
+            }
+            const float x = _localTranslate[0][i] * _parentScale[i];
+            const float y = _localTranslate[1][i] * _parentScale[i];
+            const float z = _localTranslate[2][i] * _parentScale[i];
+            for (int v = 0; v < 3; v++) {
+                _worldTranslate[v][i] = _parentTranslate[v][i] + _parentRotate[0 * 3 + v][i] * x + _parentRotate[1 * 3 + v][i] * y + _parentRotate[2 * 3 + v][i] * z;
+            }
+        }
+    }
+
+    /**
+     * Same calculation as the scalar path for 4 entries at a time, same operations order so the results are identical.
+     * Returns the index the scalar path should continue from.
+     */
+    std::size_t BoneTreeTransformsKernel::computeLevelSimd(const std::size_t start, const std::size_t end)
+    {
+#ifdef FRIK_BONE_TREE_KERNEL_SSE2
+        std::size_t i = start;
+        for (; i + 4 <= end; i += 4) {
+            __m128 local[9];
+            __m128 parent[9];
+            for (int m = 0; m < 9; m++) {
+                local[m] = _mm_loadu_ps(&_localRotate[m][i]);
+                parent[m] = _mm_loadu_ps(&_parentRotate[m][i]);
+            }
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(local[r * 3 + 0], parent[0 * 3 + c]), _mm_mul_ps(local[r * 3 + 1], parent[1 * 3 + c])),
+                        _mm_mul_ps(local[r * 3 + 2], parent[2 * 3 + c]));
+                    _mm_storeu_ps(&_worldRotate[r * 3 + c][i], sum);
+                }
+            }
+            const __m128 scale = _mm_loadu_ps(&_parentScale[i]);
+            const __m128 x = _mm_mul_ps(_mm_loadu_ps(&_localTranslate[0][i]), scale);
+            const __m128 y = _mm_mul_ps(_mm_loadu_ps(&_localTranslate[1][i]), scale);
+            const __m128 z = _mm_mul_ps(_mm_loadu_ps(&_localTranslate[2][i]), scale);
+            for (int v = 0; v < 3; v++) {
+                const __m128 world = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_loadu_ps(&_parentTranslate[v][i]), _mm_mul_ps(parent[0 * 3 + v], x)),
+                    _mm_mul_ps(parent[1 * 3 + v], y)), _mm_mul_ps(parent[2 * 3 + v], z));
+                _mm_storeu_ps(&_worldTranslate[v][i], world);
+            }
+        }
+        return i;
+#else
+        return start;
+#endif
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace frik
+{
+    /**
+     * Batched world transform update of a fixed subset of flattened bone tree entries.
+     * Entries are grouped into topological levels (an entry's parent is in a previous level or outside the subset) and
+     * copied into contiguous SoA arrays, so each level computes "world = parent.world * local" for all its entries in a
+     * single branch-free loop, 4 entries at a time with SSE2. The results are scattered back to the tree in one pass.
+     * Gather/scatter are templated on the tree type ("transforms[pos]" with "parPos", "local", "world") so the kernel can
+     * be tested with a stand-in tree off-target.
+     */
+    class BoneTreeTransformsKernel
+    {
+    public:
+        template <typename Tree>
+        void build(const Tree* tree, const std::vector<int>& positions);
+
+        template <typename Tree>
+        void update(Tree* tree);
+
+        std::size_t size() const { return _entries.size(); }
+        std::size_t levelsCount() const { return _levelEnds.size(); }
+        std::uint64_t getUpdatesCount() const { return _updatesCount; }
+
+        /**
+         * True if the level calculation has a SIMD path in this build.
+         */
+        static bool isSimdAvailable();
+
+        /**
+         * Use the SSE2 path for the level calculation if available (default), false for the scalar path.
+         */
+        void setSimdEnabled(const bool enabled) { _simdEnabled = enabled; }
+
+    private:
+        struct Entry
+        {
+            int pos;
+            int parentPos;
+            // index of the parent in the subset, -1 if the parent world should be read from the tree
+            int parentSlot;
+        };
+
+        void allocate();
+        void computeLevel(std::size_t start, std::size_t end);
+        void computeLevelScalar(std::size_t start, std::size_t end);
+        std::size_t computeLevelSimd(std::size_t start, std::size_t end);
+
+        // subset entries sorted by level
+        std::vector<Entry> _entries;
+        // end index in _entries of each level
+        std::vector<std::size_t> _levelEnds;
+        bool _simdEnabled = true;
+        std::uint64_t _updatesCount = 0;
+
+        // SoA copies of the transforms, row-major rotation matrix entries
+        std::array<std::vector<float>, 9> _localRotate;
+        std::array<std::vector<float>, 3> _localTranslate;
+        std::array<std::vector<float>, 9> _parentRotate;
+        std::array<std::vector<float>, 3> _parentTranslate;
+        std::vector<float> _parentScale;
+        std::array<std::vector<float>, 9> _worldRotate;
+        std::array<std::vector<float>, 3> _worldTranslate;
+    };
+
+    /**
+     * Resolve the subset entries parent relations and topological levels.
+     * Positions must be ordered parent before child, as the flattened bone tree is.
+     */
+    template <typename Tree>
+    void BoneTreeTransformsKernel::build(const Tree* tree, const std::vector<int>& positions)
+    {
+        std::unordered_map<int, std::size_t> levelOfPos;
+        std::vector<std::vector<int>> levels;
+        for (const auto pos : positions) {
+            const int parentPos = tree->transforms[pos].parPos;
+            const auto parentLevel = levelOfPos.find(parentPos);
+            const std::size_t level = parentLevel != levelOfPos.end() ? parentLevel->second + 1 : 0;
+            levelOfPos[pos] = level;
+            if (level >= levels.size()) {
+                levels.resize(level + 1);
+            }
+            levels[level].push_back(pos);
+        }
+
+        _entries.clear();
+        _levelEnds.clear();
+        std::unordered_map<int, int> slotOfPos;
+        for (const auto& level : levels) {
+            for (const auto pos : level) {
+                const int parentPos = tree->transforms[pos].parPos;
+                const auto parentSlot = slotOfPos.find(parentPos);
+                slotOfPos[pos] = static_cast<int>(_entries.size());
+                _entries.push_back({ pos, parentPos, parentSlot != slotOfPos.end() ? parentSlot->second : -1 });
+            }
+            _levelEnds.push_back(_entries.size());
+        }
+        allocate();
+    }
+
+    /**
+     * Calculate the world transform of all the subset entries from their local transform and parent world transform.
+     *   world.translate = parent.translate + parent.rotate' * (local.translate * parent.scale)
+     *   world.rotate = local.rotate * parent.rotate
+     * World scale is not changed.
+     */
+    template <typename Tree>
+    void BoneTreeTransformsKernel::update(Tree* tree)
+    {
+        if (_entries.empty()) {
+            return;
+        }
+        _updatesCount++;
+
+        // gather locals
+        for (std::size_t i = 0; i < _entries.size(); i++) {
+            const auto& local = tree->transforms[_entries[i].pos].local;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    _localRotate[r * 3 + c][i] = local.rotate.entry[r][c];
+                }
+            }
+            _localTranslate[0][i] = local.translate.x;
+            _localTranslate[1][i] = local.translate.y;
+            _localTranslate[2][i] = local.translate.z;
+        }
+
+        std::size_t levelStart = 0;
+        for (const auto levelEnd : _levelEnds) {
+            // gather parents world, from the previous levels results or from the tree for parents outside the subset
+            for (std::size_t i = levelStart; i < levelEnd; i++) {
+                const auto& entry = _entries[i];
+                if (entry.parentSlot >= 0) {
+                    const auto slot = static_cast<std::size_t>(entry.parentSlot);
+                    for (int m = 0; m < 9; m++) {
+                        _parentRotate[m][i] = _worldRotate[m][slot];
+                    }
+                    for (int v = 0; v < 3; v++) {
+                        _parentTranslate[v][i] = _worldTranslate[v][slot];
+                    }
+                    _parentScale[i] = tree->transforms[entry.parentPos].world.scale;
+                } else {
+                    const auto& parent = tree->transforms[entry.parentPos].world;
+                    for (int r = 0; r < 3; r++) {
+                        for (int c = 0; c < 3; c++) {
+                            _parentRotate[r * 3 + c][i] = parent.rotate.entry[r][c];
+                        }
+                    }
+                    _parentTranslate[0][i] = parent.translate.x;
+                    _parentTranslate[1][i] = parent.translate.y;
+                    _parentTranslate[2][i] = parent.translate.z;
+                    _parentScale[i] = parent.scale;
+                }
+            }
+
+            computeLevel(levelStart, levelEnd);
+            levelStart = levelEnd;
+        }
+
+        // scatter results back to the tree
+        for (std::size_t i = 0; i < _entries.size(); i++) {
+            auto& world = tree->transforms[_entries[i].pos].world;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    world.rotate.entry[r][c] = _worldRotate[r * 3 + c][i];
+                }
+            }
+            world.translate = RE::NiPoint3(_worldTranslate[0][i], _worldTranslate[1][i], _worldTranslate[2][i]);
+        }
+    }
+}
@@ -1,75 +1,79 @@
 #include "CullGeometryHandler.h"
 
-#include <utility>
-
 #include "Config.h"
 #include "FRIK.h"
 #include "common/CommonUtils.h"
 
 using namespace common;
 
+namespace
+{
+    /**
+     * FNV-1a hash combine of a 64-bit value.
+     */
+    void hashCombine(uint64_t& hash, const uint64_t value)
+    {
+        hash = (hash ^ value) * 1099511628211ull;
+    }
+
+    constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+}
+
 namespace frik
 {
     /// <summary>
     /// Pre-calculate the indexes of the face and skin geometries to hide.
-    /// This is performance optimization to avoid iterating over all the geometries every frame by only doing it once per second.
-    /// It reduces the "cullPlayerGeometry" time from ~0.05ms to ~0.0002ms (for 89 frames, if frame-rate is 90).
-    /// May not sounds as much but total of this mod update frame is 0.25ms making it 20% of the time!
-    /// And god dammit the game is slow enough not to waste more time.
-    /// <p>
-    /// The geometry array can change when equipment is changed, weapon is drawn, etc. To handle it we check if the last
-    /// hidden geometry didn't change. If it did, we re-calculate the indexes to hide.
+    /// This is performance optimization to avoid matching all the geometries names every frame by only doing it when
+    /// the geometries array changes (equipment is changed, weapon is drawn, etc.), hide flags or hide patterns change.
+    /// Matching a name against all the hide patterns is a single pass using pre-compiled Aho-Corasick automaton.
     /// </summary>
     void CullGeometryHandler::preProcessHideGeometryIndexes(RE::BSFadeNode* rn)
     {
-        const auto now = std::time(nullptr);
-        if (now - _lastPreProcessTime < 2) {
-            // check that the geometries array didn't change by verifying the last hidden geometry is the same we expect
-            if (_lastHiddenGeometryIdx >= 0 && std::cmp_less(_lastHiddenGeometryIdx, rn->geomArray.size())) {
-                const auto gemName = std::string(rn->geomArray[_lastHiddenGeometryIdx].geometry->name.c_str());
-                if (_lastHiddenGeometryName == gemName) {
-                    return;
-                }
-            }
+        // patterns may change by config reload, the same geometries must be re-matched against the new patterns
+        const bool patternsChanged = _matchersHideMeshesVersion != g_config.getHideMeshesVersion();
+        if (patternsChanged) {
+            _faceMatcher.build(g_config.faceGeometry());
+            _skinMatcher.build(g_config.skinGeometry());
+            _matchersHideMeshesVersion = g_config.getHideMeshesVersion();
         }
-        _lastPreProcessTime = now;
+
+        const auto fingerprint = getGeometriesFingerprint(rn);
+        if (fingerprint == _lastGeometriesFingerprint && !patternsChanged) {
+            return;
+        }
+        _lastGeometriesFingerprint = fingerprint;
 
         _hideFaceSkinGeometryIndexes.clear();
         for (std::uint32_t i = 0; i < rn->geomArray.size(); i++) {
             auto& geometry = rn->geomArray[i].geometry;
-            const auto geomName = std::string(geometry->name.c_str());
-            auto geomStr = str_tolower(trim(geomName));
-
-            bool toHide = false;
-            if (g_config.hideHead) {
-                for (auto& faceGeom : g_config.faceGeometry()) {
-                    if (geomStr.find(faceGeom) != std::string::npos) {
-                        toHide = true;
-                        break;
-                    }
-                }
-            }
+            const std::string_view geomName = geometry->name.c_str();
 
-            if (g_config.hideSkin && !toHide) {
-                for (auto& skinGeom : g_config.skinGeometry()) {
-                    if (geomStr.find(skinGeom) != std::string::npos) {
-                        toHide = true;
-                        break;
-                    }
-                }
-            }
+            const bool toHide = (g_config.hideHead && _faceMatcher.containsAny(geomName)) || (g_config.hideSkin && _skinMatcher.containsAny(geomName));
 
             // in case it was hidden before and shouldn't be anymore
             f4vr::setNodeVisibility(geometry.get(), true);
 
             if (toHide) {
                 _hideFaceSkinGeometryIndexes.push_back(i);
-                _lastHiddenGeometryIdx = static_cast<int>(i);
-                _lastHiddenGeometryName = geomName;
             }
         }
     }
 
+    /// <summary>
+    /// Get a fingerprint of the geometries array (count and geometry pointers) and the hide flags.
+    /// Changes when geometries are added/removed/replaced so re-matching is required.
+    /// </summary>
+    uint64_t CullGeometryHandler::getGeometriesFingerprint(const RE::BSFadeNode* rn)
+    {
+        uint64_t hash = HASH_SEED;
+        hashCombine(hash, rn->geomArray.size());
+        hashCombine(hash, (g_config.hideHead ? 1 : 0) | (g_config.hideSkin ? 2 : 0));
+        for (const auto& geom : rn->geomArray) {
+            hashCombine(hash, reinterpret_cast<uint64_t>(geom.geometry.get()));
+        }
+        return hash;
+    }
+
     /// <summary>
     /// Hide player face/skins geometries and equipment slots.
     /// Face is things like eyes, mouth, hair, etc.
@@ -101,10 +105,7 @@ namespace frik
         }
 
         if (g_config.hideHeadEquipment) {
-            _isEquipmentCulled = true;
-            for (const auto slot : g_config.hideEquipSlotIndexes()) {
-                setEquipmentSlotByIndexVisibility(slot, true);
-            }
+            cullEquipment();
         } else {
             restoreEquipment();
         }
@@ -129,16 +130,32 @@ namespace frik
         }
     }
 
+    /// <summary>
+    /// Hide the equipment slots only when the equipped items or their loaded 3D changed (equip/unequip/3D load).
+    /// Periodic verification re-applies the hiding in case the game shows the same node again (can be disabled in config).
+    /// </summary>
+    void CullGeometryHandler::cullEquipment()
+    {
+        const auto& slotIds = g_config.hideEquipSlotIndexes();
+        if (!_equipmentTracker.update(f4vr::getPlayer()->equipData->slots, slotIds, nowMillis(), g_config.hideHeadEquipmentVerifyInterval)) {
+            return;
+        }
+
+        for (const auto slot : slotIds) {
+            setEquipmentSlotByIndexVisibility(slot, true);
+        }
+    }
+
     /// <summary>
     /// Show all player geometries and equipment slots.
     /// </summary>
     void CullGeometryHandler::restoreEquipment()
     {
-        if (!_isEquipmentCulled) {
+        if (!_equipmentTracker.isApplied()) {
             // no need to restore anything
             return;
         }
-        _isEquipmentCulled = false;
+        _equipmentTracker.reset();
 
         setEquipmentSlotByIndexVisibility(0, false);
         setEquipmentSlotByIndexVisibility(1, false);
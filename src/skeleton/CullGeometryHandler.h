@@ -2,6 +2,9 @@
 
 #include <vector>
 
+#include "EquipmentSlotsTracker.h"
+#include "GeometryNameMatcher.h"
+
 namespace frik
 {
     class CullGeometryHandler
@@ -12,16 +15,25 @@ namespace frik
     private:
         void restoreGeometry();
         void restoreEquipment();
+        void cullEquipment();
         void preProcessHideGeometryIndexes(RE::BSFadeNode* rn);
+        static uint64_t getGeometriesFingerprint(const RE::BSFadeNode* rn);
         static void setEquipmentSlotByIndexVisibility(int slotId, bool toHide);
 
         // used to handle update to hide flags to know to restore culled geometries
         bool _isGeometryCulled = false;
-        bool _isEquipmentCulled = false;
 
-        time_t _lastPreProcessTime = 0;
-        int _lastHiddenGeometryIdx = -1;
-        std::string _lastHiddenGeometryName;
+        // fingerprint of the geometries array and hide flags the hide indexes were calculated for
+        uint64_t _lastGeometriesFingerprint = 0;
         std::vector<std::uint32_t> _hideFaceSkinGeometryIndexes;
+
+        // equipped items/3D in the hidden slots the equipment was culled for
+        EquipmentSlotsTracker _equipmentTracker;
+
+        // face and skin hide patterns compiled for matching geometry names
+        GeometryNameMatcher _faceMatcher;
+        GeometryNameMatcher _skinMatcher;
+        // config hide meshes version the matchers were built for
+        std::uint32_t _matchersHideMeshesVersion = 0;
     };
 }
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+#include "AttachedNodeCache.h"
+
+namespace frik
+{
+    /**
+     * The skeleton nodes the frame update changes the local transform of, each the root of a subtree that needs world
+     * update before the next stage reads world data.
+     */
+    enum class DirtySubtree : uint8_t
+    {
+        Root = 0,
+        Head,
+        Spine,
+        LeftThigh,
+        RightThigh,
+        LeftShoulder,
+        RightShoulder,
+
+        Count
+    };
+
+    constexpr auto DIRTY_SUBTREES_COUNT = static_cast<std::size_t>(DirtySubtree::Count);
+
+    /**
+     * Dirty flags of the skeleton subtrees indexed by DirtySubtree, marking and flushing are bit operations.
+     * The ancestor subtrees of each subtree are resolved once on bind, so a dirty subtree under a dirty ancestor is
+     * skipped by a mask check instead of walking its parents.
+     * Counts the nodes world updated by the flushes for the per frame node updates number.
+     */
+    class DirtySubtrees
+    {
+    public:
+        using Nodes = std::array<RE::NiAVObject*, DIRTY_SUBTREES_COUNT>;
+        using NodesCounts = std::array<std::uint32_t, DIRTY_SUBTREES_COUNT>;
+
+        /**
+         * Bind the subtrees root nodes and the number of nodes in each subtree (for the node updates count only).
+         * Must be called again if the nodes are re-resolved.
+         */
+        void bind(const Nodes& nodes, const NodesCounts& nodesCounts)
+        {
+            _nodes = nodes;
+            _nodesCounts = nodesCounts;
+            for (std::size_t i = 0; i < DIRTY_SUBTREES_COUNT; i++) {
+                _ancestors[i].reset();
+                for (std::size_t j = 0; j < DIRTY_SUBTREES_COUNT; j++) {
+                    if (i != j && _nodes[i] && _nodes[j] && isAttachedUnder(_nodes[i]->parent, _nodes[j])) {
+                        _ancestors[i].set(j);
+                    }
+                }
+            }
+            _dirty.reset();
+        }
+
+        void markDirty(const DirtySubtree subtree) { _dirty.set(static_cast<std::size_t>(subtree)); }
+
+        bool isDirty(const DirtySubtree subtree) const { return _dirty.test(static_cast<std::size_t>(subtree)); }
+
+        /**
+         * Call "update(node)" for each dirty subtree root that has no dirty ancestor and clear the dirty flags.
+         */
+        template <typename Update>
+        void flush(Update&& update)
+        {
+            for (std::size_t i = 0; i < DIRTY_SUBTREES_COUNT; i++) {
+                if (_dirty.test(i) && _nodes[i] && (_ancestors[i] & _dirty).none()) {
+                    update(_nodes[i]);
+                    _nodeUpdates += _nodesCounts[i];
+                }
+            }
+            _dirty.reset();
+        }
+
+        /**
+         * Get the number of nodes world updated by flushes since the last call and reset it.
+         */
+        std::uint32_t takeNodeUpdates()
+        {
+            const auto nodeUpdates = _nodeUpdates;
+            _nodeUpdates = 0;
+            return nodeUpdates;
+        }
+
+    private:
+        Nodes _nodes{};
+        NodesCounts _nodesCounts{};
+        std::array<std::bitset<DIRTY_SUBTREES_COUNT>, DIRTY_SUBTREES_COUNT> _ancestors{};
+        std::bitset<DIRTY_SUBTREES_COUNT> _dirty;
+        std::uint32_t _nodeUpdates = 0;
+    };
+}
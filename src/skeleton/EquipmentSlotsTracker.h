@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace frik
+{
+    /**
+     * Track the equipped items and their loaded 3D in the hidden equipment slots to re-apply the hiding only when they
+     * change (equip/unequip/3D load), so in steady state it's a compare of a handful of pointers.
+     * Periodic verification re-applies the hiding in case the game shows the same node again.
+     * Templated on the slots container ("slots[id]" with "item" and "node") so it can be tested with fake slots off-target.
+     */
+    class EquipmentSlotsTracker
+    {
+    public:
+        /**
+         * Returns true if the hiding of the slots should be (re-)applied now.
+         * @param verifyInterval milliseconds between periodic re-apply, 0 to disable.
+         */
+        template <typename Slots>
+        bool update(const Slots& slots, const std::vector<int>& slotIds, const std::uint64_t now, const int verifyInterval)
+        {
+            _current.clear();
+            for (const auto slotId : slotIds) {
+                _current.push_back({ slotId, slots[slotId].item, slots[slotId].node });
+            }
+
+            const bool verify = verifyInterval > 0 && now - _lastApplyTime >= static_cast<std::uint64_t>(verifyInterval);
+            if (_applied && _current == _appliedSlots && !verify) {
+                return false;
+            }
+
+            _applied = true;
+            _appliedSlots.swap(_current);
+            _lastApplyTime = now;
+            return true;
+        }
+
+        bool isApplied() const { return _applied; }
+
+        /**
+         * Forget the applied state so the next update re-applies (after the hiding was restored).
+         */
+        void reset()
+        {
+            _applied = false;
+            _appliedSlots.clear();
+        }
+
+    private:
+        struct SlotState
+        {
+            int slotId;
+            const void* item;
+            const void* node;
+
+            bool operator==(const SlotState&) const = default;
+        };
+
+        bool _applied = false;
+        std::uint64_t _lastApplyTime = 0;
+        // slots state the hiding was applied for
+        std::vector<SlotState> _appliedSlots;
+        // reused buffer of the current slots state
+        std::vector<SlotState> _current;
+    };
+}
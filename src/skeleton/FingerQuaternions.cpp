@@ -0,0 +1,208 @@
+#include "FingerQuaternions.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FRIK_FINGER_QUATERNIONS_SSE2
+#endif
+
+namespace
+{
+    using frik::FingerQuaternions;
+
+    using Lanes = std::array<float, FingerQuaternions::LANES>;
+
+    void dotScalar(const FingerQuaternions& from, const FingerQuaternions& to, Lanes& dots)
+    {
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            dots[i] = from.x[i] * to.x[i] + from.y[i] * to.y[i] + from.z[i] * to.z[i] + from.w[i] * to.w[i];
+        }
+    }
+
+    /**
+     * Weighted sum of the lanes quaternions normalized to unit length.
+     */
+    void blendScalar(const FingerQuaternions& from, const FingerQuaternions& to, const Lanes& wFrom, const Lanes& wTo, FingerQuaternions& out)
+    {
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            const float rx = wFrom[i] * from.x[i] + wTo[i] * to.x[i];
+            const float ry = wFrom[i] * from.y[i] + wTo[i] * to.y[i];
+            const float rz = wFrom[i] * from.z[i] + wTo[i] * to.z[i];
+            const float rw = wFrom[i] * from.w[i] + wTo[i] * to.w[i];
+            const float invLen = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+            out.x[i] = rx * invLen;
+            out.y[i] = ry * invLen;
+            out.z[i] = rz * invLen;
+            out.w[i] = rw * invLen;
+        }
+    }
+
+#ifdef FRIK_FINGER_QUATERNIONS_SSE2
+    /**
+     * Same calculations as the scalar functions for 4 lanes at a time, same operations order so the results are identical.
+     */
+    void dotSimd(const FingerQuaternions& from, const FingerQuaternions& to, Lanes& dots)
+    {
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i += 4) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(&from.x[i]), _mm_load_ps(&to.x[i])),
+                _mm_mul_ps(_mm_load_ps(&from.y[i]), _mm_load_ps(&to.y[i]))), _mm_mul_ps(_mm_load_ps(&from.z[i]), _mm_load_ps(&to.z[i]))),
+                _mm_mul_ps(_mm_load_ps(&from.w[i]), _mm_load_ps(&to.w[i])));
+            _mm_storeu_ps(&dots[i], dot);
+        }
+    }
+
+    __m128 blendLane(const float* from, const float* to, const __m128 wFrom, const __m128 wTo)
+    {
+        return _mm_add_ps(_mm_mul_ps(wFrom, _mm_load_ps(from)), _mm_mul_ps(wTo, _mm_load_ps(to)));
+    }
+
+    void blendSimd(const FingerQuaternions& from, const FingerQuaternions& to, const Lanes& wFrom, const Lanes& wTo, FingerQuaternions& out)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i += 4) {
+            const __m128 wf = _mm_loadu_ps(&wFrom[i]);
+            const __m128 wt = _mm_loadu_ps(&wTo[i]);
+            const __m128 rx = blendLane(&from.x[i], &to.x[i], wf, wt);
+            const __m128 ry = blendLane(&from.y[i], &to.y[i], wf, wt);
+            const __m128 rz = blendLane(&from.z[i], &to.z[i], wf, wt);
+            const __m128 rw = blendLane(&from.w[i], &to.w[i], wf, wt);
+            const __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz)), _mm_mul_ps(rw, rw));
+            // exact sqrt and division, not the approximate rsqrt, to match the scalar path
+            const __m128 invLen = _mm_div_ps(one, _mm_sqrt_ps(lenSq));
+            _mm_store_ps(&out.x[i], _mm_mul_ps(rx, invLen));
+            _mm_store_ps(&out.y[i], _mm_mul_ps(ry, invLen));
+            _mm_store_ps(&out.z[i], _mm_mul_ps(rz, invLen));
+            _mm_store_ps(&out.w[i], _mm_mul_ps(rw, invLen));
+        }
+    }
+#endif
+}
+
+namespace frik
+{
+    /**
+     * Set the lane quaternion from the given rotation matrix.
+     */
+    void FingerQuaternions::set(const std::size_t lane, const RE::NiMatrix3& rot)
+    {
+        const auto& m = rot.entry;
+        const float trace = m[0][0] + m[1][1] + m[2][2];
+        float qx, qy, qz, qw;
+        if (trace > 0) {
+            const float s = 0.5f / std::sqrt(trace + 1.0f);
+            qw = 0.25f / s;
+            qx = (m[2][1] - m[1][2]) * s;
+            qy = (m[0][2] - m[2][0]) * s;
+            qz = (m[1][0] - m[0][1]) * s;
+        } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+            const float s = 2.0f * std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]);
+            qw = (m[2][1] - m[1][2]) / s;
+            qx = 0.25f * s;
+            qy = (m[0][1] + m[1][0]) / s;
+            qz = (m[0][2] + m[2][0]) / s;
+        } else if (m[1][1] > m[2][2]) {
+            const float s = 2.0f * std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]);
+            qw = (m[0][2] - m[2][0]) / s;
+            qx = (m[0][1] + m[1][0]) / s;
+            qy = 0.25f * s;
+            qz = (m[1][2] + m[2][1]) / s;
+        } else {
+            const float s = 2.0f * std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]);
+            qw = (m[1][0] - m[0][1]) / s;
+            qx = (m[0][2] + m[2][0]) / s;
+            qy = (m[1][2] + m[2][1]) / s;
+            qz = 0.25f * s;
+        }
+        x[lane] = qx;
+        y[lane] = qy;
+        z[lane] = qz;
+        w[lane] = qw;
+    }
+
+    void FingerQuaternions::copyLane(const std::size_t lane, const FingerQuaternions& other)
+    {
+        x[lane] = other.x[lane];
+        y[lane] = other.y[lane];
+        z[lane] = other.z[lane];
+        w[lane] = other.w[lane];
+    }
+
+    /**
+     * Get the lane quaternion as rotation matrix (same convention as "set").
+     */
+    RE::NiMatrix3 FingerQuaternions::getMatrix(const std::size_t lane) const
+    {
+        const float qx = x[lane];
+        const float qy = y[lane];
+        const float qz = z[lane];
+        const float qw = w[lane];
+
+        RE::NiMatrix3 rot;
+        rot.entry[0][0] = 1 - 2 * (qy * qy + qz * qz);
+        rot.entry[0][1] = 2 * (qx * qy - qz * qw);
+        rot.entry[0][2] = 2 * (qx * qz + qy * qw);
+        rot.entry[1][0] = 2 * (qx * qy + qz * qw);
+        rot.entry[1][1] = 1 - 2 * (qx * qx + qz * qz);
+        rot.entry[1][2] = 2 * (qy * qz - qx * qw);
+        rot.entry[2][0] = 2 * (qx * qz - qy * qw);
+        rot.entry[2][1] = 2 * (qy * qz + qx * qw);
+        rot.entry[2][2] = 1 - 2 * (qx * qx + qy * qy);
+        return rot;
+    }
+
+    bool isSlerpFingersSimdAvailable()
+    {
+#ifdef FRIK_FINGER_QUATERNIONS_SSE2
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Spherical interpolation of all lanes from "from" to "to" by the lane weight "t" (supports extrapolation outside [0,1]).
+     * Takes the shortest path and falls back to normalized linear interpolation when the quaternions are nearly equal.
+     * The dot products and the weighted sum with normalization run 4 lanes at a time with SSE2 (if "simd" and available),
+     * the slerp weights need acos/sin that SSE2 doesn't have so they stay scalar per lane. Both paths give identical results.
+     */
+    void slerpFingers(const FingerQuaternions& from, const FingerQuaternions& to, const FingerQuaternions::Weights& t, FingerQuaternions& out,
+        [[maybe_unused]] const bool simd)
+    {
+        alignas(16) Lanes dots;
+#ifdef FRIK_FINGER_QUATERNIONS_SSE2
+        if (simd) {
+            dotSimd(from, to, dots);
+        } else {
+            dotScalar(from, to, dots);
+        }
+#else
+        dotScalar(from, to, dots);
+#endif
+
+        alignas(16) Lanes wFrom;
+        alignas(16) Lanes wTo;
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            const float sign = dots[i] < 0 ? -1.0f : 1.0f;
+            const float dot = std::fabs(dots[i]);
+
+            wFrom[i] = 1.0f - t[i];
+            wTo[i] = t[i];
+            if (dot < 0.9995f) {
+                const float theta = std::acos(dot);
+                const float invSin = 1.0f / std::sin(theta);
+                wFrom[i] = std::sin(wFrom[i] * theta) * invSin;
+                wTo[i] = std::sin(wTo[i] * theta) * invSin;
+            }
+            wTo[i] *= sign;
+        }
+
+#ifdef FRIK_FINGER_QUATERNIONS_SSE2
+        if (simd) {
+            blendSimd(from, to, wFrom, wTo, out);
+            return;
+        }
+#endif
+        blendScalar(from, to, wFrom, wTo, out);
+    }
+}
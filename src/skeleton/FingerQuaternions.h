@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+
+namespace frik
+{
+    /**
+     * Rotations of all the finger bones of a single hand as quaternions in SoA layout (x[], y[], z[], w[]).
+     * Used to blend all the fingers of a hand in a single batched call instead of converting every finger pose
+     * matrix to quaternion and back every frame.
+     * Arrays are padded to 16 lanes (15 fingers) so the blend loop has no tail handling.
+     */
+    struct FingerQuaternions
+    {
+        static constexpr std::size_t LANES = 16;
+        using Weights = std::array<float, LANES>;
+
+        FingerQuaternions() { w.fill(1.0f); }
+
+        void set(std::size_t lane, const RE::NiMatrix3& rot);
+        void copyLane(std::size_t lane, const FingerQuaternions& other);
+        RE::NiMatrix3 getMatrix(std::size_t lane) const;
+
+        alignas(16) std::array<float, LANES> x{};
+        alignas(16) std::array<float, LANES> y{};
+        alignas(16) std::array<float, LANES> z{};
+        alignas(16) std::array<float, LANES> w{};
+    };
+
+    /**
+     * True if slerpFingers has a SIMD path in this build.
+     */
+    bool isSlerpFingersSimdAvailable();
+
+    void slerpFingers(const FingerQuaternions& from, const FingerQuaternions& to, const FingerQuaternions::Weights& t, FingerQuaternions& out,
+        bool simd = true);
+}
@@ -0,0 +1,157 @@
+#include "FrameCapture.h"
+
+#include <filesystem>
+
+#include "Config.h"
+#include "f4vr/F4VRUtils.h"
+
+namespace frik
+{
+    FrameCapture g_frameCapture;
+
+    /**
+     * Handle start/stop of recording and replay requested by "sDebugDumpDataOnceNames" INI flag.
+     */
+    void FrameCapture::checkDebugCommands(const std::string& path)
+    {
+        if (g_config.checkDebugDumpDataOnceFor("frame_capture")) {
+            if (isRecording()) {
+                stopRecording();
+            } else {
+                startRecording(path);
+            }
+        }
+        if (g_config.checkDebugDumpDataOnceFor("frame_replay")) {
+            startReplay(path);
+        }
+    }
+
+    void FrameCapture::startRecording(const std::string& path)
+    {
+        if (isActive()) {
+            logger::warn("Frame capture already active, can't start recording");
+            return;
+        }
+
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+        _recordStream.open(path, std::ios::binary | std::ios::trunc);
+        if (!_recordStream.is_open()) {
+            logger::warn("Failed to open frame capture file for writing: '{}'", path);
+            return;
+        }
+
+        writeCaptureHeader(_recordStream);
+        _recordedFramesCount = 0;
+        logger::info("Frame capture recording started: '{}'", path);
+    }
+
+    void FrameCapture::stopRecording()
+    {
+        if (!isRecording()) {
+            return;
+        }
+        _recordStream.close();
+        logger::info("Frame capture recording stopped, {} frames recorded", _recordedFramesCount);
+    }
+
+    /**
+     * Load all the frames of the capture file and start feeding them into the skeleton from the next frame.
+     */
+    void FrameCapture::startReplay(const std::string& path)
+    {
+        if (isActive()) {
+            logger::warn("Frame capture already active, can't start replay");
+            return;
+        }
+
+        auto frames = readCaptureFile(path);
+        if (!frames.has_value()) {
+            return;
+        }
+
+        const auto& config = frames->front().input.config;
+        if (config.inPowerArmor != f4vr::isInPowerArmor() || config.leftHandedMode != f4vr::isLeftHandedMode()) {
+            logger::warn("Frame capture was recorded with different power armor/left-handed state, results will differ");
+        }
+
+        _replay.emplace(std::move(frames.value()));
+        logger::info("Frame capture replay started: '{}', {} frames", path, _replay->getFramesCount());
+    }
+
+    void FrameCapture::stopReplay()
+    {
+        logger::info("Frame capture replay finished, {} frames; max bone diff: translate={:.4f}, rotate={:.5f} (frame {})",
+            _replay->getFramesCount(), _replay->getMaxTranslateDiff(), _replay->getMaxRotateDiff(), _replay->getWorstFrame());
+        _replay.reset();
+    }
+
+    /**
+     * Set the frame clock fixed step to the recorded frame time while replaying, must be called before the clock tick.
+     */
+    void FrameCapture::onFrameClockTick(FrameClock& frameClock)
+    {
+        if (isReplaying()) {
+            frameClock.setFixedStep(_replay->getFrame().frameTime);
+            _replayClockOverride = true;
+        } else if (_replayClockOverride) {
+            frameClock.setFixedStep(0);
+            _replayClockOverride = false;
+        }
+    }
+
+    /**
+     * Called at the start of the skeleton frame update with the live frame input before any skeleton calculation.
+     * Recording: capture the tracking nodes and the input. Replay: apply the recorded tracking nodes and replace the input.
+     */
+    void FrameCapture::onSkeletonFrameStart(const f4vr::PlayerNodes* playerNodes, const float frameTime, SkeletonFrameInput& input)
+    {
+        if (isReplaying()) {
+            applyReplayInputs(playerNodes, _replay->getFrame());
+            input = _replay->getFrame().input;
+        } else if (isRecording()) {
+            captureInputs(playerNodes, frameTime, input);
+        }
+    }
+
+    /**
+     * Called at the end of the skeleton frame update with the resulting bones transforms.
+     * Recording: write the complete frame to the stream. Replay: compare to recorded output and move to the next frame.
+     */
+    void FrameCapture::onSkeletonFrameEnd(const CapturedOutputBones& outputBones)
+    {
+        if (isReplaying()) {
+            _replay->compareAndAdvance(outputBones);
+            if (_replay->isDone()) {
+                stopReplay();
+            }
+        } else if (isRecording()) {
+            _recordFrame.outputBones = outputBones;
+            writeCapturedFrame(_recordStream, _recordFrame);
+            _recordedFramesCount++;
+        }
+    }
+
+    void FrameCapture::captureInputs(const f4vr::PlayerNodes* playerNodes, const float frameTime, const SkeletonFrameInput& input)
+    {
+        _recordFrame.frameTime = frameTime;
+        _recordFrame.hmdLocal = playerNodes->HmdNode->local;
+        _recordFrame.hmdWorld = playerNodes->HmdNode->world;
+        _recordFrame.uprightHmdLocal = playerNodes->UprightHmdNode->local;
+        _recordFrame.uprightHmdWorld = playerNodes->UprightHmdNode->world;
+        _recordFrame.primaryWandWorld = playerNodes->primaryWandNode->world;
+        _recordFrame.secondaryWandWorld = playerNodes->SecondaryWandNode->world;
+        _recordFrame.cameraPosition = f4vr::getPlayerCamera()->cameraNode->world.translate;
+        _recordFrame.input = input;
+    }
+
+    void FrameCapture::applyReplayInputs(const f4vr::PlayerNodes* playerNodes, const CapturedFrame& frame)
+    {
+        playerNodes->HmdNode->local = frame.hmdLocal;
+        playerNodes->HmdNode->world = frame.hmdWorld;
+        playerNodes->UprightHmdNode->local = frame.uprightHmdLocal;
+        playerNodes->UprightHmdNode->world = frame.uprightHmdWorld;
+        playerNodes->primaryWandNode->world = frame.primaryWandWorld;
+        playerNodes->SecondaryWandNode->world = frame.secondaryWandWorld;
+        f4vr::getPlayerCamera()->cameraNode->world.translate = frame.cameraPosition;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "FrameCaptureFile.h"
+#include "FrameClock.h"
+#include "f4vr/PlayerNodes.h"
+
+namespace frik
+{
+    /**
+     * Record per-frame tracking input and skeleton output into a compact binary stream and replay it back into the skeleton.
+     * Replay overrides the HMD, wands and camera nodes world transforms and the frame clock (fixed-step with the recorded
+     * frame time) right before the skeleton frame update so the replay runs the exact same Skeleton::onFrameUpdate stage
+     * order as the real frame. The recorded config values and controllers state replace the skeleton frame input, the live
+     * config is never changed so aborting a replay or saving config during replay is safe.
+     * The replay output bones are compared to the recorded ones and the max difference is logged when the replay ends.
+     * The stream format is in FrameCaptureFile so it can be replayed off-target by the host replay harness (see tests).
+     * Start/stop recording using "frame_capture" and start replay using "frame_replay" in "sDebugDumpDataOnceNames" INI flag.
+     */
+    class FrameCapture
+    {
+    public:
+        bool isActive() const { return isRecording() || isReplaying(); }
+        bool isRecording() const { return _recordStream.is_open(); }
+        bool isReplaying() const { return _replay.has_value() && !_replay->isDone(); }
+
+        void checkDebugCommands(const std::string& path);
+        void startRecording(const std::string& path);
+        void stopRecording();
+        void startReplay(const std::string& path);
+
+        void onFrameClockTick(FrameClock& frameClock);
+        void onSkeletonFrameStart(const f4vr::PlayerNodes* playerNodes, float frameTime, SkeletonFrameInput& input);
+        void onSkeletonFrameEnd(const CapturedOutputBones& outputBones);
+
+    private:
+        void stopReplay();
+        void captureInputs(const f4vr::PlayerNodes* playerNodes, float frameTime, const SkeletonFrameInput& input);
+        static void applyReplayInputs(const f4vr::PlayerNodes* playerNodes, const CapturedFrame& frame);
+
+        // recording
+        std::ofstream _recordStream;
+        CapturedFrame _recordFrame{};
+        std::size_t _recordedFramesCount = 0;
+
+        // replay
+        std::optional<FrameReplaySession> _replay;
+        bool _replayClockOverride = false;
+    };
+
+    extern FrameCapture g_frameCapture;
+}
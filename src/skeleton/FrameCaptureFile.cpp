@@ -0,0 +1,81 @@
+#include "FrameCaptureFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace
+{
+    constexpr uint32_t CAPTURE_MAGIC = 0x434B5246; // "FRKC"
+    constexpr uint32_t CAPTURE_VERSION = 3;
+
+    struct CaptureHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t frameSize;
+    };
+}
+
+namespace frik
+{
+    bool writeCaptureHeader(std::ostream& stream)
+    {
+        const CaptureHeader header{ CAPTURE_MAGIC, CAPTURE_VERSION, sizeof(CapturedFrame) };
+        return static_cast<bool>(stream.write(reinterpret_cast<const char*>(&header), sizeof(header)));
+    }
+
+    void writeCapturedFrame(std::ostream& stream, const CapturedFrame& frame)
+    {
+        stream.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+    }
+
+    /**
+     * Read all the frames of a capture file, empty if the file is missing, of a different version, or has no frames.
+     */
+    std::optional<std::vector<CapturedFrame>> readCaptureFile(const std::string& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        CaptureHeader header{};
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION || header.frameSize != sizeof(CapturedFrame)) {
+            logger::warn("Invalid or missing frame capture file: '{}'", path);
+            return std::nullopt;
+        }
+
+        std::vector<CapturedFrame> frames;
+        CapturedFrame frame{};
+        while (stream.read(reinterpret_cast<char*>(&frame), sizeof(frame))) {
+            frames.push_back(frame);
+        }
+        if (frames.empty()) {
+            logger::warn("Frame capture file has no frames: '{}'", path);
+            return std::nullopt;
+        }
+        return frames;
+    }
+
+    /**
+     * Compare the replayed output bones of the current frame to the recorded ones and move to the next frame.
+     */
+    void FrameReplaySession::compareAndAdvance(const CapturedOutputBones& outputBones)
+    {
+        const auto& recorded = _frames[_index].outputBones;
+        for (std::size_t i = 0; i < CAPTURED_OUTPUT_BONES_COUNT; i++) {
+            const auto translate = outputBones[i].translate - recorded[i].translate;
+            const float translateDiff = std::sqrt(translate.x * translate.x + translate.y * translate.y + translate.z * translate.z);
+            float rotateDiff = 0;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    rotateDiff = (std::max)(rotateDiff, std::abs(outputBones[i].rotate.entry[r][c] - recorded[i].rotate.entry[r][c]));
+                }
+            }
+            if (translateDiff > _maxTranslateDiff || rotateDiff > _maxRotateDiff) {
+                _worstFrame = _index;
+            }
+            _maxTranslateDiff = (std::max)(_maxTranslateDiff, translateDiff);
+            _maxRotateDiff = (std::max)(_maxRotateDiff, rotateDiff);
+        }
+        _index++;
+    }
+}
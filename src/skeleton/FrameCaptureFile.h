@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "SkeletonBones.h"
+#include "SkeletonFrameInput.h"
+
+namespace frik
+{
+    /**
+     * Number of output bone transforms stored per frame: the skeleton bones table, upper arm, forearm, hand of each arm,
+     * and the fingers of both hands.
+     */
+    constexpr std::size_t CAPTURED_OUTPUT_BONES_COUNT = SKELETON_BONES_COUNT + 6 + FINGER_BONES_COUNT;
+    constexpr std::size_t CAPTURED_OUTPUT_FINGERS_START = SKELETON_BONES_COUNT + 6;
+    using CapturedOutputBones = std::array<RE::NiTransform, CAPTURED_OUTPUT_BONES_COUNT>;
+
+    /**
+     * A single frame in the capture stream, fixed size so the stream can be read without parsing.
+     * Inputs are everything Skeleton::onFrameUpdate reads from the game, outputs are the resulting bones local transforms.
+     * Only plain floats and integers so a capture recorded in game can be read by the host replay harness.
+     */
+    struct CapturedFrame
+    {
+        float frameTime;
+        RE::NiTransform hmdLocal;
+        RE::NiTransform hmdWorld;
+        RE::NiTransform uprightHmdLocal;
+        RE::NiTransform uprightHmdWorld;
+        RE::NiTransform primaryWandWorld;
+        RE::NiTransform secondaryWandWorld;
+        RE::NiPoint3 cameraPosition;
+        SkeletonFrameInput input;
+        CapturedOutputBones outputBones;
+    };
+
+    static_assert(std::is_trivially_copyable_v<CapturedFrame>);
+    static_assert(sizeof(RE::NiTransform) == 64, "capture stream layout must be the same in game and host");
+
+    bool writeCaptureHeader(std::ostream& stream);
+    void writeCapturedFrame(std::ostream& stream, const CapturedFrame& frame);
+    std::optional<std::vector<CapturedFrame>> readCaptureFile(const std::string& path);
+
+    /**
+     * Replay of captured frames that compares the replayed output bones to the recorded ones.
+     * Keeps the max translate/rotate difference and the frame it happened in for the regression report.
+     */
+    class FrameReplaySession
+    {
+    public:
+        explicit FrameReplaySession(std::vector<CapturedFrame> frames) :
+            _frames(std::move(frames)) {}
+
+        bool isDone() const { return _index >= _frames.size(); }
+        std::size_t getFramesCount() const { return _frames.size(); }
+        std::size_t getFrameIndex() const { return _index; }
+        const CapturedFrame& getFrame() const { return _frames[_index]; }
+
+        void compareAndAdvance(const CapturedOutputBones& outputBones);
+
+        float getMaxTranslateDiff() const { return _maxTranslateDiff; }
+        float getMaxRotateDiff() const { return _maxRotateDiff; }
+        std::size_t getWorstFrame() const { return _worstFrame; }
+
+    private:
+        std::vector<CapturedFrame> _frames;
+        std::size_t _index = 0;
+        float _maxTranslateDiff = 0;
+        float _maxRotateDiff = 0;
+        std::size_t _worstFrame = 0;
+    };
+}
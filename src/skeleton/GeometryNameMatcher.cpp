@@ -0,0 +1,111 @@
+#include "GeometryNameMatcher.h"
+
+#include <cctype>
+#include <queue>
+
+namespace
+{
+    uint8_t toLowerByte(const char c)
+    {
+        return static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    uint8_t toUpperByte(const uint8_t c)
+    {
+        return static_cast<uint8_t>(std::toupper(c));
+    }
+}
+
+namespace frik
+{
+    /**
+     * Compile the patterns into the automaton, empty patterns are ignored.
+     */
+    void GeometryNameMatcher::build(const std::vector<std::string>& patterns)
+    {
+        _alphabet.fill(0);
+        _alphabetSize = 1;
+        for (const auto& pattern : patterns) {
+            for (const auto c : pattern) {
+                const auto lower = toLowerByte(c);
+                if (_alphabet[lower] == 0) {
+                    // both cases map to the same symbol so matching doesn't need to lower-case the text
+                    _alphabet[lower] = static_cast<uint8_t>(_alphabetSize++);
+                    _alphabet[toUpperByte(lower)] = _alphabet[lower];
+                }
+            }
+        }
+
+        // build the trie, -1 for missing transition
+        _transitions.clear();
+        _terminal.clear();
+        addState();
+        for (const auto& pattern : patterns) {
+            if (pattern.empty()) {
+                continue;
+            }
+            int state = 0;
+            for (const auto c : pattern) {
+                const auto idx = state * _alphabetSize + _alphabet[toLowerByte(c)];
+                if (_transitions[idx] < 0) {
+                    const auto next = addState();
+                    _transitions[idx] = next;
+                }
+                state = _transitions[idx];
+            }
+            _terminal[state] = true;
+        }
+
+        // resolve fail links breadth-first into full DFA transitions
+        std::vector<int> fail(_terminal.size(), 0);
+        std::queue<int> queue;
+        for (std::size_t symbol = 0; symbol < _alphabetSize; symbol++) {
+            auto& next = _transitions[symbol];
+            if (next < 0) {
+                next = 0;
+            } else {
+                queue.push(next);
+            }
+        }
+        while (!queue.empty()) {
+            const auto state = queue.front();
+            queue.pop();
+            _terminal[state] = _terminal[state] || _terminal[fail[state]];
+            for (std::size_t symbol = 0; symbol < _alphabetSize; symbol++) {
+                auto& next = _transitions[state * _alphabetSize + symbol];
+                const auto failNext = _transitions[fail[state] * _alphabetSize + symbol];
+                if (next < 0) {
+                    next = failNext;
+                } else {
+                    fail[next] = failNext;
+                    queue.push(next);
+                }
+            }
+        }
+    }
+
+    /**
+     * Check if the text contains any of the patterns (case-insensitive).
+     */
+    bool GeometryNameMatcher::containsAny(const std::string_view text) const
+    {
+        if (_transitions.empty()) {
+            return false;
+        }
+        int state = 0;
+        for (const auto c : text) {
+            state = _transitions[state * _alphabetSize + _alphabet[static_cast<uint8_t>(c)]];
+            if (_terminal[state]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int GeometryNameMatcher::addState()
+    {
+        _transitions.resize(_transitions.size() + _alphabetSize, -1);
+        _terminal.push_back(false);
+        return static_cast<int>(_terminal.size() - 1);
+    }
+}
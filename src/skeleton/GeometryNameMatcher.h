@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace frik
+{
+    /**
+     * Case-insensitive multi-pattern substring matcher (Aho-Corasick automaton).
+     * Patterns are compiled once into a DFA so matching a name against all the patterns is a single pass over the name
+     * characters, instead of a substring search per pattern.
+     */
+    class GeometryNameMatcher
+    {
+    public:
+        void build(const std::vector<std::string>& patterns);
+
+        bool containsAny(std::string_view text) const;
+
+    private:
+        int addState();
+
+        // map of byte (either case) to dense alphabet index, 0 for bytes not in any pattern
+        std::array<uint8_t, 256> _alphabet{};
+        std::size_t _alphabetSize = 1;
+
+        // DFA transitions: state * alphabet size + symbol -> next state
+        std::vector<int> _transitions;
+        // state matches a pattern (directly or by fail link)
+        std::vector<bool> _terminal;
+    };
+}
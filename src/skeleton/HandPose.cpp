@@ -1,32 +1,23 @@
 #include "HandPose.h"
-#include <map>
+#include <cctype>
 #include <numbers>
-#include <string>
 #include "Config.h"
+#include "common/MatrixUtils.h"
 
 using namespace common;
 
 // TODO: this code is terrible, primary it doesn't handle multiple code paths set hand pose, release will release all of them
 namespace frik
 {
-    constexpr int FINGERS_COUNT = 15;
+    FingerBonesTransforms handClosed;
+    FingerBonesTransforms handOpen;
 
-    static const std::string LEFT_HAND_FINGERS[] = {
-        "LArm_Finger11", "LArm_Finger12", "LArm_Finger13", "LArm_Finger21", "LArm_Finger22", "LArm_Finger23", "LArm_Finger31", "LArm_Finger32", "LArm_Finger33", "LArm_Finger41",
-        "LArm_Finger42", "LArm_Finger43", "LArm_Finger51", "LArm_Finger52", "LArm_Finger53"
-    };
-    static const std::string RIGHT_HAND_FINGERS[] = {
-        "RArm_Finger11", "RArm_Finger12", "RArm_Finger13", "RArm_Finger21", "RArm_Finger22", "RArm_Finger23", "RArm_Finger31", "RArm_Finger32", "RArm_Finger33", "RArm_Finger41",
-        "RArm_Finger42", "RArm_Finger43", "RArm_Finger51", "RArm_Finger52", "RArm_Finger53"
-    };
+    std::array<FingerQuaternions, 2> handClosedQuats;
+    std::array<FingerQuaternions, 2> handOpenQuats;
+    std::array<FingerQuaternions, 2> handThumbUpQuats;
 
-    std::map<std::string, RE::NiTransform, CaseInsensitiveComparator> handClosed;
-    std::map<std::string, RE::NiTransform, CaseInsensitiveComparator> handOpen;
-
-    std::map<std::string, int> boneToIndexMap;
-
-    std::map<std::string, float> handPapyrusPose;
-    std::map<std::string, bool> handPapyrusHasControl;
+    std::array<float, FINGER_BONES_COUNT> handPapyrusPose{};
+    std::array<bool, FINGER_BONES_COUNT> handPapyrusHasControl{};
 
     static constexpr float HAND_FINGERS_HOLDING_GUN_POSE[] = { 0.7f, 0.4f, 0.5f, 0.9f, 0.6f, 0.5f, 0.3f, 0.5f, 0.5f, 0.1f, 0.5f, 0.5f, 0.0f, 0.5f, 0.7f };
     static constexpr float HAND_FINGERS_HOLDING_MELEE_POSE[] = { 0.7f, 0.5f, 0.8f, 0.4f, 0.3f, 0.9f, 0.1f, 0.5f, 0.9f, 0.0f, 0.5f, 0.9f, 0.0f, 0.4f, 0.9f };
@@ -37,69 +28,72 @@ namespace frik
     static constexpr float OFFHAND_FINGERS_GRIP_POSE[] = { 1.0f, 1.0f, 0.9f, 0.6f, 0.6f, 0.6f, 0.5f, 0.6f, 0.55f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f };
 
     /**
-     * Get the pose value for the given bone either for melee or gun holding hand pose.
+     * Find the finger bone index by the skeleton bone name (case-insensitive).
+     * Used only where bone names come from outside (scene graph, API), the frame update uses indexes directly.
+     */
+    std::optional<std::size_t> findFingerBoneIndex(const std::string_view boneName)
+    {
+        const auto equalsIgnoreCase = [](const std::string_view a, const std::string_view b) {
+            return a.size() == b.size() && std::ranges::equal(a, b, [](const char c1, const char c2) {
+                return std::tolower(static_cast<unsigned char>(c1)) == std::tolower(static_cast<unsigned char>(c2));
+            });
+        };
+        for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+            if (equalsIgnoreCase(boneName, FINGER_BONE_NAMES[i])) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Get the pose value for the given finger bone either for melee or gun holding hand pose.
      */
-    float getHandBonePose(const std::string& bone, const bool melee)
+    float getHandBonePose(const std::size_t boneIdx, const bool melee)
     {
         const auto handPose = melee ? HAND_FINGERS_HOLDING_MELEE_POSE : HAND_FINGERS_HOLDING_GUN_POSE;
-        return handPose[boneToIndexMap[bone]];
+        return handPose[static_cast<std::size_t>(getFingerOfBoneIndex(boneIdx))];
     }
 
-    static void copyDataIntoHand(const std::vector<float>& fingerData, std::map<std::string, RE::NiTransform, CaseInsensitiveComparator>& hand, const char* finger)
+    static void copyDataIntoHand(const std::vector<std::vector<float>>& data, FingerBonesTransforms& hand)
     {
-        for (int row = 0; row < 3; row++) {
-            for (int col = 0; col < 4; col++) {
-                hand[finger].rotate.entry[row][col] = fingerData[row * 4 + col];
+        // Left hand fingers followed by right hand fingers, same order as finger bone indexes
+        for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+            for (int row = 0; row < 3; row++) {
+                for (int col = 0; col < 4; col++) {
+                    hand[i].rotate.entry[row][col] = data[i][row * 4 + col];
+                }
             }
         }
     }
 
-    static void copyDataIntoHand(std::vector<std::vector<float>> data, std::map<std::string, RE::NiTransform, CaseInsensitiveComparator>& hand)
+    /**
+     * Pre-calculate the constant hand poses as quaternions so hand pose blending doesn't convert them every frame.
+     */
+    static void initHandPosesQuaternions()
     {
-        // Left hand fingers
-        copyDataIntoHand(data[0], hand, "LArm_Finger11");
-        copyDataIntoHand(data[1], hand, "LArm_Finger12");
-        copyDataIntoHand(data[2], hand, "LArm_Finger13");
-        copyDataIntoHand(data[3], hand, "LArm_Finger21");
-        copyDataIntoHand(data[4], hand, "LArm_Finger22");
-        copyDataIntoHand(data[5], hand, "LArm_Finger23");
-        copyDataIntoHand(data[6], hand, "LArm_Finger31");
-        copyDataIntoHand(data[7], hand, "LArm_Finger32");
-        copyDataIntoHand(data[8], hand, "LArm_Finger33");
-        copyDataIntoHand(data[9], hand, "LArm_Finger41");
-        copyDataIntoHand(data[10], hand, "LArm_Finger42");
-        copyDataIntoHand(data[11], hand, "LArm_Finger43");
-        copyDataIntoHand(data[12], hand, "LArm_Finger51");
-        copyDataIntoHand(data[13], hand, "LArm_Finger52");
-        copyDataIntoHand(data[14], hand, "LArm_Finger53");
+        for (const bool isLeft : { true, false }) {
+            const auto hand = isLeft ? 0 : 1;
+            for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                const auto boneIdx = getFingerBoneIndex(isLeft, static_cast<Finger>(i));
+                handClosedQuats[hand].set(i, handClosed[boneIdx].rotate);
+                handOpenQuats[hand].set(i, handOpen[boneIdx].rotate);
+            }
 
-        // Right hand fingers
-        copyDataIntoHand(data[15], hand, "RArm_Finger11");
-        copyDataIntoHand(data[16], hand, "RArm_Finger12");
-        copyDataIntoHand(data[17], hand, "RArm_Finger13");
-        copyDataIntoHand(data[18], hand, "RArm_Finger21");
-        copyDataIntoHand(data[19], hand, "RArm_Finger22");
-        copyDataIntoHand(data[20], hand, "RArm_Finger23");
-        copyDataIntoHand(data[21], hand, "RArm_Finger31");
-        copyDataIntoHand(data[22], hand, "RArm_Finger32");
-        copyDataIntoHand(data[23], hand, "RArm_Finger33");
-        copyDataIntoHand(data[24], hand, "RArm_Finger41");
-        copyDataIntoHand(data[25], hand, "RArm_Finger42");
-        copyDataIntoHand(data[26], hand, "RArm_Finger43");
-        copyDataIntoHand(data[27], hand, "RArm_Finger51");
-        copyDataIntoHand(data[28], hand, "RArm_Finger52");
-        copyDataIntoHand(data[29], hand, "RArm_Finger53");
+            // thumb up pose: rotated open thumb (middle thumb bone uses identity rotation)
+            const float sign = isLeft ? -1.0f : 1.0f;
+            const auto thumb1 = getFingerBoneIndex(isLeft, Finger::Thumb1);
+            const auto thumb3 = getFingerBoneIndex(isLeft, Finger::Thumb3);
+            handThumbUpQuats[hand] = FingerQuaternions();
+            handThumbUpQuats[hand].set(static_cast<std::size_t>(Finger::Thumb1),
+                MatrixUtils::getMatrixFromEulerAngles(sign * 0.5f, sign * 0.4f, -0.3f) * handOpen[thumb1].rotate);
+            handThumbUpQuats[hand].set(static_cast<std::size_t>(Finger::Thumb3),
+                MatrixUtils::getMatrixFromEulerAngles(0, 0, MatrixUtils::degreesToRads(-35.0f)) * handOpen[thumb3].rotate);
+        }
     }
 
     void initHandPoses(const bool inPowerArmor)
     {
-        if (boneToIndexMap.empty()) {
-            for (auto i = 0; i < FINGERS_COUNT; i++) {
-                boneToIndexMap[LEFT_HAND_FINGERS[i]] = i;
-                boneToIndexMap[RIGHT_HAND_FINGERS[i]] = i;
-            }
-        }
-
         std::vector<std::vector<float>> data;
 
         // pulled from the game engine while running idle animations
@@ -174,118 +168,87 @@ namespace frik
         copyDataIntoHand(data, handOpen);
 
         if (inPowerArmor) {
-            handOpen["LArm_Finger11"].translate = RE::NiPoint3(3.993323F, -4.156268F, 3.585619F);
-            handOpen["LArm_Finger12"].translate = RE::NiPoint3(2.893830F, 0.000042F, 0.000004F);
-            handOpen["LArm_Finger13"].translate = RE::NiPoint3(4.687409F, 0, 0);
-            handOpen["LArm_Finger21"].translate = RE::NiPoint3(8.474635F, -2.161191F, 3.789806F);
-            handOpen["LArm_Finger22"].translate = RE::NiPoint3(2.613208F, 0.000026F, 0.000011F);
-            handOpen["LArm_Finger23"].translate = RE::NiPoint3(5.145684F, 0, 0);
-            handOpen["LArm_Finger31"].translate = RE::NiPoint3(8.151892F, -2.576661F, 1.100114F);
-            handOpen["LArm_Finger32"].translate = RE::NiPoint3(3.722714F, 0.000021F, -0.000004F);
-            handOpen["LArm_Finger33"].translate = RE::NiPoint3(4.984375F, 0, 0);
-            handOpen["LArm_Finger41"].translate = RE::NiPoint3(7.967844F, -2.258833F, -1.337387F);
-            handOpen["LArm_Finger42"].translate = RE::NiPoint3(2.933939F, 0.000027F, 0.000004F);
-            handOpen["LArm_Finger43"].translate = RE::NiPoint3(5.102559F, 0, 0);
-            handOpen["LArm_Finger51"].translate = RE::NiPoint3(8.365221F, -2.603350F, -3.706458F);
-            handOpen["LArm_Finger52"].translate = RE::NiPoint3(2.128304F, 0.000018F, 0.000003F);
-            handOpen["LArm_Finger53"].translate = RE::NiPoint3(4.594295F, 0, 0);
-            handOpen["RArm_Finger11"].translate = RE::NiPoint3(3.993090F, -4.156340F, -3.585553F);
-            handOpen["RArm_Finger12"].translate = RE::NiPoint3(2.893783F, 0.000042F, 0.000004F);
-            handOpen["RArm_Finger13"].translate = RE::NiPoint3(4.686954F, 0, 0);
-            handOpen["RArm_Finger21"].translate = RE::NiPoint3(8.474229F, -2.161169F, -3.789712F);
-            handOpen["RArm_Finger22"].translate = RE::NiPoint3(2.613165F, 0.000026F, 0.000011F);
-            handOpen["RArm_Finger23"].translate = RE::NiPoint3(5.145271F, 0, 0);
-            handOpen["RArm_Finger31"].translate = RE::NiPoint3(8.151529F, -2.576689F, -1.100008F);
-            handOpen["RArm_Finger32"].translate = RE::NiPoint3(3.722677F, 0.000021F, -0.000004F);
-            handOpen["RArm_Finger33"].translate = RE::NiPoint3(4.973974F, 0, 0);
-            handOpen["RArm_Finger41"].translate = RE::NiPoint3(7.967505F, -2.258873F, 1.337498F);
-            handOpen["RArm_Finger42"].translate = RE::NiPoint3(2.933841F, 0.000027F, 0.000004F);
-            handOpen["RArm_Finger43"].translate = RE::NiPoint3(5.102017F, 0, 0);
-            handOpen["RArm_Finger51"].translate = RE::NiPoint3(8.364894F, -2.603419F, 3.706582F);
-            handOpen["RArm_Finger52"].translate = RE::NiPoint3(2.128275F, 0.000018F, 0.000003F);
-            handOpen["RArm_Finger53"].translate = RE::NiPoint3(4.593989F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb1)].translate = RE::NiPoint3(3.993323F, -4.156268F, 3.585619F);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb2)].translate = RE::NiPoint3(2.893830F, 0.000042F, 0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb3)].translate = RE::NiPoint3(4.687409F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Index1)].translate = RE::NiPoint3(8.474635F, -2.161191F, 3.789806F);
+            handOpen[getFingerBoneIndex(true, Finger::Index2)].translate = RE::NiPoint3(2.613208F, 0.000026F, 0.000011F);
+            handOpen[getFingerBoneIndex(true, Finger::Index3)].translate = RE::NiPoint3(5.145684F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Middle1)].translate = RE::NiPoint3(8.151892F, -2.576661F, 1.100114F);
+            handOpen[getFingerBoneIndex(true, Finger::Middle2)].translate = RE::NiPoint3(3.722714F, 0.000021F, -0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Middle3)].translate = RE::NiPoint3(4.984375F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Ring1)].translate = RE::NiPoint3(7.967844F, -2.258833F, -1.337387F);
+            handOpen[getFingerBoneIndex(true, Finger::Ring2)].translate = RE::NiPoint3(2.933939F, 0.000027F, 0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Ring3)].translate = RE::NiPoint3(5.102559F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky1)].translate = RE::NiPoint3(8.365221F, -2.603350F, -3.706458F);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky2)].translate = RE::NiPoint3(2.128304F, 0.000018F, 0.000003F);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky3)].translate = RE::NiPoint3(4.594295F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb1)].translate = RE::NiPoint3(3.993090F, -4.156340F, -3.585553F);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb2)].translate = RE::NiPoint3(2.893783F, 0.000042F, 0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb3)].translate = RE::NiPoint3(4.686954F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Index1)].translate = RE::NiPoint3(8.474229F, -2.161169F, -3.789712F);
+            handOpen[getFingerBoneIndex(false, Finger::Index2)].translate = RE::NiPoint3(2.613165F, 0.000026F, 0.000011F);
+            handOpen[getFingerBoneIndex(false, Finger::Index3)].translate = RE::NiPoint3(5.145271F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Middle1)].translate = RE::NiPoint3(8.151529F, -2.576689F, -1.100008F);
+            handOpen[getFingerBoneIndex(false, Finger::Middle2)].translate = RE::NiPoint3(3.722677F, 0.000021F, -0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Middle3)].translate = RE::NiPoint3(4.973974F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Ring1)].translate = RE::NiPoint3(7.967505F, -2.258873F, 1.337498F);
+            handOpen[getFingerBoneIndex(false, Finger::Ring2)].translate = RE::NiPoint3(2.933841F, 0.000027F, 0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Ring3)].translate = RE::NiPoint3(5.102017F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky1)].translate = RE::NiPoint3(8.364894F, -2.603419F, 3.706582F);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky2)].translate = RE::NiPoint3(2.128275F, 0.000018F, 0.000003F);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky3)].translate = RE::NiPoint3(4.593989F, 0, 0);
         } else {
-            handOpen["LArm_Finger11"].translate = RE::NiPoint3(1.582972F, -1.262648F, 1.853201F);
-            handOpen["LArm_Finger12"].translate = RE::NiPoint3(3.569515F, 0.000042F, 0.000004F);
-            handOpen["LArm_Finger13"].translate = RE::NiPoint3(2.401824F, 0, 0);
-            handOpen["LArm_Finger21"].translate = RE::NiPoint3(7.501364F, 0.430291F, 2.277657F);
-            handOpen["LArm_Finger22"].translate = RE::NiPoint3(3.018186F, 0.000026F, 0.000011F);
-            handOpen["LArm_Finger23"].translate = RE::NiPoint3(1.850236F, 0, 0);
-            handOpen["LArm_Finger31"].translate = RE::NiPoint3(7.595781F, 0.62098F, 0.457392F);
-            handOpen["LArm_Finger32"].translate = RE::NiPoint3(3.091653F, 0.000021F, -0.000004F);
-            handOpen["LArm_Finger33"].translate = RE::NiPoint3(2.187974F, 0, 0);
-            handOpen["LArm_Finger41"].translate = RE::NiPoint3(7.464033F, 0.350152F, -1.438817F);
-            handOpen["LArm_Finger42"].translate = RE::NiPoint3(2.664419F, 0.000027F, 0.000004F);
-            handOpen["LArm_Finger43"].translate = RE::NiPoint3(1.89974F, 0, 0);
-            handOpen["LArm_Finger51"].translate = RE::NiPoint3(6.637259F, -0.35742F, -3.01848F);
-            handOpen["LArm_Finger52"].translate = RE::NiPoint3(2.238261F, 0.000018F, 0.000003F);
-            handOpen["LArm_Finger53"].translate = RE::NiPoint3(1.665912F, 0, 0);
-            handOpen["RArm_Finger11"].translate = RE::NiPoint3(1.582972F, -1.262648F, -1.853201F);
-            handOpen["RArm_Finger12"].translate = RE::NiPoint3(3.569515F, 0.000042F, 0.000004F);
-            handOpen["RArm_Finger13"].translate = RE::NiPoint3(2.401824F, 0, 0);
-            handOpen["RArm_Finger21"].translate = RE::NiPoint3(7.501364F, 0.430291F, -2.277657F);
-            handOpen["RArm_Finger22"].translate = RE::NiPoint3(3.018186F, 0.000026F, 0.000011F);
-            handOpen["RArm_Finger23"].translate = RE::NiPoint3(1.850236F, 0, 0);
-            handOpen["RArm_Finger31"].translate = RE::NiPoint3(7.595781F, 0.62098F, -0.457392F);
-            handOpen["RArm_Finger32"].translate = RE::NiPoint3(3.091653F, 0.000021F, -0.000004F);
-            handOpen["RArm_Finger33"].translate = RE::NiPoint3(2.187974F, 0, 0);
-            handOpen["RArm_Finger41"].translate = RE::NiPoint3(7.464033F, 0.350152F, 1.438817F);
-            handOpen["RArm_Finger42"].translate = RE::NiPoint3(2.664419F, 0.000027F, 0.000004F);
-            handOpen["RArm_Finger43"].translate = RE::NiPoint3(1.89974F, 0, 0);
-            handOpen["RArm_Finger51"].translate = RE::NiPoint3(6.637259F, -0.35742F, 3.01848F);
-            handOpen["RArm_Finger52"].translate = RE::NiPoint3(2.238261F, 0.000018F, 0.000003F);
-            handOpen["RArm_Finger53"].translate = RE::NiPoint3(1.665912F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb1)].translate = RE::NiPoint3(1.582972F, -1.262648F, 1.853201F);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb2)].translate = RE::NiPoint3(3.569515F, 0.000042F, 0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Thumb3)].translate = RE::NiPoint3(2.401824F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Index1)].translate = RE::NiPoint3(7.501364F, 0.430291F, 2.277657F);
+            handOpen[getFingerBoneIndex(true, Finger::Index2)].translate = RE::NiPoint3(3.018186F, 0.000026F, 0.000011F);
+            handOpen[getFingerBoneIndex(true, Finger::Index3)].translate = RE::NiPoint3(1.850236F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Middle1)].translate = RE::NiPoint3(7.595781F, 0.62098F, 0.457392F);
+            handOpen[getFingerBoneIndex(true, Finger::Middle2)].translate = RE::NiPoint3(3.091653F, 0.000021F, -0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Middle3)].translate = RE::NiPoint3(2.187974F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Ring1)].translate = RE::NiPoint3(7.464033F, 0.350152F, -1.438817F);
+            handOpen[getFingerBoneIndex(true, Finger::Ring2)].translate = RE::NiPoint3(2.664419F, 0.000027F, 0.000004F);
+            handOpen[getFingerBoneIndex(true, Finger::Ring3)].translate = RE::NiPoint3(1.89974F, 0, 0);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky1)].translate = RE::NiPoint3(6.637259F, -0.35742F, -3.01848F);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky2)].translate = RE::NiPoint3(2.238261F, 0.000018F, 0.000003F);
+            handOpen[getFingerBoneIndex(true, Finger::Pinky3)].translate = RE::NiPoint3(1.665912F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb1)].translate = RE::NiPoint3(1.582972F, -1.262648F, -1.853201F);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb2)].translate = RE::NiPoint3(3.569515F, 0.000042F, 0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Thumb3)].translate = RE::NiPoint3(2.401824F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Index1)].translate = RE::NiPoint3(7.501364F, 0.430291F, -2.277657F);
+            handOpen[getFingerBoneIndex(false, Finger::Index2)].translate = RE::NiPoint3(3.018186F, 0.000026F, 0.000011F);
+            handOpen[getFingerBoneIndex(false, Finger::Index3)].translate = RE::NiPoint3(1.850236F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Middle1)].translate = RE::NiPoint3(7.595781F, 0.62098F, -0.457392F);
+            handOpen[getFingerBoneIndex(false, Finger::Middle2)].translate = RE::NiPoint3(3.091653F, 0.000021F, -0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Middle3)].translate = RE::NiPoint3(2.187974F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Ring1)].translate = RE::NiPoint3(7.464033F, 0.350152F, 1.438817F);
+            handOpen[getFingerBoneIndex(false, Finger::Ring2)].translate = RE::NiPoint3(2.664419F, 0.000027F, 0.000004F);
+            handOpen[getFingerBoneIndex(false, Finger::Ring3)].translate = RE::NiPoint3(1.89974F, 0, 0);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky1)].translate = RE::NiPoint3(6.637259F, -0.35742F, 3.01848F);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky2)].translate = RE::NiPoint3(2.238261F, 0.000018F, 0.000003F);
+            handOpen[getFingerBoneIndex(false, Finger::Pinky3)].translate = RE::NiPoint3(1.665912F, 0, 0);
         }
+
+        initHandPosesQuaternions();
     }
 
     void setFingerPositionScalar(const bool isLeft, const float thumb, const float index, const float middle, const float ring, const float pinky)
     {
-        const auto* const fingersArray = isLeft ? LEFT_HAND_FINGERS : RIGHT_HAND_FINGERS;
-        for (auto i = 0; i < FINGERS_COUNT; i++) {
-            handPapyrusHasControl[fingersArray[i]] = true;
-        }
-
-        if (isLeft) {
-            handPapyrusPose["LArm_Finger11"] = thumb;
-            handPapyrusPose["LArm_Finger12"] = thumb;
-            handPapyrusPose["LArm_Finger13"] = thumb;
-            handPapyrusPose["LArm_Finger21"] = index;
-            handPapyrusPose["LArm_Finger22"] = index;
-            handPapyrusPose["LArm_Finger23"] = index;
-            handPapyrusPose["LArm_Finger31"] = middle;
-            handPapyrusPose["LArm_Finger32"] = middle;
-            handPapyrusPose["LArm_Finger33"] = middle;
-            handPapyrusPose["LArm_Finger41"] = ring;
-            handPapyrusPose["LArm_Finger42"] = ring;
-            handPapyrusPose["LArm_Finger43"] = ring;
-            handPapyrusPose["LArm_Finger51"] = pinky;
-            handPapyrusPose["LArm_Finger52"] = pinky;
-            handPapyrusPose["LArm_Finger53"] = pinky;
-        } else {
-            handPapyrusPose["RArm_Finger11"] = thumb;
-            handPapyrusPose["RArm_Finger12"] = thumb;
-            handPapyrusPose["RArm_Finger13"] = thumb;
-            handPapyrusPose["RArm_Finger21"] = index;
-            handPapyrusPose["RArm_Finger22"] = index;
-            handPapyrusPose["RArm_Finger23"] = index;
-            handPapyrusPose["RArm_Finger31"] = middle;
-            handPapyrusPose["RArm_Finger32"] = middle;
-            handPapyrusPose["RArm_Finger33"] = middle;
-            handPapyrusPose["RArm_Finger41"] = ring;
-            handPapyrusPose["RArm_Finger42"] = ring;
-            handPapyrusPose["RArm_Finger43"] = ring;
-            handPapyrusPose["RArm_Finger51"] = pinky;
-            handPapyrusPose["RArm_Finger52"] = pinky;
-            handPapyrusPose["RArm_Finger53"] = pinky;
+        const std::array<float, 5> fingersPose = { thumb, index, middle, ring, pinky };
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            const auto boneIdx = getFingerBoneIndex(isLeft, static_cast<Finger>(i));
+            handPapyrusHasControl[boneIdx] = true;
+            handPapyrusPose[boneIdx] = fingersPose[i / 3];
         }
     }
 
     void restoreFingerPoseControl(const bool isLeft)
     {
         logger::debug("Hand pose: Restore control for {} hand", isLeft ? "Left" : "Right");
-        const auto* const fingersArray = isLeft ? LEFT_HAND_FINGERS : RIGHT_HAND_FINGERS;
-        for (auto i = 0; i < FINGERS_COUNT; i++) {
-            handPapyrusHasControl[fingersArray[i]] = false;
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            handPapyrusHasControl[getFingerBoneIndex(isLeft, static_cast<Finger>(i))] = false;
         }
     }
 
@@ -338,11 +301,10 @@ namespace frik
         }
         logger::debug("Hand pose: Set force hand pose for '{}' hand: {})", rightHand ? "Right" : "Left", override ? "Set" : "Release");
         _handPoseSet[rightHand] = override;
-        const auto* const fingers = rightHand ? RIGHT_HAND_FINGERS : LEFT_HAND_FINGERS;
-        for (auto i = 0; i < FINGERS_COUNT; i++) {
-            const std::string finger = fingers[i];
-            handPapyrusHasControl[finger.c_str()] = override;
-            handPapyrusPose[finger.c_str()] = handPose[i];
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            const auto boneIdx = getFingerBoneIndex(!rightHand, static_cast<Finger>(i));
+            handPapyrusHasControl[boneIdx] = override;
+            handPapyrusPose[boneIdx] = handPose[i];
         }
     }
 }
@@ -1,18 +1,31 @@
 #pragma once
 
+#include <optional>
+#include <string_view>
+
+#include "FingerQuaternions.h"
 #include "Skeleton.h"
 
 namespace frik
 {
-    extern std::map<std::string, RE::NiTransform, common::CaseInsensitiveComparator> handClosed;
-    extern std::map<std::string, RE::NiTransform, common::CaseInsensitiveComparator> handOpen;
+    std::optional<std::size_t> findFingerBoneIndex(std::string_view boneName);
+
+    using FingerBonesTransforms = std::array<RE::NiTransform, FINGER_BONES_COUNT>;
+
+    extern FingerBonesTransforms handClosed;
+    extern FingerBonesTransforms handOpen;
+
+    // the constant hand poses as quaternions per hand (0 - left, 1 - right) for batched fingers blending
+    extern std::array<FingerQuaternions, 2> handClosedQuats;
+    extern std::array<FingerQuaternions, 2> handOpenQuats;
+    extern std::array<FingerQuaternions, 2> handThumbUpQuats;
 
-    extern std::map<std::string, float> handPapyrusPose;
-    extern std::map<std::string, bool> handPapyrusHasControl;
+    extern std::array<float, FINGER_BONES_COUNT> handPapyrusPose;
+    extern std::array<bool, FINGER_BONES_COUNT> handPapyrusHasControl;
 
     void initHandPoses(bool inPowerArmor);
 
-    float getHandBonePose(const std::string& bone, const bool melee);
+    float getHandBonePose(std::size_t boneIdx, bool melee);
 
     void setFingerPositionScalar(bool isLeft, float thumb, float index, float middle, float ring, float pinky);
     void restoreFingerPoseControl(bool isLeft);
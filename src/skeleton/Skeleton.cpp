@@ -4,7 +4,10 @@
 
 #include "Config.h"
 #include "FRIK.h"
+#include "FrameCapture.h"
+#include "FrameProfiler.h"
 #include "HandPose.h"
+#include "TwoBoneIK.h"
 #include "common/MatrixUtils.h"
 #include "common/Quaternion.h"
 #include "f4vr/BSFlattenedBoneTree.h"
@@ -23,9 +26,60 @@ namespace
      * By setting static body pitch the body position doesn't change, making it easier to handle skeleton
      * related things like Virtual Holsters.
      */
-    bool isComfortSneakHackEnabled()
+    bool isComfortSneakHackEnabled(const frik::SkeletonFrameConfig& config)
     {
-        return frik::g_config.comfortSneakHackStaticBodyPitchAngle > 0 && isComfortSneakMode() && isPlayerSneaking();
+        return config.comfortSneakHackStaticBodyPitchAngle > 0 && isComfortSneakMode() && isPlayerSneaking();
+    }
+
+    /**
+     * The openvr button that closes each finger of a hand (index by finger).
+     */
+    constexpr std::array<VRButtonId, frik::FINGERS_COUNT> FINGERS_BUTTON = {
+        k_EButton_SteamVR_Touchpad, k_EButton_SteamVR_Touchpad, k_EButton_SteamVR_Touchpad,
+        k_EButton_SteamVR_Trigger, k_EButton_SteamVR_Trigger, k_EButton_SteamVR_Trigger,
+        k_EButton_Grip, k_EButton_Grip, k_EButton_Grip,
+        k_EButton_Grip, k_EButton_Grip, k_EButton_Grip,
+        k_EButton_Grip, k_EButton_Grip, k_EButton_Grip
+    };
+
+    frik::IKVec3 toIKVec3(const RE::NiPoint3& point)
+    {
+        return { point.x, point.y, point.z };
+    }
+
+    RE::NiPoint3 toNiPoint3(const frik::IKVec3& vec)
+    {
+        return { vec.x, vec.y, vec.z };
+    }
+
+    /**
+     * Count the nodes in the node subtree including the node itself.
+     */
+    std::uint32_t countSubtreeNodes(RE::NiAVObject* node)
+    {
+        std::uint32_t count = 1;
+        if (const auto niNode = node->IsNode()) {
+            for (const auto& child : niNode->children) {
+                if (child) {
+                    count += countSubtreeNodes(child.get());
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Get the bone local rotation that aims the bone axis toward the given direction.
+     * The direction is in world space and transformed into the bone space by the bone world rotation.
+     */
+    RE::NiMatrix3 aimBoneLocalRotation(const RE::NiMatrix3& boneWorldRotate, const RE::NiPoint3& worldDir, const RE::NiPoint3& boneAxis, const RE::NiMatrix3& boneLocalRotate)
+    {
+        return MatrixUtils::getMatrixFromRotateVectorVec(boneWorldRotate * worldDir, boneAxis) * boneLocalRotate;
+    }
+
+    VRButtonId getFingerButton(const std::size_t boneIdx)
+    {
+        return FINGERS_BUTTON[static_cast<std::size_t>(frik::getFingerOfBoneIndex(boneIdx))];
     }
 }
 
@@ -42,7 +96,12 @@ namespace frik
      */
     float Skeleton::getAdjustedPlayerHMDOffset()
     {
-        auto offset = g_config.getPlayerHMDOffsetUp() + g_frik.getDynamicCameraHeight();
+        return getAdjustedPlayerHMDOffset(g_config.getPlayerHMDOffsetUp());
+    }
+
+    float Skeleton::getAdjustedPlayerHMDOffset(const float playerHMDOffsetUp)
+    {
+        auto offset = playerHMDOffsetUp + g_frik.getDynamicCameraHeight();
         if (isComfortSneakMode() && isPlayerSneaking()) {
             offset *= COMFORT_SNEAK_CAMERA_OFFSET_ADJUSTMENT;
         }
@@ -55,9 +114,6 @@ namespace frik
      */
     void Skeleton::initializeNodes()
     {
-        QueryPerformanceFrequency(&_freqCounter);
-        QueryPerformanceCounter(&_timer);
-
         _prevSpeed = 0.0;
 
         _playerNodes = getPlayerNodes();
@@ -77,10 +133,19 @@ namespace frik
 
         initSkeletonNodesDefaults();
 
+        bindSkeletonBones();
+
         _handBones = handOpen;
+        for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+            _handBonesQuats[isLeftHandFingerBoneIndex(i) ? 0 : 1].set(static_cast<std::size_t>(getFingerOfBoneIndex(i)), _handBones[i].rotate);
+        }
 
         Skelly::initBoneTreeMap();
 
+        initHandBonesTreePositions();
+
+        initBoneKinematics();
+
         setBodyLen();
 
         initHandPoses(_inPowerArmor);
@@ -129,14 +194,125 @@ namespace frik
         }
     }
 
+    /**
+     * Resolve the skeleton bones used in frame update by name once, so frame update can use indexed access.
+     * Only skeleton bones are resolved, armor nodes (Power Armor pauldrons) come and go with equipped items so they are
+     * cached separately and verified on use (see AttachedNodeCache).
+     */
+    void Skeleton::bindSkeletonBones()
+    {
+        for (std::size_t i = 0; i < SKELETON_BONES_COUNT; i++) {
+            _bones[i] = findNode(_root, SKELETON_BONE_NAMES[i]);
+            if (!_bones[i]) {
+                logger::warn("Skeleton bone node not found for '{}'", SKELETON_BONE_NAMES[i]);
+            }
+        }
+        _bonesBoundRoot = _root;
+        bindDirtySubtrees();
+    }
+
+    /**
+     * Bind the nodes the frame update marks dirty (see DirtySubtree) and count their subtrees for the node updates count.
+     */
+    void Skeleton::bindDirtySubtrees()
+    {
+        const DirtySubtrees::Nodes nodes = {
+            _root, _head, _spine, getBone(SkeletonBone::LeftThigh), getBone(SkeletonBone::RightThigh), _leftArm.shoulder, _rightArm.shoulder
+        };
+        DirtySubtrees::NodesCounts nodesCounts{};
+        for (std::size_t i = 0; i < DIRTY_SUBTREES_COUNT; i++) {
+            nodesCounts[i] = nodes[i] ? countSubtreeNodes(nodes[i]) : 0;
+        }
+        _dirtySubtrees.bind(nodes, nodesCounts);
+    }
+
+    /**
+     * Cheap check that the resolved bones are still attached to the root they were resolved from.
+     * Rebind if the root changed or a bone was detached.
+     */
+    void Skeleton::validateSkeletonBones()
+    {
+        const auto com = getBone(SkeletonBone::COM);
+        if (_bonesBoundRoot != _root || !com || !com->parent) {
+            logger::info("Skeleton bones are no longer valid, rebind...");
+            bindSkeletonBones();
+        }
+    }
+
+    /**
+     * Resolve the flattened bone tree positions that hand pose update needs to touch so frame update doesn't have to
+     * go over the whole tree and compare bone names.
+     * The flattened tree is ordered parent-before-child so a single pass finds finger bones descendants and keeps the order.
+     */
+    void Skeleton::initHandBonesTreePositions()
+    {
+        _handBonesTreePositions.clear();
+
+        const auto rt = reinterpret_cast<BSFlattenedBoneTree*>(_root);
+        std::vector<bool> inHandSubtree(rt->numTransforms, false);
+        std::vector<bool> isFingerParent(rt->numTransforms, false);
+        std::vector<int> fingerBoneIndexes(rt->numTransforms, -1);
+
+        for (auto pos = 0; pos < rt->numTransforms; pos++) {
+            const std::string name = Skelly::getBoneName(pos);
+            const auto parent = rt->transforms[pos].parPos;
+            if (const auto fingerBoneIdx = findFingerBoneIndex(name)) {
+                fingerBoneIndexes[pos] = static_cast<int>(fingerBoneIdx.value());
+                inHandSubtree[pos] = true;
+                if (parent >= 0 && !inHandSubtree[parent]) {
+                    // hand bone world is used to calculate the fingers world
+                    isFingerParent[parent] = true;
+                }
+            } else if (parent >= 0 && inHandSubtree[parent]) {
+                inHandSubtree[pos] = true;
+            }
+        }
+
+        std::vector<int> noRefNodePositions;
+        for (auto pos = 0; pos < rt->numTransforms; pos++) {
+            if (inHandSubtree[pos] || isFingerParent[pos]) {
+                _handBonesTreePositions.push_back({ pos, fingerBoneIndexes[pos] });
+                if (!rt->transforms[pos].refNode) {
+                    noRefNodePositions.push_back(pos);
+                }
+            }
+        }
+        _handBonesTreeKernel.build(rt, noRefNodePositions);
+
+        logger::info("Hand bones tree positions resolved: {} of {} bone tree entries ({} without node)", _handBonesTreePositions.size(), rt->numTransforms,
+            _handBonesTreeKernel.size());
+    }
+
+    /**
+     * Register the bones tracked for motion detection and resolve their bone tree positions once.
+     */
+    void Skeleton::initBoneKinematics()
+    {
+        _boneKinematics.clear();
+        _cameraKinematics = _boneKinematics.addTrack();
+
+        const auto rt = reinterpret_cast<BSFlattenedBoneTree*>(_root);
+        for (const bool isLeft : { true, false }) {
+            _handKinematics[isLeft ? 0 : 1] = _boneKinematics.addTrack();
+            _handKinematicsTreePositions[isLeft ? 0 : 1] = rt->GetBoneIndex(FINGER_BONE_NAMES[getFingerBoneIndex(isLeft, Finger::Middle1)]);
+        }
+    }
+
     void Skeleton::setBodyLen()
     {
-        _torsoLen = MatrixUtils::vec3Len(findNode(_root, "Camera")->world.translate - findNode(_root, "COM")->world.translate);
+        const auto camera = getBone(SkeletonBone::Camera);
+        const auto com = getBone(SkeletonBone::COM);
+        const auto pelvis = getBone(SkeletonBone::Pelvis);
+        const auto thigh = getBone(SkeletonBone::LeftThigh);
+        const auto calf = getBone(SkeletonBone::LeftCalf);
+        const auto foot = getBone(SkeletonBone::LeftFoot);
+
+        _torsoLen = MatrixUtils::vec3Len(camera->world.translate - com->world.translate);
         _torsoLen *= g_config.playerHeight / DEFAULT_CAMERA_HEIGHT;
 
-        _legLen = MatrixUtils::vec3Len(findNode(_root, "LLeg_Thigh")->world.translate - findNode(_root, "Pelvis")->world.translate);
-        _legLen += MatrixUtils::vec3Len(findNode(_root, "LLeg_Calf")->world.translate - findNode(_root, "LLeg_Thigh")->world.translate);
-        _legLen += MatrixUtils::vec3Len(findNode(_root, "LLeg_Foot")->world.translate - findNode(_root, "LLeg_Calf")->world.translate);
+        _legLen = MatrixUtils::vec3Len(thigh->world.translate - pelvis->world.translate);
+        _legLen += MatrixUtils::vec3Len(calf->world.translate - thigh->world.translate);
+        _legLen += MatrixUtils::vec3Len(foot->world.translate - calf->world.translate);
         _legLen *= g_config.playerHeight / DEFAULT_CAMERA_HEIGHT;
     }
 
@@ -145,88 +321,214 @@ namespace frik
      */
     void Skeleton::onFrameUpdate()
     {
-        setTime();
+        validateSkeletonBones();
+
+        _frameInput = readFrameInput();
+        if (g_frameCapture.isActive()) {
+            g_frameCapture.onSkeletonFrameStart(_playerNodes, _frameClock.getFrameTime(), _frameInput);
+        }
 
         // save last position at this time for anyone doing speed calculations
         _lastPosition = _curentPosition;
         _curentPosition = getCameraPosition();
 
-        logger::trace("Hide Wands...");
-        setWandsVisibility(false, true);
-        setWandsVisibility(false, false);
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonRestore);
+            logger::trace("Hide Wands...");
+            setWandsVisibility(false, true);
+            setWandsVisibility(false, false);
 
-        logger::trace("Restore locals of skeleton");
-        restoreNodesToDefault();
-        updateDownFromRoot();
+            logger::trace("Restore locals of skeleton");
+            restoreNodesToDefault();
+            // no world update here, nothing reads skeleton world data before the body is set under the HMD
+        }
 
         const float neckYaw = getNeckYaw();
         const float neckPitch = getNeckPitch();
 
-        if (!g_config.hideHead || (g_frik.isSelfieModeOn() && g_config.selfieIgnoreHideFlags)) {
-            logger::trace("Setup Head");
-            setupHead(neckYaw, neckPitch);
-        }
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonBody);
+            if (!_frameInput.config.hideHead || (g_frik.isSelfieModeOn() && _frameInput.config.selfieIgnoreHideFlags)) {
+                logger::trace("Setup Head");
+                setupHead(neckYaw, neckPitch);
+            }
 
-        logger::trace("Set body under HMD");
-        setBodyUnderHMD(neckYaw, neckPitch);
-        updateDownFromRoot(); // Do world update now so that IK calculations have proper world reference
+            logger::trace("Set body under HMD");
+            setBodyUnderHMD(neckYaw, neckPitch);
+            flushDirtyNodes(); // Do world update now so that IK calculations have proper world reference
 
-        // Now Set up body Posture and hook up the legs
-        logger::trace("Set body posture...");
-        setBodyPosture(neckPitch);
-        updateDownFromRoot(); // Do world update now so that IK calculations have proper world reference
+            // Now Set up body Posture and hook up the legs
+            logger::trace("Set body posture...");
+            setBodyPosture(neckPitch);
+            flushDirtyNodes(); // Do world update now so that IK calculations have proper world reference
+        }
 
-        logger::trace("Set knee posture...");
-        setKneePos();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonLegs);
+            logger::trace("Set knee posture...");
+            setKneePos();
 
-        logger::trace("Set walk...");
-        walk();
+            logger::trace("Set walk...");
+            walk();
 
-        logger::trace("Set legs...");
-        setSingleLeg(false);
-        setSingleLeg(true);
+            logger::trace("Set legs...");
+            setSingleLeg(false);
+            setSingleLeg(true);
 
-        // Do another update before setting arms
-        updateDownFromRoot(); // Do world update now so that IK calculations have proper world reference
+            // Do another update before setting arms (only spine and legs changed)
+            flushDirtyNodes(); // Do world update now so that IK calculations have proper world reference
+        }
 
-        // do arm IK - Right then Left
-        logger::trace("Set Arms...");
-        handleLeftHandedWeaponNodesSwitch();
-        setArms(false);
-        setArms(true);
-        updateDownFromRoot(); // Do world update now so that IK calculations have proper world reference
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonArms);
+            // do arm IK - Right then Left
+            logger::trace("Set Arms...");
+            handleLeftHandedWeaponNodesSwitch();
+            setArms(false);
+            setArms(true);
+            flushDirtyNodes(); // Do world update now so that IK calculations have proper world reference
+            logger::trace("Skeleton world updated nodes: {}", _dirtySubtrees.takeNodeUpdates());
+        }
 
-        // Misc stuff to show/hide things
-        logger::trace("Pipboy and Weapons...");
-        hide3rdPersonWeapon();
-        hideFistHelpers();
-        showHidePAHud();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonMisc);
+            // Misc stuff to show/hide things
+            logger::trace("Pipboy and Weapons...");
+            hide3rdPersonWeapon();
+            hideFistHelpers();
+            showHidePAHud();
+        }
 
-        logger::trace("Cull geometry...");
-        _cullGeometry.cullPlayerGeometry();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonCullGeometry);
+            logger::trace("Cull geometry...");
+            _cullGeometry.cullPlayerGeometry();
+        }
 
-        // project body out in front of the camera for debug purposes
-        logger::trace("Selfie Time");
-        _selfieHandler.onFrameUpdate();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonSelfie);
+            // project body out in front of the camera for debug purposes
+            logger::trace("Selfie Time");
+            _selfieHandler.onFrameUpdate();
+        }
 
-        logger::trace("Operate hands...");
-        setHandPose();
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::SkeletonHands);
+            logger::trace("Operate hands...");
+            setHandPose();
 
-        if (g_frik.isInScopeMenu()) {
-            hideHands();
+            if (g_frik.isInScopeMenu()) {
+                hideHands();
+            }
         }
 
         if (_inPowerArmor) {
             fixArmor();
         }
+
+        sampleBoneKinematics();
+
+        if (g_frameCapture.isActive()) {
+            g_frameCapture.onSkeletonFrameEnd(getCaptureOutputBones());
+        }
     }
 
-    void Skeleton::setTime()
+    /**
+     * Sample the tracked bones positions after the skeleton and hands are fully updated for the frame.
+     */
+    void Skeleton::sampleBoneKinematics()
     {
-        _prevTime = _timer;
-        QueryPerformanceFrequency(&_freqCounter);
-        QueryPerformanceCounter(&_timer);
-        _frameTime = static_cast<float>(_timer.QuadPart - _prevTime.QuadPart) / _freqCounter.QuadPart;
+        const auto frameTime = _frameClock.getFrameTime();
+        _boneKinematics.push(_cameraKinematics, _curentPosition, frameTime);
+
+        const auto rt = reinterpret_cast<BSFlattenedBoneTree*>(_root);
+        for (std::size_t i = 0; i < _handKinematics.size(); i++) {
+            if (_handKinematicsTreePositions[i] >= 0) {
+                _boneKinematics.push(_handKinematics[i], rt->transforms[_handKinematicsTreePositions[i]].world.translate, frameTime);
+            }
+        }
+    }
+
+    /**
+     * Read the config values and the controllers state the skeleton frame update depends on.
+     * The active profile is a single snapshot so all the profile values are of the same profile.
+     */
+    SkeletonFrameInput Skeleton::readFrameInput() const
+    {
+        const auto profile = g_config.getActiveProfile();
+        SkeletonFrameInput input{
+            .config = {
+                .playerHeight = g_config.playerHeight,
+                .armLength = g_config.armLength,
+                .headBackPositionOffset = g_config.headBackPositionOffset,
+                .playerHMDOffsetUp = profile->playerHMDOffsetUp,
+                .playerBodyOffsetUp = profile->playerBodyOffsetUp,
+                .playerBodyOffsetForward = profile->playerBodyOffsetForward,
+                .comfortSneakHackStaticBodyPitchAngle = g_config.comfortSneakHackStaticBodyPitchAngle,
+                .dampenHandsRotation = g_config.dampenHandsRotation,
+                .dampenHandsTranslation = g_config.dampenHandsTranslation,
+                .dampenHandsRotationInVanillaScope = g_config.dampenHandsRotationInVanillaScope,
+                .dampenHandsTranslationInVanillaScope = g_config.dampenHandsTranslationInVanillaScope,
+                .hideHead = g_config.hideHead,
+                .leftHandedMode = isLeftHandedMode(),
+                .inPowerArmor = _inPowerArmor,
+                .disableSmoothMovement = g_config.disableSmoothMovement,
+                .selfieIgnoreHideFlags = g_config.selfieIgnoreHideFlags,
+                .dampenHands = g_config.dampenHands,
+                .dampenHandsInVanillaScope = g_config.dampenHandsInVanillaScope
+            },
+            .controllers = {}
+        };
+        for (const bool isLeft : { true, false }) {
+            const auto& state = VRControllers.getControllerState_DEPRECATED(isLeft ? TrackerType::Left : TrackerType::Right);
+            auto& controller = input.controllers[isLeft ? 0 : 1];
+            controller.buttonsPressed = state.ulButtonPressed;
+            controller.buttonsTouched = state.ulButtonTouched;
+            for (std::size_t i = 0; i < 5; i++) {
+                controller.axes[i * 2] = state.rAxis[i].x;
+                controller.axes[i * 2 + 1] = state.rAxis[i].y;
+            }
+        }
+        return input;
+    }
+
+    /**
+     * Get the local transforms of the skeleton bones and arms for frame capture regression check.
+     */
+    CapturedOutputBones Skeleton::getCaptureOutputBones() const
+    {
+        CapturedOutputBones output{};
+        for (std::size_t i = 0; i < SKELETON_BONES_COUNT; i++) {
+            if (_bones[i]) {
+                output[i] = _bones[i]->local;
+            }
+        }
+        std::size_t i = SKELETON_BONES_COUNT;
+        for (const auto& arm : { _leftArm, _rightArm }) {
+            output[i++] = arm.upper->local;
+            output[i++] = arm.forearm1->local;
+            output[i++] = arm.hand->local;
+        }
+        for (std::size_t fingerIdx = 0; fingerIdx < FINGER_BONES_COUNT; fingerIdx++) {
+            output[CAPTURED_OUTPUT_FINGERS_START + fingerIdx] = _handBones[fingerIdx];
+        }
+        return output;
+    }
+
+    /**
+     * Update the world transforms of all the dirty subtrees.
+     * A dirty subtree that has a dirty ancestor is skipped as the ancestor update covers it.
+     * Should be called only before code that reads skeleton world data.
+     */
+    void Skeleton::flushDirtyNodes()
+    {
+        _dirtySubtrees.flush([this](RE::NiAVObject* node) {
+            if (node == _root) {
+                updateDownFromRoot();
+            } else {
+                updateDown(node, true);
+            }
+        });
     }
 
     /**
@@ -238,6 +540,7 @@ namespace frik
         for (const auto& [boneNode, resetTransform] : _skeletonNodesToDefaultTransforms) {
             boneNode->local = resetTransform;
         }
+        _dirtySubtrees.markDirty(DirtySubtree::Root);
     }
 
     /**
@@ -245,13 +548,12 @@ namespace frik
      * It's still not good enough to prevent seeing hats and stuff, but it's a step forward in case
      * someone wants to tackle it further.
      */
-    void Skeleton::setupHead(const float neckYaw, const float neckPitch) const
+    void Skeleton::setupHead(const float neckYaw, const float neckPitch)
     {
-        const float headBackAdj = g_frik.isSelfieModeOn() && g_config.selfieIgnoreHideFlags ? 0 : g_config.headBackPositionOffset + (neckPitch > 0 ? 2 * neckPitch : 0);
+        const float headBackAdj = g_frik.isSelfieModeOn() && _frameInput.config.selfieIgnoreHideFlags ? 0 : _frameInput.config.headBackPositionOffset + (neckPitch > 0 ? 2 * neckPitch : 0);
         _head->local.translate -= RE::NiPoint3(headBackAdj, 2 * headBackAdj, 0);
         _head->local.rotate = _head->local.rotate * MatrixUtils::getMatrixFromEulerAngles(neckYaw, 0, neckPitch);
-        RE::NiUpdateData* ud = nullptr;
-        _head->UpdateWorldData(ud);
+        _dirtySubtrees.markDirty(DirtySubtree::Head);
     }
 
     // below takes the two vectors from hmd to each hand and sums them to determine a center axis in which to see how much the hmd has rotated
@@ -317,15 +619,15 @@ namespace frik
 
     float Skeleton::getBodyPitch(const float neckPitch) const
     {
-        if (isComfortSneakHackEnabled()) {
-            return MatrixUtils::degreesToRads(g_config.comfortSneakHackStaticBodyPitchAngle);
+        if (isComfortSneakHackEnabled(_frameInput.config)) {
+            return MatrixUtils::degreesToRads(_frameInput.config.comfortSneakHackStaticBodyPitchAngle);
         }
 
         constexpr float basePitch = 105.3f;
         constexpr float weight = 0.1f;
 
-        const float curHeight = g_config.playerHeight;
-        const float heightCalc = std::abs((curHeight - (_playerNodes->UprightHmdNode->local.translate.z + getAdjustedPlayerHMDOffset())) / curHeight);
+        const float curHeight = _frameInput.config.playerHeight;
+        const float heightCalc = std::abs((curHeight - (_playerNodes->UprightHmdNode->local.translate.z + getAdjustedPlayerHMDOffset(_frameInput.config.playerHMDOffsetUp))) / curHeight);
         const float angle = heightCalc * (basePitch + weight * MatrixUtils::radsToDegrees(neckPitch));
         return MatrixUtils::degreesToRads(angle);
     }
@@ -335,8 +637,8 @@ namespace frik
      */
     void Skeleton::setBodyUnderHMD(const float neckYaw, const float neckPitch)
     {
-        if (g_config.disableSmoothMovement) {
-            _playerNodes->playerworldnode->local.translate.z = getAdjustedPlayerHMDOffset();
+        if (_frameInput.config.disableSmoothMovement) {
+            _playerNodes->playerworldnode->local.translate.z = getAdjustedPlayerHMDOffset(_frameInput.config.playerHMDOffsetUp);
             updateDown(_playerNodes->playerworldnode, true);
         }
 
@@ -367,19 +669,20 @@ namespace frik
         _root->local.translate.z = z;
         //_root->local.translate *= 0.0f;
         //_root->local.translate.y = g_config.playerBodyOffsetForwardStanding - 6.0f;
-        _root->local.scale = g_config.playerHeight / DEFAULT_CAMERA_HEIGHT; // set scale based off specified user height
+        _root->local.scale = _frameInput.config.playerHeight / DEFAULT_CAMERA_HEIGHT; // set scale based off specified user height
+        _dirtySubtrees.markDirty(DirtySubtree::Root);
     }
 
     void Skeleton::setBodyPosture(const float neckPitch)
     {
         const float bodyPitch = _inPowerArmor ? getBodyPitch(neckPitch) : getBodyPitch(neckPitch) / 1.2f;
 
-        RE::NiNode* com = findNode(_root, "COM");
-        const RE::NiNode* neck = findNode(_root, "Neck");
-        RE::NiNode* spine = findNode(_root, "SPINE1");
+        RE::NiNode* com = getBone(SkeletonBone::COM);
+        const RE::NiNode* neck = getBone(SkeletonBone::Neck);
+        RE::NiNode* spine = getBone(SkeletonBone::Spine1);
 
-        _leftKneePos = findNode(com, "LLeg_Calf")->world.translate;
-        _rightKneePos = findNode(com, "RLeg_Calf")->world.translate;
+        _leftKneePos = getBone(SkeletonBone::LeftCalf)->world.translate;
+        _rightKneePos = getBone(SkeletonBone::RightCalf)->world.translate;
 
         com->local.translate.x = 0.0;
         com->local.translate.y = 0.0;
@@ -388,15 +691,15 @@ namespace frik
         const float comfortSneakAdjustZ = isComfortSneakMode() && isPlayerSneaking() ? COMFORT_SNEAK_BODY_OFFSET_ADJUSTMENT : 1.0f;
 
         // small offset to (1) not change player height when looking up/down and (2) move the body back, especially when looking down
-        const float xOffsetByNeckPitch = fmaxf(0, (isComfortSneakHackEnabled() ? 2.0f : 5.0f) * fabs(neckPitch) * _root->local.scale);
+        const float xOffsetByNeckPitch = fmaxf(0, (isComfortSneakHackEnabled(_frameInput.config) ? 2.0f : 5.0f) * fabs(neckPitch) * _root->local.scale);
         const float zOffsetByNeckPitch = 6.0f * neckPitch * _root->local.scale;
 
-        const float playerAdjustZ = (4 * g_config.getPlayerBodyOffsetUp() - g_config.getPlayerHMDOffsetUp()) * comfortSneakAdjustZ + zOffsetByNeckPitch;
+        const float playerAdjustZ = (4 * _frameInput.config.playerBodyOffsetUp - _frameInput.config.playerHMDOffsetUp) * comfortSneakAdjustZ + zOffsetByNeckPitch;
         // if people complain about body posture we can add manual adjustment here later
 
         const auto neckPos = getCameraPosition() + RE::NiPoint3(
-            -_forwardDir.x * (g_config.getPlayerBodyOffsetForward() / 2 - xOffsetByNeckPitch),
-            -_forwardDir.y * (g_config.getPlayerBodyOffsetForward() / 2 - xOffsetByNeckPitch),
+            -_forwardDir.x * (_frameInput.config.playerBodyOffsetForward / 2 - xOffsetByNeckPitch),
+            -_forwardDir.y * (_frameInput.config.playerBodyOffsetForward / 2 - xOffsetByNeckPitch),
             -playerAdjustZ);
 
         _torsoLen = MatrixUtils::vec3Len(neck->world.translate - com->world.translate);
@@ -412,20 +715,23 @@ namespace frik
         const RE::NiPoint3 newHipPos = neckPos + hmdToNewHip * (_torsoLen / MatrixUtils::vec3Len(hmdToNewHip));
 
         const RE::NiPoint3 newPos = com->local.translate + _root->world.rotate * (newHipPos - com->world.translate);
-        com->local.translate.y += newPos.y + g_config.getPlayerBodyOffsetForward() - 2 * xOffsetByNeckPitch;
+        com->local.translate.y += newPos.y + _frameInput.config.playerBodyOffsetForward - 2 * xOffsetByNeckPitch;
         com->local.translate.z = _inPowerArmor ? newPos.z / 1.7f : newPos.z / 1.5f;
 
         // ???
-        _root->parent->world.translate.z -= g_config.getPlayerBodyOffsetUp() + getAdjustedPlayerHMDOffset();
+        _root->parent->world.translate.z -= _frameInput.config.playerBodyOffsetUp + getAdjustedPlayerHMDOffset(_frameInput.config.playerHMDOffsetUp);
 
         const RE::NiMatrix3 mat = MatrixUtils::getMatrixFromRotateVectorVec(neckPos - tmpHipPos, hmdToHip) * spine->parent->world.rotate.Transpose();
         spine->local.rotate = spine->world.rotate * mat;
+
+        // the body world position changed, the whole skeleton needs update
+        _dirtySubtrees.markDirty(DirtySubtree::Root);
     }
 
     void Skeleton::setKneePos()
     {
-        const auto lKnee = findNode(_root, "LLeg_Calf");
-        const auto rKnee = findNode(_root, "RLeg_Calf");
+        const auto lKnee = getBone(SkeletonBone::LeftCalf);
+        const auto rKnee = getBone(SkeletonBone::RightCalf);
 
         if (!lKnee || !rKnee) {
             return;
@@ -442,17 +748,18 @@ namespace frik
     }
 
     // TODO: does it do anything? check if it works at all
-    void Skeleton::fixArmor() const
+    void Skeleton::fixArmor()
     {
-        auto lPauldron = findNode(_root, "L_Pauldron");
-        auto rPauldron = findNode(_root, "R_Pauldron");
+        // the pauldrons are armor nodes removed/reloaded with the Power Armor pieces, cached while still attached
+        const auto lPauldron = _pauldrons[0].get(_root, [](RE::NiNode* root) { return findNode(root, "L_Pauldron"); });
+        const auto rPauldron = _pauldrons[1].get(_root, [](RE::NiNode* root) { return findNode(root, "R_Pauldron"); });
 
         if (!lPauldron || !rPauldron) {
             return;
         }
 
         //float delta = findNode("LArm_Collarbone", _root)->world.translate.z - _root->world.translate.z;
-        const float delta = findNode(_root, "LArm_UpperArm")->world.translate.z - _root->world.translate.z;
+        const float delta = getBone(SkeletonBone::LeftUpperArm)->world.translate.z - _root->world.translate.z;
         if (lPauldron) {
             lPauldron->local.translate.z = delta - 15.0f;
         }
@@ -463,17 +770,17 @@ namespace frik
 
     void Skeleton::walk()
     {
-        const auto lHip = findNode(_root, "LLeg_Thigh");
-        const auto rHip = findNode(_root, "RLeg_Thigh");
+        const auto lHip = getBone(SkeletonBone::LeftThigh);
+        const auto rHip = getBone(SkeletonBone::RightThigh);
 
         if (!lHip || !rHip) {
             return;
         }
 
-        const auto lKnee = findNode(lHip, "LLeg_Calf");
-        const auto rKnee = findNode(rHip, "RLeg_Calf");
-        const auto lFoot = findNode(lHip, "LLeg_Foot");
-        const auto rFoot = findNode(rHip, "RLeg_Foot");
+        const auto lKnee = getBone(SkeletonBone::LeftCalf);
+        const auto rKnee = getBone(SkeletonBone::RightCalf);
+        const auto lFoot = getBone(SkeletonBone::LeftFoot);
+        const auto rFoot = getBone(SkeletonBone::RightFoot);
 
         if (!lKnee || !rKnee || !lFoot || !rFoot) {
             return;
@@ -494,7 +801,8 @@ namespace frik
 
         RE::NiPoint3 dir = curPos - lastPos;
 
-        float curSpeed = std::clamp(abs(MatrixUtils::vec3Len(dir)) / _frameTime, 0.0f, 350.0f);
+        const float frameTime = _frameClock.getFrameTime();
+        float curSpeed = std::clamp(abs(MatrixUtils::vec3Len(dir)) / frameTime, 0.0f, 350.0f);
         if (_prevSpeed > 20.0f) {
             curSpeed = (curSpeed + _prevSpeed) / 2.0f;
         }
@@ -595,10 +903,10 @@ namespace frik
 
             float sign = 1.0f;
 
-            _currentStepTime += _frameTime;
+            _currentStepTime += frameTime;
 
-            const float frameStep = _frameTime / _stepTimeinStep;
-            const float interp = std::clamp(frameStep * (_currentStepTime / _frameTime), 0.0f, 1.0f);
+            const float frameStep = frameTime / _stepTimeinStep;
+            const float interp = std::clamp(frameStep * (_currentStepTime / frameTime), 0.0f, 1.0f);
 
             if (_footStepping == 1) {
                 sign = -1.0f;
@@ -644,6 +952,7 @@ namespace frik
             spineAngle = sign * sinf(interp * std::numbers::pi_v<float>) * 3.0f;
 
             _spine->local.rotate = MatrixUtils::getMatrixFromEulerAngles(MatrixUtils::degreesToRads(spineAngle), 0.0f, 0.0f) * _spine->local.rotate;
+            _dirtySubtrees.markDirty(DirtySubtree::Spine);
 
             if (_currentStepTime > stepTime) {
                 _currentStepTime = 0.0;
@@ -671,62 +980,38 @@ namespace frik
     }
 
     // adapted solver from VRIK.  Thanks prog!
-    void Skeleton::setSingleLeg(const bool isLeft) const
+    void Skeleton::setSingleLeg(const bool isLeft)
     {
-        const auto footNode = isLeft ? findNode(_root, "LLeg_Foot") : findNode(_root, "RLeg_Foot");
-        const auto kneeNode = isLeft ? findNode(_root, "LLeg_Calf") : findNode(_root, "RLeg_Calf");
-        const auto hipNode = isLeft ? findNode(_root, "LLeg_Thigh") : findNode(_root, "RLeg_Thigh");
+        const auto footNode = getBone(isLeft ? SkeletonBone::LeftFoot : SkeletonBone::RightFoot);
+        const auto kneeNode = getBone(isLeft ? SkeletonBone::LeftCalf : SkeletonBone::RightCalf);
+        const auto hipNode = getBone(isLeft ? SkeletonBone::LeftThigh : SkeletonBone::RightThigh);
 
         const RE::NiPoint3 footPos = isLeft ? _leftFootPos : _rightFootPos;
         const RE::NiPoint3 hipPos = hipNode->world.translate;
 
-        const RE::NiPoint3 footToHip = hipNode->world.translate - footPos;
-
         auto rotV = RE::NiPoint3(0, 1, 0);
         if (_inPowerArmor) {
             rotV.y = 0;
             rotV.z = isLeft ? 1.0f : -1.0f;
         }
         const RE::NiPoint3 hipDir = hipNode->world.rotate.Transpose() * (rotV);
-        const RE::NiPoint3 xDir = MatrixUtils::vec3Norm(footToHip);
-        const RE::NiPoint3 yDir = MatrixUtils::vec3Norm(hipDir - xDir * MatrixUtils::vec3Dot(hipDir, xDir));
 
         const float thighLenOrig = MatrixUtils::vec3Len(kneeNode->local.translate);
         const float calfLenOrig = MatrixUtils::vec3Len(footNode->local.translate);
-        float thighLen = thighLenOrig;
-        float calfLen = calfLenOrig;
-
-        const float ftLen = (std::max)(MatrixUtils::vec3Len(footToHip), 0.1f);
-
-        if (ftLen > thighLen + calfLen) {
-            const float diff = ftLen - thighLen - calfLen;
-            const float ratio = calfLen / (calfLen + thighLen);
-            calfLen += ratio * diff + 0.1f;
-            thighLen += (1.0f - ratio) * diff + 0.1f;
-        }
-        // Use the law of cosines to calculate the angle the calf must bend to reach the knee position
-        // In cases where this is impossible (foot too close to thigh), then set calfLen = thighLen so
-        // there is always a solution
-        float footAngle = acosf((calfLen * calfLen + ftLen * ftLen - thighLen * thighLen) / (2 * calfLen * ftLen));
-        if (std::isnan(footAngle) || std::isinf(footAngle)) {
-            calfLen = thighLen = (thighLenOrig + calfLenOrig) / 2.0f;
-            footAngle = acosf((calfLen * calfLen + ftLen * ftLen - thighLen * thighLen) / (2 * calfLen * ftLen));
-        }
-        // Get the desired world coordinate of the knee
-        const float xDist = cosf(footAngle) * calfLen;
-        const float yDist = sinf(footAngle) * calfLen;
-        const RE::NiPoint3 kneePos = footPos + xDir * xDist + yDir * yDist;
-
-        const RE::NiPoint3 pos = kneePos - hipPos;
-        RE::NiPoint3 uLocalDir = hipNode->world.rotate * (MatrixUtils::vec3Norm(pos) / hipNode->world.scale);
-        hipNode->local.rotate = MatrixUtils::getMatrixFromRotateVectorVec(uLocalDir, kneeNode->local.translate) * hipNode->local.rotate;
+
+        // Get the desired world coordinate of the knee, if the foot is too close to thigh use the average length for both bones
+        const auto ik = solveTwoBoneIK({ toIKVec3(hipPos), toIKVec3(footPos), toIKVec3(hipDir), thighLenOrig, calfLenOrig, (thighLenOrig + calfLenOrig) / 2.0f });
+        const RE::NiPoint3 kneePos = toNiPoint3(ik.midJoint);
+
+        hipNode->local.rotate = aimBoneLocalRotation(hipNode->world.rotate, MatrixUtils::vec3Norm(kneePos - hipPos) / hipNode->world.scale, kneeNode->local.translate,
+            hipNode->local.rotate);
 
         const RE::NiMatrix3 hipWR = hipNode->local.rotate * hipNode->parent->world.rotate;
 
         RE::NiMatrix3 calfWR = kneeNode->local.rotate * hipWR;
 
-        uLocalDir = calfWR * (MatrixUtils::vec3Norm(footPos - kneePos) / kneeNode->world.scale);
-        kneeNode->local.rotate = MatrixUtils::getMatrixFromRotateVectorVec(uLocalDir, footNode->local.translate) * kneeNode->local.rotate;
+        kneeNode->local.rotate = aimBoneLocalRotation(calfWR, MatrixUtils::vec3Norm(footPos - kneePos) / kneeNode->world.scale, footNode->local.translate,
+            kneeNode->local.rotate);
 
         calfWR = kneeNode->local.rotate * hipWR;
 
@@ -741,6 +1026,8 @@ namespace frik
         if (MatrixUtils::vec3Len(footNode->local.translate) > calfLenOrig) {
             footNode->local.translate = MatrixUtils::vec3Norm(footNode->local.translate) * calfLenOrig;
         }
+
+        _dirtySubtrees.markDirty(isLeft ? DirtySubtree::LeftThigh : DirtySubtree::RightThigh);
     }
 
     void Skeleton::rotateLeg(const uint32_t pos, const float angle) const
@@ -769,7 +1056,7 @@ namespace frik
 
     void Skeleton::hideFistHelpers() const
     {
-        if (!isLeftHandedMode()) {
+        if (!_frameInput.config.leftHandedMode) {
             RE::NiAVObject* node = findNode(_playerNodes->primaryWandNode, "fist_M_Right_HELPER");
             if (node != nullptr) {
                 node->flags.flags |= 0x1; // first bit sets the cull flag so it will be hidden;
@@ -849,11 +1136,11 @@ namespace frik
      */
     void Skeleton::handleLeftHandedWeaponNodesSwitch()
     {
-        if (_lastLeftHandedModeSwitch == isLeftHandedMode()) {
+        if (_lastLeftHandedModeSwitch == _frameInput.config.leftHandedMode) {
             return;
         }
 
-        _lastLeftHandedModeSwitch = isLeftHandedMode();
+        _lastLeftHandedModeSwitch = _frameInput.config.leftHandedMode;
         logger::warn("Left-handed mode weapon nodes switch (LeftHanded:{})", _lastLeftHandedModeSwitch);
 
         RE::NiNode* rightWeapon = getWeaponNode();
@@ -863,7 +1150,7 @@ namespace frik
 
         if (!rightWeapon || !rHand || !leftWeapon || !lHand) {
             logger::sample("Cannot set up weapon nodes for left-handed mode switch");
-            _lastLeftHandedModeSwitch = isLeftHandedMode();
+            _lastLeftHandedModeSwitch = _frameInput.config.leftHandedMode;
             return;
         }
 
@@ -872,7 +1159,7 @@ namespace frik
         lHand->DetachChild(rightWeapon);
         lHand->DetachChild(leftWeapon);
 
-        if (isLeftHandedMode()) {
+        if (_frameInput.config.leftHandedMode) {
             rHand->AttachChild(leftWeapon, true);
             lHand->AttachChild(rightWeapon, true);
         } else {
@@ -901,7 +1188,7 @@ namespace frik
         RE::NiNode* leftWeapon = _playerNodes->WeaponLeftNode; // "WeaponLeft" can return incorrect node for left-handed with throwable weapons
 
         // handle the NON-primary hand (i.e. the hand that is NOT holding the weapon)
-        bool handleOffhand = isLeftHandedMode() ^ isLeft;
+        bool handleOffhand = _frameInput.config.leftHandedMode ^ isLeft;
 
         RE::NiNode* weaponNode = handleOffhand ? leftWeapon : rightWeapon;
         RE::NiNode* offsetNode = handleOffhand ? _playerNodes->SecondaryMeleeWeaponOffsetNode2 : _playerNodes->primaryWeaponOffsetNOde;
@@ -914,7 +1201,7 @@ namespace frik
             updateTransforms(_playerNodes->SecondaryMeleeWeaponOffsetNode2);
         }
 
-        weaponNode->local.rotate = !isLeftHandedMode()
+        weaponNode->local.rotate = !_frameInput.config.leftHandedMode
             ? MatrixUtils::getMatrix(-0.122f, 0.987f, 0.100f, 0.990f, 0.114f, 0.081f, 0.069f, 0.109f, -0.992f)
             : MatrixUtils::getMatrix(-0.122f, 0.987f, 0.100f, -0.990f, -0.114f, -0.081f, -0.069f, -0.109f, 0.992f);
 
@@ -922,7 +1209,7 @@ namespace frik
             weaponNode->local.rotate = weaponNode->local.rotate * MatrixUtils::getMatrixFromEulerAngles(0, MatrixUtils::degreesToRads(isLeft ? 45.0f : -45.0f), 0);
         }
 
-        weaponNode->local.translate = isLeftHandedMode()
+        weaponNode->local.translate = _frameInput.config.leftHandedMode
             ? (isLeft ? RE::NiPoint3(3.389f, -2.099f, 3.133f) : RE::NiPoint3(0, -4.8f, 0))
             : isLeft
             ? RE::NiPoint3(0, 0, 0)
@@ -946,12 +1233,12 @@ namespace frik
             return;
         }
 
-        float adjustedArmLength = g_config.armLength / 36.74f;
+        float adjustedArmLength = _frameInput.config.armLength / 36.74f;
 
         // Shoulder IK is done in a very simple way
 
         RE::NiPoint3 shoulderToHand = handPos - arm.upper->world.translate;
-        float armLength = g_config.armLength;
+        float armLength = _frameInput.config.armLength;
         float adjustAmount = (std::clamp)(MatrixUtils::vec3Len(shoulderToHand) - armLength * 0.5f, 0.0f, armLength * 0.85f) / (armLength * 0.85f);
         RE::NiPoint3 shoulderOffset = MatrixUtils::vec3Norm(shoulderToHand) * (adjustAmount * armLength * 0.08f);
 
@@ -963,6 +1250,7 @@ namespace frik
         arm.shoulder->local.rotate = result;
 
         updateDown(arm.shoulder, true);
+        _dirtySubtrees.markDirty(isLeft ? DirtySubtree::LeftShoulder : DirtySubtree::RightShoulder);
 
         // The bend of the arm depends on its distance to the body.  Its distance as well as the lengths of
         // the upper arm and forearm define the sides of a triangle:
@@ -1000,14 +1288,6 @@ namespace frik
             return;
         }
 
-        // Stretch the upper arm and forearm proportionally when the hand distance exceeds the arm length
-        if (hsLen > upperLen + forearmLen) {
-            float diff = hsLen - upperLen - forearmLen;
-            float ratio = forearmLen / (forearmLen + upperLen);
-            forearmLen += ratio * diff + 0.1f;
-            upperLen += (1.0f - ratio) * diff + 0.1f;
-        }
-
         RE::NiPoint3 forwardDir = MatrixUtils::vec3Norm(_forwardDir);
         RE::NiPoint3 sidewaysDir = MatrixUtils::vec3Norm(_sidewaysRDir * negLeft);
 
@@ -1070,10 +1350,7 @@ namespace frik
         RE::NiMatrix3 rot = MatrixUtils::getRotationAxisAngle(sidewaysDir * negLeft, twistLimitAngle);
         RE::NiPoint3 bendDownDir = rot.Transpose() * (forwardDir);
 
-        // Get the "X" direction vectors pointing to the shoulder
-        RE::NiPoint3 xDir = MatrixUtils::vec3Norm(handToShoulder);
-
-        // Get the final "Y" vector, perpendicular to "X", and pointing in elbow direction (as in the diagram above)
+        // Get the final elbow direction vector (the "Y" vector in the diagram above is perpendicular to "X" in this direction)
         float sideD = -(sidewaysDir.x * arm.shoulder->world.translate.x + sidewaysDir.y * arm.shoulder->world.translate.y) - 1.0f * 8.0f;
         float acrossAmount = -(handPos.x * sidewaysDir.x + handPos.y * sidewaysDir.y + sideD) / (16.0f * 1.0f);
         float handSideTwistOutward = MatrixUtils::vec3Dot(handSide, MatrixUtils::vec3Norm(sidewaysDir + forwardDir * 0.5f));
@@ -1086,21 +1363,12 @@ namespace frik
         float handBehindHead = (std::clamp)((handBehindDist + 0.0f * size) / (15.0f * size), 0.0f, 1.0f) * (std::clamp)(upLimit * 1.2f, 0.0f, 1.0f);
         float elbowsTwistForward = (std::max)(acrossAmount * MatrixUtils::degreesToRads(90), handBehindHead * MatrixUtils::degreesToRads(120));
         RE::NiPoint3 elbowDir = MatrixUtils::rotateXY(bendDownDir, -negLeft * (MatrixUtils::degreesToRads(150) - armTwist * MatrixUtils::degreesToRads(25) - elbowsTwistForward));
-        RE::NiPoint3 yDir = elbowDir - xDir * MatrixUtils::vec3Dot(elbowDir, xDir);
-        yDir = MatrixUtils::vec3Norm(yDir);
-
-        // Get the angle wrist must bend to reach elbow position
-        // In cases where this is impossible (hand too close to shoulder), then set forearmLen = upperLen so there is always a solution
-        float wristAngle = acosf((forearmLen * forearmLen + hsLen * hsLen - upperLen * upperLen) / (2 * forearmLen * hsLen));
-        if (isnan(wristAngle) || isinf(wristAngle)) {
-            forearmLen = upperLen = (originalUpperLen + originalForearmLen) / 2.0f * adjustedArmLength;
-            wristAngle = acosf((forearmLen * forearmLen + hsLen * hsLen - upperLen * upperLen) / (2 * forearmLen * hsLen));
-        }
 
-        // Get the desired world coordinate of the elbow
-        float xDist = cosf(wristAngle) * forearmLen;
-        float yDist = sinf(wristAngle) * forearmLen;
-        RE::NiPoint3 elbowWorld = handPos + xDir * xDist + yDir * yDist;
+        // Get the desired world coordinate of the elbow, stretching the upper arm and forearm proportionally when the hand distance exceeds the arm length
+        // In cases where the wrist angle is impossible (hand too close to shoulder), then set forearmLen = upperLen so there is always a solution
+        const auto ik = solveTwoBoneIK({ toIKVec3(Uwp), toIKVec3(handPos), toIKVec3(elbowDir), upperLen, forearmLen, (originalUpperLen + originalForearmLen) / 2.0f * adjustedArmLength });
+        RE::NiPoint3 elbowWorld = toNiPoint3(ik.midJoint);
+        forearmLen = ik.lowerLen;
 
         // This code below rotates and positions the upper arm, forearm, and hand bones
         // Notation: C=Clavicle, U=Upper arm, F=Forearm, H=hand   w=world, l=local   p=position, r=rotation, s=scale
@@ -1110,17 +1378,14 @@ namespace frik
 
         // The upper arm bone must be rotated from its forward vector to its shoulder-to-elbow vector in its local space
         // Calculate Ulr:  baseUwr * rotTowardElbow = Cwr * Ulr   ===>   Ulr = Cwr' * baseUwr * rotTowardElbow
-        RE::NiMatrix3 Uwr = arm.upper->world.rotate;
-        RE::NiPoint3 pos = elbowWorld - Uwp;
-        RE::NiPoint3 uLocalDir = Uwr * (MatrixUtils::vec3Norm(pos) / arm.upper->world.scale);
-
-        arm.upper->local.rotate = MatrixUtils::getMatrixFromRotateVectorVec(uLocalDir, arm.forearm1->local.translate) * arm.upper->local.rotate;
+        arm.upper->local.rotate = aimBoneLocalRotation(arm.upper->world.rotate, MatrixUtils::vec3Norm(elbowWorld - Uwp) / arm.upper->world.scale,
+            arm.forearm1->local.translate, arm.upper->local.rotate);
 
-        Uwr = arm.upper->local.rotate * arm.shoulder->world.rotate;
+        RE::NiMatrix3 Uwr = arm.upper->local.rotate * arm.shoulder->world.rotate;
 
         // Find the angle of the forearm twisted around the upper arm and twist the upper arm to align it
         //    Uwr * twist = Cwr * Ulr   ===>   Ulr = Cwr' * Uwr * twist
-        pos = handPos - elbowWorld;
+        RE::NiPoint3 pos = handPos - elbowWorld;
         RE::NiPoint3 uLocalTwist = Uwr * (MatrixUtils::vec3Norm(pos));
         uLocalTwist.x = 0;
         RE::NiPoint3 upperSide = arm.upper->world.rotate.Transpose() * (RE::NiPoint3(0, 1, 0));
@@ -1137,10 +1402,7 @@ namespace frik
         // The forearm arm bone must be rotated from its forward vector to its elbow-to-hand vector in its local space
         // Calculate Flr:  Fwr * rotTowardHand = Uwr * Flr   ===>   Flr = Uwr' * Fwr * rotTowardHand
         RE::NiMatrix3 Fwr = arm.forearm1->local.rotate * Uwr;
-        RE::NiPoint3 elbowHand = handPos - elbowWorld;
-        RE::NiPoint3 fLocalDir = Fwr * (MatrixUtils::vec3Norm(elbowHand));
-
-        arm.forearm1->local.rotate = MatrixUtils::getMatrixFromRotateVectorVec(fLocalDir, RE::NiPoint3(1, 0, 0)) * arm.forearm1->local.rotate;
+        arm.forearm1->local.rotate = aimBoneLocalRotation(Fwr, MatrixUtils::vec3Norm(handPos - elbowWorld), RE::NiPoint3(1, 0, 0), arm.forearm1->local.rotate);
         Fwr = arm.forearm1->local.rotate * Uwr;
 
         RE::NiMatrix3 Fwr3;
@@ -1195,138 +1457,178 @@ namespace frik
         updateDown(_root, false);
     }
 
-    void Skeleton::calculateHandPose(const std::string& bone, const float gripProx, const bool thumbUp, const bool isLeft)
+    /**
+     * Calculate the fingers pose of the given hand by controller buttons, grip proximity, and Papyrus overrides.
+     * All fingers of the hand are blended in a single batched slerp using the precomputed pose quaternions:
+     * first the target pose between closed and open, then from the current pose toward the target by frame time.
+     */
+    void Skeleton::calculateHandPose(const bool isLeft, const float gripProx, const bool thumbUp)
     {
-        Quaternion qc, qt;
-        const float sign = isLeft ? -1.0f : 1.0f;
-
-        // if a mod is using the papyrus interface to manually set finger poses
-        if (handPapyrusHasControl[bone]) {
-            qt.fromMatrix(handOpen[bone].rotate);
-            Quaternion qo;
-            qo.fromMatrix(handClosed[bone].rotate);
-            qo.slerp(std::clamp(handPapyrusPose[bone], -1.0f, 2.0f), qt);
-            qt = qo;
+        const auto hand = isLeft ? 0 : 1;
+
+        // blend weight between closed (0) and open (1) pose for each finger
+        FingerQuaternions::Weights targetWeights{};
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            const auto boneIdx = getFingerBoneIndex(isLeft, static_cast<Finger>(i));
+            if (handPapyrusHasControl[boneIdx]) {
+                // if a mod is using the papyrus interface to manually set finger poses
+                targetWeights[i] = std::clamp(handPapyrusPose[boneIdx], -1.0f, 2.0f);
+            } else if (_closedHand[boneIdx]) {
+                targetWeights[i] = 0.0f;
+            } else {
+                targetWeights[i] = getFingerButton(boneIdx) == k_EButton_Grip ? 1.0f - gripProx : 1.0f;
+            }
         }
+
+        FingerQuaternions target;
+        slerpFingers(handClosedQuats[hand], handOpenQuats[hand], targetWeights, target);
+
         // thumbUp pose
-        else if (thumbUp && bone.find("Finger1") != std::string::npos) {
-            if (bone.find("Finger11") != std::string::npos) {
-                RE::NiMatrix3 wr = handOpen[bone].rotate;
-                wr = MatrixUtils::getMatrixFromEulerAngles(sign * 0.5f, sign * 0.4f, -0.3f) * wr;
-                qt.fromMatrix(wr);
-            } else if (bone.find("Finger13") != std::string::npos) {
-                RE::NiMatrix3 wr = handOpen[bone].rotate;
-                wr = MatrixUtils::getMatrixFromEulerAngles(0, 0, MatrixUtils::degreesToRads(-35.0f)) * wr;
-                qt.fromMatrix(wr);
-            }
-        } else if (_closedHand[bone]) {
-            qt.fromMatrix(handClosed[bone].rotate);
-        } else {
-            qt.fromMatrix(handOpen[bone].rotate);
-            if (_handBonesButton.at(bone) == k_EButton_Grip) {
-                Quaternion qo;
-                qo.fromMatrix(handClosed[bone].rotate);
-                qo.slerp(1.0f - gripProx, qt);
-                qt = qo;
+        if (thumbUp) {
+            for (const auto finger : { Finger::Thumb1, Finger::Thumb2, Finger::Thumb3 }) {
+                if (!handPapyrusHasControl[getFingerBoneIndex(isLeft, finger)]) {
+                    target.copyLane(static_cast<std::size_t>(finger), handThumbUpQuats[hand]);
+                }
             }
         }
 
-        qc.fromMatrix(_handBones[bone].rotate);
-        const float blend = std::clamp(_frameTime * 7, -1.0f, 2.0f);
-        qc.slerp(blend, qt);
-        _handBones[bone].rotate = qc.getMatrix();
+        FingerQuaternions::Weights blend;
+        blend.fill(std::clamp(_frameClock.getFrameTime() * 7, -1.0f, 2.0f));
+        slerpFingers(_handBonesQuats[hand], target, blend, _handBonesQuats[hand]);
+
+        setHandBonesFromQuaternions(isLeft);
     }
 
     /**
-     * Copy the 1st-person bone position for the given hand bone.
+     * Copy the 1st-person bones position for the given hand fingers.
      * Useful for different weapons holding hand poses.
      */
-    void Skeleton::copy1StPerson(const std::string& bone)
+    void Skeleton::copy1StPerson(const bool isLeft)
     {
         const auto fpTree = getFirstPersonBoneTree();
-        const int pos = fpTree->GetBoneIndex(bone);
-        if (pos >= 0) {
-            if (fpTree->transforms[pos].refNode) {
-                _handBones[bone] = fpTree->transforms[pos].refNode->local;
-            } else {
-                _handBones[bone] = fpTree->transforms[pos].local;
+        if (fpTree != _firstPersonFingersTree) {
+            updateFirstPersonFingersTreePositions();
+        }
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            const auto boneIdx = getFingerBoneIndex(isLeft, static_cast<Finger>(i));
+            const int pos = _firstPersonFingersTreePositions[boneIdx];
+            if (pos >= 0) {
+                if (fpTree->transforms[pos].refNode) {
+                    _handBones[boneIdx] = fpTree->transforms[pos].refNode->local;
+                } else {
+                    _handBones[boneIdx] = fpTree->transforms[pos].local;
+                }
+                _handBonesQuats[isLeft ? 0 : 1].set(i, _handBones[boneIdx].rotate);
             }
         }
     }
 
+    /**
+     * Resolve the finger bones positions in the first-person bone tree, only when the first-person tree changes.
+     */
+    void Skeleton::updateFirstPersonFingersTreePositions()
+    {
+        _firstPersonFingersTree = getFirstPersonBoneTree();
+        for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+            _firstPersonFingersTreePositions[i] = _firstPersonFingersTree ? _firstPersonFingersTree->GetBoneIndex(FINGER_BONE_NAMES[i]) : -1;
+        }
+    }
+
     /**
      * In left-handed mode the 1st-person skeleton is not using the correct hand so we can't use "copy1StPerson" method.
      * Instead, we just force a specific hand pose that makes sense.
      */
-    void Skeleton::setPredefinedHandPose(const std::string& bone)
+    void Skeleton::setPredefinedHandPose(const bool isLeft)
     {
-        Quaternion qo, qt;
-        qt.fromMatrix(handOpen[bone].rotate);
-        qo.fromMatrix(handClosed[bone].rotate);
-        qo.slerp(std::clamp(getHandBonePose(bone, g_frik.isMeleeWeaponDrawn()), -1.0f, 2.0f), qt);
-        _handBones[bone].rotate = qo.getMatrix();
+        const auto hand = isLeft ? 0 : 1;
+        const bool melee = g_frik.isMeleeWeaponDrawn();
+        FingerQuaternions::Weights weights{};
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            weights[i] = std::clamp(getHandBonePose(getFingerBoneIndex(isLeft, static_cast<Finger>(i)), melee), -1.0f, 2.0f);
+        }
+        slerpFingers(handClosedQuats[hand], handOpenQuats[hand], weights, _handBonesQuats[hand]);
+        setHandBonesFromQuaternions(isLeft);
     }
 
-    void Skeleton::setHandPose()
+    void Skeleton::setHandBonesFromQuaternions(const bool isLeft)
     {
-        const auto rt = reinterpret_cast<BSFlattenedBoneTree*>(_root);
-        for (auto pos = 0; pos < rt->numTransforms; pos++) {
-            std::string name = Skelly::getBoneName(pos);
-            auto found = _fingerRelations.find(name);
-            if (found != _fingerRelations.end()) {
-                const bool isLeft = name[0] == 'L';
-                const uint64_t reg = isLeft
-                    ? VRControllers.getControllerState_DEPRECATED(TrackerType::Left).ulButtonTouched
-                    : VRControllers.getControllerState_DEPRECATED(TrackerType::Right).ulButtonTouched;
-                const float gripProx = isLeft
-                    ? VRControllers.getControllerState_DEPRECATED(TrackerType::Left).rAxis[2].x
-                    : VRControllers.getControllerState_DEPRECATED(TrackerType::Right).rAxis[2].x;
-                const bool thumbUp = reg & ButtonMaskFromId(k_EButton_Grip)
-                    && reg & ButtonMaskFromId(k_EButton_SteamVR_Trigger)
-                    && !(reg & ButtonMaskFromId(k_EButton_SteamVR_Touchpad));
-                _closedHand[name] = reg & ButtonMaskFromId(_handBonesButton.at(name));
-
-                if (IsWeaponDrawn()
-                    && (isLeftHandedMode() || !g_frik.isPipboyOperatingWithFinger()) // left-handed has pipboy on the hand with the weapon
-                    && !(isLeft ^ isLeftHandedMode())) {
-                    if (isLeftHandedMode()) {
-                        setPredefinedHandPose(name);
-                    } else {
-                        // use the game hand position for the weapon in hand
-                        copy1StPerson(name);
-                    }
-                } else {
-                    // use the forced hand position
-                    calculateHandPose(name, gripProx, thumbUp, isLeft);
-                }
+        const auto& quats = _handBonesQuats[isLeft ? 0 : 1];
+        for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+            _handBones[getFingerBoneIndex(isLeft, static_cast<Finger>(i))].rotate = quats.getMatrix(i);
+        }
+    }
 
-                const RE::NiTransform trans = _handBones[name];
+    void Skeleton::setHandPose()
+    {
+        struct HandState
+        {
+            float gripProx;
+            bool thumbUp;
+            bool useWeaponHandPose;
+            uint64_t touchedButtons;
+        };
 
-                rt->transforms[pos].local.rotate = trans.rotate;
-                rt->transforms[pos].local.translate = handOpen[name.c_str()].translate;
+        // controller state is the same for all fingers of the hand, read it once per hand
+        const auto getHandState = [this](const bool isLeft) {
+            const auto& state = _frameInput.getController(isLeft);
+            const uint64_t reg = state.buttonsTouched;
+            return HandState{
+                .gripProx = state.axisX(2),
+                .thumbUp = reg & ButtonMaskFromId(k_EButton_Grip)
+                && reg & ButtonMaskFromId(k_EButton_SteamVR_Trigger)
+                && !(reg & ButtonMaskFromId(k_EButton_SteamVR_Touchpad)),
+                .useWeaponHandPose = IsWeaponDrawn()
+                && (_frameInput.config.leftHandedMode || !g_frik.isPipboyOperatingWithFinger()) // left-handed has pipboy on the hand with the weapon
+                && !(isLeft ^ _frameInput.config.leftHandedMode),
+                .touchedButtons = reg
+            };
+        };
 
-                if (rt->transforms[pos].refNode) {
-                    rt->transforms[pos].refNode->local = rt->transforms[pos].local;
-                }
+        for (const bool isLeft : { true, false }) {
+            const auto handState = getHandState(isLeft);
+            for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                const auto boneIdx = getFingerBoneIndex(isLeft, static_cast<Finger>(i));
+                _closedHand[boneIdx] = handState.touchedButtons & ButtonMaskFromId(getFingerButton(boneIdx));
             }
 
-            if (rt->transforms[pos].refNode) {
-                rt->transforms[pos].world = rt->transforms[pos].refNode->world;
+            if (handState.useWeaponHandPose) {
+                if (_frameInput.config.leftHandedMode) {
+                    setPredefinedHandPose(isLeft);
+                } else {
+                    // use the game hand position for the weapon in hand
+                    copy1StPerson(isLeft);
+                }
             } else {
-                const short parent = rt->transforms[pos].parPos;
-                RE::NiPoint3 p = rt->transforms[pos].local.translate;
-                p = rt->transforms[parent].world.rotate.Transpose() * ((p * rt->transforms[parent].world.scale));
+                // use the forced hand position
+                calculateHandPose(isLeft, handState.gripProx, handState.thumbUp);
+            }
+        }
 
-                rt->transforms[pos].world.translate = rt->transforms[parent].world.translate + p;
+        const auto rt = reinterpret_cast<BSFlattenedBoneTree*>(_root);
+        for (const auto& [pos, fingerBoneIdx] : _handBonesTreePositions) {
+            auto& transform = rt->transforms[pos];
+            if (fingerBoneIdx >= 0) {
+                transform.local.rotate = _handBones[fingerBoneIdx].rotate;
+                transform.local.translate = handOpen[fingerBoneIdx].translate;
+
+                if (transform.refNode) {
+                    transform.refNode->local = transform.local;
+                }
+            }
 
-                rt->transforms[pos].world.rotate = rt->transforms[pos].local.rotate * rt->transforms[parent].world.rotate;
+            if (transform.refNode) {
+                transform.world = transform.refNode->world;
             }
         }
+
+        // entries without a node calculate world from parent in batch, after all the nodes worlds were synced
+        _handBonesTreeKernel.update(rt);
     }
 
     void Skeleton::dampenHand(RE::NiNode* node, const bool isLeft)
     {
-        if (!g_config.dampenHands) {
+        const auto& config = _frameInput.config;
+        if (!config.dampenHands) {
             if (g_frik.isMainConfigurationModeActive()) {
                 // small hack to prevent jarring effect when dampen is enabled for the first time via main config
                 if (isLeft) {
@@ -1339,7 +1641,7 @@ namespace frik
         }
 
         const bool isInScopeMenu = g_frik.isInScopeMenu();
-        if (isInScopeMenu && !g_config.dampenHandsInVanillaScope) {
+        if (isInScopeMenu && !config.dampenHandsInVanillaScope) {
             return;
         }
 
@@ -1350,13 +1652,13 @@ namespace frik
         Quaternion rq, rt;
         rq.fromMatrix(prevFrame.rotate);
         rt.fromMatrix(node->world.rotate);
-        rq.slerp(1 - (isInScopeMenu ? g_config.dampenHandsRotationInVanillaScope : g_config.dampenHandsRotation), rt);
+        rq.slerp(1 - (isInScopeMenu ? config.dampenHandsRotationInVanillaScope : config.dampenHandsRotation), rt);
         node->world.rotate = rq.getMatrix();
 
         // Linear interpolation between the position from the previous frame to current frame
         const RE::NiPoint3 dir = _curentPosition - _lastPosition; // Offset the player movement from this interpolation
         RE::NiPoint3 deltaPos = node->world.translate - prevFrame.translate - dir; // Add in player velocity
-        deltaPos *= isInScopeMenu ? g_config.dampenHandsTranslationInVanillaScope : g_config.dampenHandsTranslation;
+        deltaPos *= isInScopeMenu ? config.dampenHandsTranslationInVanillaScope : config.dampenHandsTranslation;
         node->world.translate -= deltaPos;
 
         // Update the previous frame transform
@@ -1459,71 +1761,4 @@ namespace frik
             { "Head", MatrixUtils::getTransform(8.22440f, 0.0f, 0.0f, 0.94891f, 0.31555f, 0.00002f, -0.31555f, 0.94891f, 0.0f, -0.00002f, -0.00001f, 1.0f, 1.0f) },
         };
     }
-
-    std::map<std::string, std::pair<std::string, std::string>> Skeleton::makeFingerRelations()
-    {
-        std::map<std::string, std::pair<std::string, std::string>> map;
-
-        auto addFingerRelations = [&](const std::string& hand, const std::string& finger1, const std::string& finger2,
-            const std::string& finger3) {
-            map.insert({ finger1, { hand, finger2 } });
-            map.insert({ finger2, { finger1, finger3 } });
-            map.insert({ finger3, { finger2, std::string() } });
-        };
-
-        //left hand
-        addFingerRelations("LArm_Hand", "LArm_Finger11", "LArm_Finger12", "LArm_Finger13");
-        addFingerRelations("LArm_Hand", "LArm_Finger21", "LArm_Finger22", "LArm_Finger23");
-        addFingerRelations("LArm_Hand", "LArm_Finger31", "LArm_Finger32", "LArm_Finger33");
-        addFingerRelations("LArm_Hand", "LArm_Finger41", "LArm_Finger42", "LArm_Finger43");
-        addFingerRelations("LArm_Hand", "LArm_Finger51", "LArm_Finger52", "LArm_Finger53");
-
-        //right hand
-        addFingerRelations("RArm_Hand", "RArm_Finger11", "RArm_Finger12", "RArm_Finger13");
-        addFingerRelations("RArm_Hand", "RArm_Finger21", "RArm_Finger22", "RArm_Finger23");
-        addFingerRelations("RArm_Hand", "RArm_Finger31", "RArm_Finger32", "RArm_Finger33");
-        addFingerRelations("RArm_Hand", "RArm_Finger41", "RArm_Finger42", "RArm_Finger43");
-        addFingerRelations("RArm_Hand", "RArm_Finger51", "RArm_Finger52", "RArm_Finger53");
-
-        return map;
-    }
-
-    /**
-     * setup hand bones to openvr button mapping
-     */
-    std::unordered_map<std::string, VRButtonId> Skeleton::getHandBonesButtonMap()
-    {
-        return std::unordered_map<std::string, VRButtonId>{
-            { "LArm_Finger11", k_EButton_SteamVR_Touchpad },
-            { "LArm_Finger12", k_EButton_SteamVR_Touchpad },
-            { "LArm_Finger13", k_EButton_SteamVR_Touchpad },
-            { "LArm_Finger21", k_EButton_SteamVR_Trigger },
-            { "LArm_Finger22", k_EButton_SteamVR_Trigger },
-            { "LArm_Finger23", k_EButton_SteamVR_Trigger },
-            { "LArm_Finger31", k_EButton_Grip },
-            { "LArm_Finger32", k_EButton_Grip },
-            { "LArm_Finger33", k_EButton_Grip },
-            { "LArm_Finger41", k_EButton_Grip },
-            { "LArm_Finger42", k_EButton_Grip },
-            { "LArm_Finger43", k_EButton_Grip },
-            { "LArm_Finger51", k_EButton_Grip },
-            { "LArm_Finger52", k_EButton_Grip },
-            { "LArm_Finger53", k_EButton_Grip },
-            { "RArm_Finger11", k_EButton_SteamVR_Touchpad },
-            { "RArm_Finger12", k_EButton_SteamVR_Touchpad },
-            { "RArm_Finger13", k_EButton_SteamVR_Touchpad },
-            { "RArm_Finger21", k_EButton_SteamVR_Trigger },
-            { "RArm_Finger22", k_EButton_SteamVR_Trigger },
-            { "RArm_Finger23", k_EButton_SteamVR_Trigger },
-            { "RArm_Finger31", k_EButton_Grip },
-            { "RArm_Finger32", k_EButton_Grip },
-            { "RArm_Finger33", k_EButton_Grip },
-            { "RArm_Finger41", k_EButton_Grip },
-            { "RArm_Finger42", k_EButton_Grip },
-            { "RArm_Finger43", k_EButton_Grip },
-            { "RArm_Finger51", k_EButton_Grip },
-            { "RArm_Finger52", k_EButton_Grip },
-            { "RArm_Finger53", k_EButton_Grip }
-        };
-    }
 }
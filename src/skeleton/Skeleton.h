@@ -2,9 +2,20 @@
 
 #include <map>
 
+#include "AttachedNodeCache.h"
+#include "BoneKinematics.h"
+#include "BoneTreeTransformsKernel.h"
+#include "Config.h"
 #include "CullGeometryHandler.h"
+#include "DirtySubtrees.h"
+#include "FrameClock.h"
+#include "FingerQuaternions.h"
+#include "FrameCapture.h"
 #include "SelfieHandler.h"
+#include "SkeletonBones.h"
+#include "SkeletonFrameInput.h"
 #include "common/CommonUtils.h"
+#include "f4vr/BSFlattenedBoneTree.h"
 #include "f4vr/PlayerNodes.h"
 #include "vrcf/VRControllersManager.h"
 
@@ -24,8 +35,8 @@ namespace frik
     class Skeleton
     {
     public:
-        Skeleton(RE::NiNode* rootNode, const bool inPowerArmor) :
-            _root(rootNode), _inPowerArmor(inPowerArmor)
+        Skeleton(RE::NiNode* rootNode, const bool inPowerArmor, const FrameClock& frameClock) :
+            _root(rootNode), _inPowerArmor(inPowerArmor), _frameClock(frameClock)
         {
             _curentPosition = RE::NiPoint3(0, 0, 0);
             _walkingState = 0;
@@ -43,6 +54,12 @@ namespace frik
         }
 
         static float getAdjustedPlayerHMDOffset();
+        static float getAdjustedPlayerHMDOffset(float playerHMDOffsetUp);
+
+        const BoneKinematics& getBoneKinematics() const { return _boneKinematics; }
+        BoneKinematics::Handle getCameraKinematics() const { return _cameraKinematics; }
+        BoneKinematics::Handle getHandKinematics(const bool isLeft) const { return _handKinematics[isLeft ? 0 : 1]; }
+        const BoneTreeTransformsKernel& getHandBonesTreeKernel() const { return _handBonesTreeKernel; }
 
         void onFrameUpdate();
 
@@ -51,17 +68,24 @@ namespace frik
         void initializeNodes();
         void initArmsNodes();
         void initSkeletonNodesDefaults();
+        void bindSkeletonBones();
+        void bindDirtySubtrees();
+        void initHandBonesTreePositions();
+        void initBoneKinematics();
+        void validateSkeletonBones();
         void setBodyLen();
 
         // on frame update - skeleton update
-        void setTime();
+        SkeletonFrameInput readFrameInput() const;
+        CapturedOutputBones getCaptureOutputBones() const;
+        void flushDirtyNodes();
         void restoreNodesToDefault();
-        void setupHead(float neckYaw, float neckPitch) const;
+        void setupHead(float neckYaw, float neckPitch);
         void setBodyUnderHMD(float neckYaw, float neckPitch);
         void setBodyPosture(float neckPitch);
         void setKneePos();
         void walk();
-        void setSingleLeg(bool isLeft) const;
+        void setSingleLeg(bool isLeft);
         void handleLeftHandedWeaponNodesSwitch();
         void setArms(bool isLeft);
         void dampenHand(RE::NiNode* node, bool isLeft);
@@ -70,12 +94,18 @@ namespace frik
         void showHidePAHud() const;
         void setHandPose();
         void hideHands() const;
-        void fixArmor() const;
+        void fixArmor();
+        void sampleBoneKinematics();
 
         // Utils
-        void calculateHandPose(const std::string& bone, float gripProx, bool thumbUp, bool isLeft);
-        void copy1StPerson(const std::string& bone);
-        void setPredefinedHandPose(const std::string& bone);
+        void calculateHandPose(bool isLeft, float gripProx, bool thumbUp);
+        void copy1StPerson(bool isLeft);
+        void updateFirstPersonFingersTreePositions();
+        void setPredefinedHandPose(bool isLeft);
+        void setHandBonesFromQuaternions(bool isLeft);
+
+        // Utils - Bones
+        RE::NiNode* getBone(const SkeletonBone bone) const { return _bones[static_cast<std::size_t>(bone)]; }
 
         // Utils - Body Positioning
         float getNeckYaw() const;
@@ -87,11 +117,12 @@ namespace frik
         RE::NiNode* _root;
         bool _inPowerArmor;
 
-        // ???
-        LARGE_INTEGER _freqCounter;
-        LARGE_INTEGER _timer;
-        LARGE_INTEGER _prevTime;
-        float _frameTime;
+        // the shared frame clock, sampled once per frame before skeleton update
+        const FrameClock& _frameClock;
+
+        // config and controllers read once per frame so a concurrent config change can't mix profiles mid-frame,
+        // replaced by the recorded input on frame capture replay
+        SkeletonFrameInput _frameInput{};
 
         // handle switch of hands for left-handed mode
         bool _lastLeftHandedModeSwitch = false;
@@ -117,6 +148,16 @@ namespace frik
         ArmNodes _rightArm;
         ArmNodes _leftArm;
 
+        // skeleton bones resolved by name once (see SkeletonBone), rebind if the root they were resolved from changes
+        std::array<RE::NiNode*, SKELETON_BONES_COUNT> _bones{};
+        RE::NiNode* _bonesBoundRoot = nullptr;
+
+        // Power Armor left and right pauldrons, armor nodes that are re-created with the armor pieces
+        std::array<AttachedNodeCache, 2> _pauldrons;
+
+        // subtrees with changed local transform that require world update on next flush
+        DirtySubtrees _dirtySubtrees;
+
         // Default transform are used to reset the skeleton before each frame update to start from scratch
         std::vector<std::pair<RE::NiAVObject*, const RE::NiTransform>> _skeletonNodesToDefaultTransforms;
         static std::unordered_map<std::string, RE::NiTransform> getSkeletonNodesDefaultTransforms();
@@ -143,17 +184,39 @@ namespace frik
         float _stepTimeinStep;
         int _delayFrame;
 
-        std::map<std::string, RE::NiTransform, common::CaseInsensitiveComparator> _handBones;
-        std::map<std::string, bool, common::CaseInsensitiveComparator> _closedHand;
-        static std::unordered_map<std::string, vrcf::VRButtonId> getHandBonesButtonMap();
-        inline static const std::unordered_map<std::string, vrcf::VRButtonId> _handBonesButton = getHandBonesButtonMap();
+        // current fingers pose and if the finger button is pressed, indexed by finger bone index
+        std::array<RE::NiTransform, FINGER_BONES_COUNT> _handBones;
+        std::array<bool, FINGER_BONES_COUNT> _closedHand{};
+
+        // current fingers rotations as quaternions per hand (0 - left, 1 - right), kept in sync with _handBones rotations
+        std::array<FingerQuaternions, 2> _handBonesQuats;
+
+        // Flattened bone tree entry that is updated by hand pose: finger bone, finger descendant, or hand (parent of finger) to sync world from.
+        struct HandBoneTreePosition
+        {
+            int pos;
+            // finger bone index or -1 for entries that only need world update
+            int fingerBoneIdx;
+        };
+
+        // hand related flattened bone tree positions resolved on init, in parent-before-child order
+        std::vector<HandBoneTreePosition> _handBonesTreePositions;
+
+        // batched world update of the hand tree positions that have no scene graph node to sync world from
+        BoneTreeTransformsKernel _handBonesTreeKernel;
+
+        // finger bones positions in the first-person bone tree to copy weapon holding hand pose from
+        f4vr::BSFlattenedBoneTree* _firstPersonFingersTree = nullptr;
+        std::array<int, FINGER_BONES_COUNT> _firstPersonFingersTreePositions{};
 
         RE::NiTransform _rightHandPrevFrame;
         RE::NiTransform _leftHandPrevFrame;
 
-        // bones
-        static std::map<std::string, std::pair<std::string, std::string>> makeFingerRelations();
-        inline static const std::map<std::string, std::pair<std::string, std::string>> _fingerRelations = makeFingerRelations();
+        // camera and hands (middle finger base bone) positions history for motion detection
+        BoneKinematics _boneKinematics;
+        BoneKinematics::Handle _cameraKinematics = 0;
+        std::array<BoneKinematics::Handle, 2> _handKinematics{};
+        std::array<int, 2> _handKinematicsTreePositions{ -1, -1 };
 
         // cull (hide) parts of the skeleton (head, equipment)
         CullGeometryHandler _cullGeometry;
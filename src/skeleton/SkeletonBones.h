@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+
+namespace frik
+{
+    /**
+     * Skeleton bones used during frame update that are resolved once by name on skeleton init.
+     * Frame update code uses the enum to index into the resolved nodes table instead of searching the scene graph by name.
+     */
+    enum class SkeletonBone : uint8_t
+    {
+        Camera = 0,
+        COM,
+        Pelvis,
+        Spine1,
+        Neck,
+        LeftThigh,
+        LeftCalf,
+        LeftFoot,
+        RightThigh,
+        RightCalf,
+        RightFoot,
+        LeftUpperArm,
+
+        Count
+    };
+
+    constexpr auto SKELETON_BONES_COUNT = static_cast<std::size_t>(SkeletonBone::Count);
+
+    /**
+     * The scene graph node name of each skeleton bone, must match the order of SkeletonBone enum.
+     */
+    constexpr std::array<const char*, SKELETON_BONES_COUNT> SKELETON_BONE_NAMES = {
+        "Camera",
+        "COM",
+        "Pelvis",
+        "SPINE1",
+        "Neck",
+        "LLeg_Thigh",
+        "LLeg_Calf",
+        "LLeg_Foot",
+        "RLeg_Thigh",
+        "RLeg_Calf",
+        "RLeg_Foot",
+        "LArm_UpperArm",
+    };
+
+    /**
+     * The finger bones of a single hand, 3 bones for each of the 5 fingers (thumb to pinky).
+     * Finger bones of both hands are stored in contiguous arrays: left hand [0..14] and right hand [15..29].
+     */
+    enum class Finger : uint8_t
+    {
+        Thumb1 = 0,
+        Thumb2,
+        Thumb3,
+        Index1,
+        Index2,
+        Index3,
+        Middle1,
+        Middle2,
+        Middle3,
+        Ring1,
+        Ring2,
+        Ring3,
+        Pinky1,
+        Pinky2,
+        Pinky3,
+    };
+
+    constexpr std::size_t FINGERS_COUNT = 15;
+    constexpr std::size_t FINGER_BONES_COUNT = FINGERS_COUNT * 2;
+
+    /**
+     * The skeleton bone names of both hands fingers, indexed by finger bone index.
+     */
+    constexpr std::array<const char*, FINGER_BONES_COUNT> FINGER_BONE_NAMES = {
+        "LArm_Finger11", "LArm_Finger12", "LArm_Finger13", "LArm_Finger21", "LArm_Finger22", "LArm_Finger23", "LArm_Finger31", "LArm_Finger32", "LArm_Finger33", "LArm_Finger41",
+        "LArm_Finger42", "LArm_Finger43", "LArm_Finger51", "LArm_Finger52", "LArm_Finger53",
+        "RArm_Finger11", "RArm_Finger12", "RArm_Finger13", "RArm_Finger21", "RArm_Finger22", "RArm_Finger23", "RArm_Finger31", "RArm_Finger32", "RArm_Finger33", "RArm_Finger41",
+        "RArm_Finger42", "RArm_Finger43", "RArm_Finger51", "RArm_Finger52", "RArm_Finger53"
+    };
+
+    constexpr std::size_t getFingerBoneIndex(const bool isLeft, const Finger finger)
+    {
+        return (isLeft ? 0 : FINGERS_COUNT) + static_cast<std::size_t>(finger);
+    }
+
+    constexpr Finger getFingerOfBoneIndex(const std::size_t boneIdx)
+    {
+        return static_cast<Finger>(boneIdx % FINGERS_COUNT);
+    }
+
+    constexpr bool isLeftHandFingerBoneIndex(const std::size_t boneIdx)
+    {
+        return boneIdx < FINGERS_COUNT;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace frik
+{
+    /**
+     * Controller state of a single hand as read from OpenVR.
+     */
+    struct FrameControllerState
+    {
+        uint64_t buttonsPressed;
+        uint64_t buttonsTouched;
+        // rAxis[0..4] x,y
+        std::array<float, 10> axes;
+
+        float axisX(const std::size_t axis) const { return axes[axis * 2]; }
+    };
+
+    /**
+     * The config values the skeleton calculation depends on, read once at the start of the skeleton frame update.
+     * Frame capture replay provides the recorded values instead of the live config without changing the live config.
+     */
+    struct SkeletonFrameConfig
+    {
+        float playerHeight;
+        float armLength;
+        float headBackPositionOffset;
+        float playerHMDOffsetUp;
+        float playerBodyOffsetUp;
+        float playerBodyOffsetForward;
+        float comfortSneakHackStaticBodyPitchAngle;
+        float dampenHandsRotation;
+        float dampenHandsTranslation;
+        float dampenHandsRotationInVanillaScope;
+        float dampenHandsTranslationInVanillaScope;
+        bool hideHead;
+        bool leftHandedMode;
+        bool inPowerArmor;
+        bool disableSmoothMovement;
+        bool selfieIgnoreHideFlags;
+        bool dampenHands;
+        bool dampenHandsInVanillaScope;
+    };
+
+    /**
+     * Everything the skeleton frame update reads from config and controllers, sampled once per frame.
+     */
+    struct SkeletonFrameInput
+    {
+        SkeletonFrameConfig config;
+        // 0 - left, 1 - right
+        std::array<FrameControllerState, 2> controllers;
+
+        const FrameControllerState& getController(const bool isLeft) const { return controllers[isLeft ? 0 : 1]; }
+    };
+}
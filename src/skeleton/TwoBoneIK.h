@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace frik
+{
+    /**
+     * Plain 3D vector of the IK solver so it has no dependency on the game math types and can be built and tested
+     * off-target. Callers convert from/to the scene graph point type.
+     */
+    struct IKVec3
+    {
+        float x = 0;
+        float y = 0;
+        float z = 0;
+
+        constexpr IKVec3 operator+(const IKVec3& other) const { return { x + other.x, y + other.y, z + other.z }; }
+        constexpr IKVec3 operator-(const IKVec3& other) const { return { x - other.x, y - other.y, z - other.z }; }
+        constexpr IKVec3 operator*(const float scalar) const { return { x * scalar, y * scalar, z * scalar }; }
+
+        constexpr float dot(const IKVec3& other) const { return x * other.x + y * other.y + z * other.z; }
+        float length() const { return std::sqrt(dot(*this)); }
+
+        IKVec3 normalized() const
+        {
+            const float len = length();
+            return len > 0 ? *this * (1.0f / len) : IKVec3{};
+        }
+    };
+
+    /**
+     * Input of a two-bone IK chain (upper arm + forearm or thigh + calf) in world space.
+     */
+    struct TwoBoneIKChain
+    {
+        // world position of the chain root joint (shoulder/hip)
+        IKVec3 root;
+        // world position the chain end (hand/foot) should reach
+        IKVec3 target;
+        // world direction the middle joint (elbow/knee) should bend toward, doesn't need to be perpendicular to the chain
+        IKVec3 pole;
+        float upperLen;
+        float lowerLen;
+        // length used for both bones when the triangle has no solution (target too close to the root)
+        float fallbackLen;
+    };
+
+    /**
+     * Output of the two-bone IK solver.
+     * Bone lengths are the input lengths after stretching to reach the target or falling back on impossible triangle.
+     */
+    struct TwoBoneIKSolution
+    {
+        IKVec3 midJoint;
+        float upperLen;
+        float lowerLen;
+    };
+
+    /**
+     * Solve the middle joint world position of a two-bone chain so the chain end reaches the target.
+     * Bones are stretched proportionally when the target is farther than the chain length.
+     * Uses the law of cosines to calculate the angle the lower bone must bend from the target to reach the middle joint:
+     * Angle A = acos( (b^2 + c^2 - a^2) / (2*b*c) ) where a,b are the bones lengths and c is the target-to-root distance.
+     * No allocations and no scene graph access.
+     */
+    inline TwoBoneIKSolution solveTwoBoneIK(const TwoBoneIKChain& chain)
+    {
+        const IKVec3 targetToRoot = chain.root - chain.target;
+        const float distance = (std::max)(targetToRoot.length(), 0.1f);
+
+        float upperLen = chain.upperLen;
+        float lowerLen = chain.lowerLen;
+        if (distance > upperLen + lowerLen) {
+            const float diff = distance - upperLen - lowerLen;
+            const float ratio = lowerLen / (lowerLen + upperLen);
+            lowerLen += ratio * diff + 0.1f;
+            upperLen += (1.0f - ratio) * diff + 0.1f;
+        }
+
+        float angle = std::acos((lowerLen * lowerLen + distance * distance - upperLen * upperLen) / (2 * lowerLen * distance));
+        if (std::isnan(angle) || std::isinf(angle)) {
+            lowerLen = upperLen = chain.fallbackLen;
+            angle = std::acos((lowerLen * lowerLen + distance * distance - upperLen * upperLen) / (2 * lowerLen * distance));
+        }
+
+        // "X" points from the target to the root, "Y" is perpendicular to "X" pointing in the pole direction
+        const IKVec3 xDir = targetToRoot.normalized();
+        const IKVec3 yDir = (chain.pole - xDir * chain.pole.dot(xDir)).normalized();
+
+        const float xDist = std::cos(angle) * lowerLen;
+        const float yDist = std::sin(angle) * lowerLen;
+        return { chain.target + xDir * xDist + yDir * yDist, upperLen, lowerLen };
+    }
+}
@@ -71,10 +71,7 @@ namespace frik
      */
     RE::NiPoint3 SmoothMovementVR::smoothedValue(const RE::NiPoint3& curPos, const RE::NiPoint3& prevPos)
     {
-        LARGE_INTEGER newTime;
-        QueryPerformanceCounter(&newTime);
-        _frameTime = min(0.05f, static_cast<float>(newTime.QuadPart - _prevTime.QuadPart) / static_cast<float>(_hpcFrequency.QuadPart));
-        _prevTime = newTime;
+        _frameTime = min(0.05f, _frameClock.lap(_lastSmoothTime));
 
         if (g_config.disableInteriorSmoothingHorizontal && f4vr::isInInternalCell()) {
             // don't smooth if in interior cell and smoothing is disabled for it
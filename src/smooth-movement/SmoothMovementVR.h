@@ -2,6 +2,7 @@
 
 #include <deque>
 
+#include "FrameClock.h"
 #include "common/CommonUtils.h"
 
 namespace frik
@@ -9,11 +10,8 @@ namespace frik
     class SmoothMovementVR
     {
     public:
-        SmoothMovementVR()
-        {
-            QueryPerformanceFrequency(&_hpcFrequency);
-            QueryPerformanceCounter(&_prevTime);
-        }
+        explicit SmoothMovementVR(const FrameClock& frameClock) :
+            _frameClock(frameClock) {}
 
         void onFrameUpdate();
 
@@ -26,8 +24,9 @@ namespace frik
         float _lastAppliedLocalX = 0;
         float _lastAppliedLocalY = 0;
 
-        LARGE_INTEGER _hpcFrequency;
-        LARGE_INTEGER _prevTime;
+        // smoothing runs from its own hook so it measures the time between its calls, not the frame update tick
+        const FrameClock& _frameClock;
+        std::chrono::steady_clock::time_point _lastSmoothTime;
         float _frameTime = 0;
     };
 }
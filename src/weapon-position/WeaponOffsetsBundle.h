@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "WeaponOffsetsLookup.h"
+#include "common/MatrixUtils.h"
+
+namespace frik
+{
+    struct WeaponOffsetsBundleKey
+    {
+        std::string weaponName;
+        bool inPA = false;
+        bool leftHanded = false;
+
+        bool operator==(const WeaponOffsetsBundleKey&) const = default;
+    };
+
+    /**
+     * All the stored offsets the weapon adjuster needs for a weapon, resolved once on weapon change.
+     * Missing offsets are empty, the adjuster applies defaults that depend on the live weapon nodes.
+     */
+    struct WeaponOffsetsBundle
+    {
+        std::optional<RE::NiTransform> weaponOffset;
+        std::optional<RE::NiMatrix3> primaryHandOffsetRot;
+        std::optional<RE::NiMatrix3> offhandOffsetRot;
+        // pre-calculated as used every frame to convert weapon vector, identity if no offhand offset
+        RE::NiMatrix3 offhandOffsetRotTransposed;
+        std::optional<RE::NiTransform> backOfHandUIOffset;
+    };
+
+    /**
+     * Build the offsets bundle of a weapon using the given "(name, mode) -> std::optional<RE::NiTransform>" lookup.
+     * Back of hand UI falls back to the empty hand offset as a global default the player adjusts once for all weapons.
+     * Depends only on the lookup so it can be tested with a fake config.
+     */
+    template <typename Lookup>
+    WeaponOffsetsBundle buildWeaponOffsetsBundle(const std::string& weaponName, const std::string& emptyHandName, Lookup&& lookup)
+    {
+        WeaponOffsetsBundle bundle;
+        bundle.weaponOffset = lookup(weaponName, WeaponOffsetsMode::Weapon);
+
+        if (const auto primaryHand = lookup(weaponName, WeaponOffsetsMode::PrimaryHand)) {
+            bundle.primaryHandOffsetRot = primaryHand->rotate;
+        }
+
+        if (const auto offhand = lookup(weaponName, WeaponOffsetsMode::OffHand)) {
+            bundle.offhandOffsetRot = offhand->rotate;
+            bundle.offhandOffsetRotTransposed = offhand->rotate.Transpose();
+        } else {
+            bundle.offhandOffsetRotTransposed = common::MatrixUtils::getIdentityMatrix();
+        }
+
+        bundle.backOfHandUIOffset = lookup(weaponName, WeaponOffsetsMode::BackOfHandUI);
+        if (!bundle.backOfHandUIOffset.has_value()) {
+            bundle.backOfHandUIOffset = lookup(emptyHandName, WeaponOffsetsMode::BackOfHandUI);
+        }
+        return bundle;
+    }
+
+    /**
+     * Small most-recently-used cache of weapon offsets bundles so swapping back to a recent weapon, or PA and handedness
+     * switches, don't look up the config again.
+     * Owned outside the weapon adjuster as it is re-created with the skeleton on PA change.
+     * All entries are dropped when the config weapon offsets version changes (save, remove, reload).
+     */
+    class WeaponOffsetsBundleCache
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 8;
+
+        /**
+         * Get the cached bundle for the key or build and cache it using "build()".
+         * The returned reference is valid until the next call.
+         */
+        template <typename Build>
+        const WeaponOffsetsBundle& get(const WeaponOffsetsBundleKey& key, const std::uint32_t version, Build&& build)
+        {
+            if (version != _version) {
+                _entries.clear();
+                _version = version;
+            }
+
+            const auto it = std::ranges::find(_entries, key, &Entry::key);
+            if (it != _entries.end()) {
+                std::rotate(_entries.begin(), it, it + 1);
+                return _entries.front().bundle;
+            }
+
+            if (_entries.size() == CAPACITY) {
+                _entries.pop_back();
+            }
+            _entries.insert(_entries.begin(), Entry{ key, build() });
+            return _entries.front().bundle;
+        }
+
+    private:
+        struct Entry
+        {
+            WeaponOffsetsBundleKey key;
+            WeaponOffsetsBundle bundle;
+        };
+
+        std::uint32_t _version = 0;
+
+        // most recently used first
+        std::vector<Entry> _entries;
+    };
+}
@@ -1,7 +1,9 @@
 #include "WeaponPositionAdjuster.h"
 
+#include "AttachedNodeCache.h"
 #include "Config.h"
 #include "FRIK.h"
+#include "FrameProfiler.h"
 #include "utils.h"
 #include "common/Quaternion.h"
 #include "f4vr/DebugDump.h"
@@ -53,6 +55,9 @@ namespace
 
 namespace frik
 {
+    // weapon forward vector change (in scope camera parent space) below which the scope camera rotation is reused
+    constexpr float SCOPE_CAMERA_MEMO_EPSILON = 0.0001f;
+
     /**
      * Enable/Disable reposition configuration mode.
      */
@@ -149,9 +154,12 @@ namespace frik
 
         handlePrimaryHandGripOffsetAdjustment(weapon);
 
-        handleScopeCameraAdjustmentByWeaponOffset(weapon);
+        {
+            FRIK_PROFILE_SCOPE(ProfileStage::WeaponScope);
+            handleScopeCameraAdjustmentByWeaponOffset(weapon);
 
-        handleBetterScopes(weapon);
+            handleBetterScopes(weapon);
+        }
 
         // update all the nodes world transforms by local transform changes recursively down the tree
         f4vr::updateTransformsDown(weapon, true);
@@ -167,67 +175,83 @@ namespace frik
      * It's either going to be a throwable object if explosive is equipped, or the node of the last equipped weapon.
      * But when the weapon node is not visible, it's transforms may not be valid so handling offset will be wrong.
      * It is MUCH safer to only handle the weapon when it's visible.
+     * The weapon name (string and grip node search) is resolved only when the weapon identity changes.
      */
     void WeaponPositionAdjuster::checkEquippedWeaponChanged(RE::NiNode* weapon)
     {
-        const auto& weaponName = f4vr::isNodeVisible(weapon) ? getEquippedWeaponNameExtended(weapon) : EMPTY_HAND;
-        const bool inPA = f4vr::isInPowerArmor();
-        if (weaponName == _currentWeapon && inPA == _currentlyInPA) {
+        const auto identity = getEquippedWeaponIdentity(weapon);
+        if (_currentWeaponIdentity == identity) {
             // no weapon change
             return;
         }
+        _currentWeaponIdentity = identity;
+
+        // weapon model may have changed, resolve scope related nodes again
+        _scopeReticleNode.reset();
+        _scopeReticleNodeResolved = false;
+        _scopeCameraRotateValid = false;
+
+        auto weaponName = identity.weaponNode ? getEquippedWeaponNameExtended(weapon) : std::string(EMPTY_HAND);
+        if (weaponName == _currentWeapon && identity.inPA == _currentlyInPA && identity.leftHanded == _currentlyLeftHanded) {
+            // same weapon re-equipped or its 3D reloaded, offsets don't change
+            return;
+        }
 
-        _currentWeapon = weaponName;
-        _currentlyInPA = inPA;
+        _currentWeapon = std::move(weaponName);
+        _currentlyInPA = identity.inPA;
+        _currentlyLeftHanded = identity.leftHanded;
         _isCurrentWeaponMelee = f4vr::isMeleeWeaponEquipped();
 
         // reset state
         _offHandGripping = false;
 
-        loadStoredOffsets(weaponName);
+        loadStoredOffsets(_currentWeapon);
+    }
+
+    /**
+     * Get the identity of the equipped weapon, weapon fields are empty if the weapon is not visible (no weapon drawn).
+     */
+    WeaponPositionAdjuster::EquippedWeaponIdentity WeaponPositionAdjuster::getEquippedWeaponIdentity(RE::NiNode* weapon)
+    {
+        EquippedWeaponIdentity identity{ .inPA = f4vr::isInPowerArmor(), .leftHanded = f4vr::isLeftHandedMode() };
+        if (f4vr::isNodeVisible(weapon)) {
+            identity.weaponData = f4vr::getEquippedWeaponData();
+            identity.weaponNode = weapon;
+            identity.weaponModel = f4vr::getFirstChild(weapon);
+        }
+        return identity;
     }
 
     /**
      * Load the stored weapon position adjustment offset for weapon and offhand.
+     * The offsets are resolved once per weapon, PA, and handedness and cached for swapping back to recent weapons.
      */
     void WeaponPositionAdjuster::loadStoredOffsets(const std::string& weaponName)
     {
-        // Load stored offsets for the new weapon
-        const auto weaponOffsetLookup = g_config.getWeaponOffsets(weaponName, WeaponOffsetsMode::Weapon, _currentlyInPA);
-        if (weaponOffsetLookup.has_value()) {
-            _weaponOffsetTransform = weaponOffsetLookup.value();
+        const WeaponOffsetsBundleKey key{ weaponName, _currentlyInPA, _currentlyLeftHanded };
+        const auto& bundle = _offsetsBundles.get(key, g_config.getWeaponOffsetsVersion(), [&] {
+            return buildWeaponOffsetsBundle(weaponName, EMPTY_HAND, [this](const std::string& name, const WeaponOffsetsMode mode) {
+                return g_config.getWeaponOffsets(name, mode, _currentlyInPA);
+            });
+        });
+
+        if (bundle.weaponOffset.has_value()) {
+            _weaponOffsetTransform = bundle.weaponOffset.value();
         } else {
             // No stored offset, use original weapon transform
             _weaponOffsetTransform = _isCurrentWeaponMelee ? WeaponPositionConfigMode::getMeleeWeaponDefaultAdjustment(_weaponOriginalTransform) : _weaponOriginalTransform;
         }
 
-        // Load stored offsets for primary hand for the new weapon
-        const auto primaryHandOffsetLookup = g_config.getWeaponOffsets(weaponName, WeaponOffsetsMode::PrimaryHand, _currentlyInPA);
-        _hasPrimaryHandOffset = primaryHandOffsetLookup.has_value();
-        if (primaryHandOffsetLookup.has_value()) {
-            _primaryHandOffsetRot = primaryHandOffsetLookup.value().rotate;
-        } else {
-            // No stored offset, use identity for no change
-            _primaryHandOffsetRot = MatrixUtils::getIdentityMatrix();
-        }
+        // No stored offset for primary hand, use identity for no change
+        _hasPrimaryHandOffset = bundle.primaryHandOffsetRot.has_value();
+        _primaryHandOffsetRot = bundle.primaryHandOffsetRot.value_or(MatrixUtils::getIdentityMatrix());
 
-        // Load stored offsets for offhand for the new weapon
-        const auto offhandOffsetLookup = g_config.getWeaponOffsets(weaponName, WeaponOffsetsMode::OffHand, _currentlyInPA);
-        if (offhandOffsetLookup.has_value()) {
-            _offhandOffsetRot = offhandOffsetLookup.value().rotate;
-        } else {
-            // No stored offset, use identity for no change
-            _offhandOffsetRot = MatrixUtils::getIdentityMatrix();
-        }
+        // No stored offset for offhand, use identity for no change
+        _offhandOffsetRot = bundle.offhandOffsetRot.value_or(MatrixUtils::getIdentityMatrix());
+        _offhandOffsetRotTransposed = bundle.offhandOffsetRotTransposed;
 
-        // Load stored offsets for back of hand UI for the new weapon
-        auto backOfHandOffsetLookup = g_config.getWeaponOffsets(_currentWeapon, WeaponOffsetsMode::BackOfHandUI, _currentlyInPA);
-        if (!backOfHandOffsetLookup.has_value()) {
-            // Use empty hand offset as a global default that the player can adjust so they won't have to adjust it for every weapon.
-            backOfHandOffsetLookup = g_config.getWeaponOffsets(EMPTY_HAND, WeaponOffsetsMode::BackOfHandUI, _currentlyInPA);
-        }
-        if (backOfHandOffsetLookup.has_value()) {
-            _backOfHandUIOffsetTransform = backOfHandOffsetLookup.value();
+        if (bundle.backOfHandUIOffset.has_value()) {
+            _backOfHandUIOffsetTransform = bundle.backOfHandUIOffset.value();
             logger::debug("Use back of hand offset Pos: ({:2.2f}, {:2.2f}, {:2.2f}), Scale: {:.3f}, InPA: {}",
                 _weaponOffsetTransform.translate.x, _weaponOffsetTransform.translate.y, _weaponOffsetTransform.translate.z, _weaponOffsetTransform.scale, _currentlyInPA);
         } else {
@@ -237,15 +261,25 @@ namespace frik
 
         logger::info("Equipped Weapon changed to '{}' (Melee:{}) (InPA:{}); HasWeaponOffset:{}, HasPrimaryHandOffset:{}, HasOffhandOffset:{}, HasBackOfHandOffset:{}",
             _currentWeapon, _isCurrentWeaponMelee, _currentlyInPA,
-            weaponOffsetLookup.has_value(), primaryHandOffsetLookup.has_value(), offhandOffsetLookup.has_value(), backOfHandOffsetLookup.has_value());
+            bundle.weaponOffset.has_value(), bundle.primaryHandOffsetRot.has_value(), bundle.offhandOffsetRot.has_value(), bundle.backOfHandUIOffset.has_value());
+    }
+
+    /**
+     * Set the offhand rotation offset and its transpose used every frame.
+     */
+    void WeaponPositionAdjuster::setOffhandOffsetRot(const RE::NiMatrix3& rot)
+    {
+        _offhandOffsetRot = rot;
+        _offhandOffsetRotTransposed = rot.Transpose();
     }
 
     /**
      * Update the vanilla scope camera node to match weapon reposition.
      * Offset is a simple adjustment of the diff between original and offset transform.
      * Rotation is calculated by using weapon forward vector and the diff between it and straight in scope camera orientation.
+     * The rotation is recalculated only if the weapon forward vector relative to the scope camera parent changed.
      */
-    void WeaponPositionAdjuster::handleScopeCameraAdjustmentByWeaponOffset(const RE::NiNode* weapon) const
+    void WeaponPositionAdjuster::handleScopeCameraAdjustmentByWeaponOffset(const RE::NiNode* weapon)
     {
         const auto scopeCamera = f4vr::getPlayerNodes()->primaryWeaponScopeCamera;
 
@@ -260,6 +294,21 @@ namespace frik
 
         if (_offHandGripping) {
             // if offhand is gripping it overrides the rotation adjustment
+            _scopeCameraRotateValid = false;
+            return;
+        }
+
+        // get the "forward" vector of the weapon (direction of the bullets)
+        const auto weaponForwardVec = RE::NiPoint3(weapon->world.rotate.entry[1][0], weapon->world.rotate.entry[1][1], weapon->world.rotate.entry[1][2]);
+
+        // the rotation depends only on the weapon forward relative to the scope camera parent
+        const auto scopeParent = scopeCamera->parent;
+        const auto weaponForwardInParent = scopeParent ? scopeParent->world.rotate * (weaponForwardVec / scopeParent->world.scale) : weaponForwardVec;
+        if (scopeParent && _scopeCameraRotateValid
+            && std::abs(weaponForwardInParent.x - _scopeCameraWeaponForward.x) < SCOPE_CAMERA_MEMO_EPSILON
+            && std::abs(weaponForwardInParent.y - _scopeCameraWeaponForward.y) < SCOPE_CAMERA_MEMO_EPSILON
+            && std::abs(weaponForwardInParent.z - _scopeCameraWeaponForward.z) < SCOPE_CAMERA_MEMO_EPSILON) {
+            scopeCamera->local.rotate = _scopeCameraRotate;
             return;
         }
 
@@ -267,14 +316,15 @@ namespace frik
         scopeCamera->local.rotate = _scopeCameraBaseMatrix;
         f4vr::updateTransforms(scopeCamera);
 
-        // get the "forward" vector of the weapon (direction of the bullets)
-        const auto weaponForwardVec = RE::NiPoint3(weapon->world.rotate.entry[1][0], weapon->world.rotate.entry[1][1], weapon->world.rotate.entry[1][2]);
-
         // Calculate the rotation adjustment using quaternion by diff between scope camera vector and straight
         Quaternion rotAdjust;
         const auto weaponForwardVecInScopeTransform = scopeCamera->world.rotate * (weaponForwardVec / scopeCamera->world.scale);
         rotAdjust.vec2Vec(weaponForwardVecInScopeTransform, RE::NiPoint3(1, 0, 0));
         scopeCamera->local.rotate = rotAdjust.getMatrix() * _scopeCameraBaseMatrix;
+
+        _scopeCameraWeaponForward = weaponForwardInParent;
+        _scopeCameraRotate = scopeCamera->local.rotate;
+        _scopeCameraRotateValid = scopeParent != nullptr;
     }
 
     /**
@@ -315,12 +365,6 @@ namespace frik
             return;
         }
 
-        if (!g_config.enableGripButtonToGrap && !g_config.enableGripButtonToLetGo) {
-            // mode 1 extra calculation for past 3 frames, annoying but only if mode 1 is in use
-            // ReSharper disable once CppExpressionWithoutSideEffects
-            isOffhandMovedFastAway();
-        }
-
         if (!isOffhandCloseToBarrel(weapon)) {
             // not close to barrel, no need to grip
             return;
@@ -386,7 +430,7 @@ namespace frik
         const auto weaponLocalVec = weapon->world.rotate * (MatrixUtils::vec3Norm(weaponToOffhandVecWorld) / weapon->world.scale);
 
         // Desired weapon forward direction after applying offhand offset
-        const auto adjustedWeaponVec = _offhandOffsetRot.Transpose() * (weaponLocalVec);
+        const auto adjustedWeaponVec = _offhandOffsetRotTransposed * weaponLocalVec;
 
         // Compute rotation from canonical forward (Y) to adjusted direction
         rotAdjust.vec2Vec(adjustedWeaponVec, RE::NiPoint3(0, 1, 0));
@@ -470,38 +514,30 @@ namespace frik
         const auto offhand2WeaponVec = getOffhandPosition() - getPrimaryHandPosition();
         const float distanceFromPrimaryHand = MatrixUtils::vec3Len(offhand2WeaponVec);
         const auto weaponLocalVec = weapon->world.rotate * (MatrixUtils::vec3Norm(offhand2WeaponVec) / weapon->world.scale);
-        const auto adjustedWeaponVec = _offhandOffsetRot.Transpose() * (weaponLocalVec);
+        const auto adjustedWeaponVec = _offhandOffsetRotTransposed * weaponLocalVec;
         const float angleDiffToWeaponVec = MatrixUtils::vec3Dot(MatrixUtils::vec3Norm(adjustedWeaponVec), RE::NiPoint3(0, 1, 0));
         return angleDiffToWeaponVec > 0.955 && distanceFromPrimaryHand > 15;
     }
 
     /**
      * Check if the offhand moved fast away in the last 3 frames.
-     * offhandFingerBonePos, bodyPos, and avgHandV are static and therefor persist between frames.
+     * Average of the per-frame difference between offhand and body (camera) movement from the skeleton bone kinematics.
      * It's a bit of weird calculation and TBH I don't know if players really use this mode...
      */
-    bool WeaponPositionAdjuster::isOffhandMovedFastAway()
+    bool WeaponPositionAdjuster::isOffhandMovedFastAway() const
     {
-        static auto bodyPos = RE::NiPoint3(0, 0, 0);
-        static auto offhandFingerBonePos = RE::NiPoint3(0, 0, 0);
-        static float avgHandV[3] = { 0.0f, 0.0f, 0.0f };
-        static int fc = 0;
-        const auto offHandBone = f4vr::isLeftHandedMode() ? "RArm_Finger31" : "LArm_Finger31";
-
-        const auto currentPos = f4vr::getCameraPosition();
-        const float handFrameMovement = MatrixUtils::vec3Len(f4vr::Skelly::getBoneWorldTransform(offHandBone).translate - offhandFingerBonePos);
-        const float bodyFrameMovement = MatrixUtils::vec3Len(currentPos - bodyPos);
-        avgHandV[fc] = abs(handFrameMovement - bodyFrameMovement);
-        fc = (fc + 1) % 3;
+        constexpr std::uint32_t FRAMES = 3;
+        const auto& kinematics = _skelly->getBoneKinematics();
+        const auto offhand = _skelly->getHandKinematics(!f4vr::isLeftHandedMode());
+        const auto camera = _skelly->getCameraKinematics();
 
         float sum = 0;
-        for (const float i : avgHandV) {
-            sum += i;
+        for (std::uint32_t i = 0; i < FRAMES; i++) {
+            const float handFrameMovement = MatrixUtils::vec3Len(kinematics.displacement(offhand, i));
+            const float bodyFrameMovement = MatrixUtils::vec3Len(kinematics.displacement(camera, i));
+            sum += std::abs(handFrameMovement - bodyFrameMovement);
         }
-        const float handV = sum / 3;
-
-        bodyPos = currentPos;
-        offhandFingerBonePos = f4vr::Skelly::getBoneWorldTransform(offHandBone).translate;
+        const float handV = sum / FRAMES;
 
         return handV > g_config.gripLetGoThreshold;
     }
@@ -535,11 +571,20 @@ namespace frik
             return;
         }
 
-        const RE::NiAVObject* scopeRet = f4vr::findAVObject(weapon, "ReticleNode");
-        if (!scopeRet) {
+        if (_scopeReticleNode && !isAttachedUnder(_scopeReticleNode.get(), weapon)) {
+            // weapon model was re-created without weapon change, the held node is no longer part of it
+            _scopeReticleNode.reset();
+            _scopeReticleNodeResolved = false;
+        }
+        if (!_scopeReticleNodeResolved) {
+            // resolve once per weapon model, most weapons don't have a reticle node
+            _scopeReticleNode.reset(f4vr::findAVObject(weapon, "ReticleNode"));
+            _scopeReticleNodeResolved = true;
+        }
+        if (!_scopeReticleNode) {
             return;
         }
-        const auto reticlePos = scopeRet->world.translate;
+        const auto reticlePos = _scopeReticleNode->world.translate;
         const auto offhandPos = getOffhandPosition();
         const auto offset = MatrixUtils::vec3Len(reticlePos - offhandPos);
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+
+#include "WeaponOffsetsBundle.h"
 #include "WeaponPositionConfigMode.h"
 #include "skeleton/Skeleton.h"
 
@@ -13,8 +16,25 @@ namespace frik
         // use as weapon name when no weapon in equipped. specifically for default back of hand UI offset.
         static constexpr auto EMPTY_HAND = "EmptyHand";
 
+        /**
+         * Pointer identity of the equipped weapon: equipping a weapon replaces the equipped weapon data, and loading the
+         * weapon 3D (equip, mod change) replaces the weapon model under the weapon node.
+         * Compared every frame with no allocation or scene graph search, the weapon name is resolved only when it changes.
+         */
+        struct EquippedWeaponIdentity
+        {
+            const void* weaponData = nullptr;
+            const RE::NiAVObject* weaponNode = nullptr;
+            const RE::NiAVObject* weaponModel = nullptr;
+            bool inPA = false;
+            bool leftHanded = false;
+
+            bool operator==(const EquippedWeaponIdentity&) const = default;
+        };
+
     public:
-        explicit WeaponPositionAdjuster(Skeleton* skelly)
+        WeaponPositionAdjuster(Skeleton* skelly, WeaponOffsetsBundleCache& offsetsBundles) :
+            _offsetsBundles(offsetsBundles)
         {
             _skelly = skelly;
 
@@ -44,17 +64,19 @@ namespace frik
         void handleThrowableWeapon();
         void handlePrimaryWeapon();
         void checkEquippedWeaponChanged(RE::NiNode* weapon);
-        void handleScopeCameraAdjustmentByWeaponOffset(const RE::NiNode* weapon) const;
+        static EquippedWeaponIdentity getEquippedWeaponIdentity(RE::NiNode* weapon);
+        void handleScopeCameraAdjustmentByWeaponOffset(const RE::NiNode* weapon);
         void checkIfOffhandIsGripping(const RE::NiNode* weapon);
         void setOffhandGripping(bool isGripping);
+        void setOffhandOffsetRot(const RE::NiMatrix3& rot);
         void handlePrimaryHandGripOffsetAdjustment(const RE::NiNode* weapon) const;
         void handleWeaponGrippingRotationAdjustment(RE::NiNode* weapon) const;
         void handleWeaponScopeCameraGrippingRotationAdjustment(const RE::NiNode* weapon, common::Quaternion rotAdjust, RE::NiPoint3 adjustedWeaponVec) const;
         bool isOffhandCloseToBarrel(const RE::NiNode* weapon) const;
-        static bool isOffhandMovedFastAway();
+        bool isOffhandMovedFastAway() const;
         RE::NiPoint3 getPrimaryHandPosition() const;
         static RE::NiPoint3 getOffhandPosition();
-        static void handleBetterScopes(RE::NiNode* weapon);
+        void handleBetterScopes(RE::NiNode* weapon);
         static void fixMuzzleFlashPosition();
         static RE::NiNode* getBackOfHandUINode();
         void debugPrintWeaponPositionData(RE::NiNode* weapon) const;
@@ -62,14 +84,29 @@ namespace frik
         // Define a basis remapping matrix to correct coordinate system for scope camera
         RE::NiMatrix3 _scopeCameraBaseMatrix;
 
+        // scope camera rotation memoized by the weapon forward vector in the scope camera parent space it's calculated from
+        RE::NiPoint3 _scopeCameraWeaponForward;
+        RE::NiMatrix3 _scopeCameraRotate;
+        bool _scopeCameraRotateValid = false;
+
+        // BetterScopesVR reticle node of the current weapon model, resolved on first use after weapon change,
+        // held by reference and verified still attached under the weapon on use as the model can be re-created
+        RE::NiPointer<RE::NiAVObject> _scopeReticleNode;
+        bool _scopeReticleNodeResolved = false;
+
         // For unknown reason my primary hand calculation is off by specific angle
         RE::NiMatrix3 _twoHandedPrimaryHandManualAdjustment;
 
         Skeleton* _skelly;
 
+        // resolved offsets of recently equipped weapons
+        WeaponOffsetsBundleCache& _offsetsBundles;
+
         // used to know if weapon changed to load saved offsets
         std::string _currentWeapon;
+        std::optional<EquippedWeaponIdentity> _currentWeaponIdentity;
         bool _currentlyInPA = false;
+        bool _currentlyLeftHanded = false;
         bool _isCurrentWeaponMelee = false;
 
         // is offhand (secondary hand) gripping the weapon barrel
@@ -88,6 +125,7 @@ namespace frik
 
         // custom offhand rotation offsets matrix
         RE::NiMatrix3 _offhandOffsetRot = RE::NiMatrix3();
+        RE::NiMatrix3 _offhandOffsetRotTransposed = RE::NiMatrix3();
 
         // custom throwable weapon transform to update
         RE::NiTransform _throwableWeaponOriginalTransform = RE::NiTransform();
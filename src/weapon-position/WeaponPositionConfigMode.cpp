@@ -243,7 +243,7 @@ namespace frik
         if (axisX != 0.f || axisY != 0.f) {
             const auto rot = MatrixUtils::getMatrixFromEulerAngles(-MatrixUtils::degreesToRads(correctAdjustmentValue(axisY, 5)), 0,
                 MatrixUtils::degreesToRads(correctAdjustmentValue(axisX, 5)));
-            _adjuster->_offhandOffsetRot = rot * _adjuster->_offhandOffsetRot;
+            _adjuster->setOffhandOffsetRot(rot * _adjuster->_offhandOffsetRot);
         }
     }
 
@@ -426,7 +426,7 @@ namespace frik
     void WeaponPositionConfigMode::resetOffhandConfig() const
     {
         f4vr::showNotification("Reset Offhand Position to Default");
-        _adjuster->_offhandOffsetRot = MatrixUtils::getIdentityMatrix();
+        _adjuster->setOffhandOffsetRot(MatrixUtils::getIdentityMatrix());
         g_config.removeWeaponOffsets(_adjuster->_currentWeapon, WeaponOffsetsMode::OffHand, _adjuster->_currentlyInPA, true);
     }
 
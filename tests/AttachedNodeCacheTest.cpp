@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "AttachedNodeCache.h"
+#include "host/HostNodeTree.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    struct ArmorTree
+    {
+        ArmorTree()
+        {
+            const auto spine = tree.add(tree.root(), "SPINE2");
+            armor = tree.add(spine, "PA_Torso");
+            pauldron = tree.add(armor, "L_Pauldron");
+        }
+
+        RE::NiNode* get()
+        {
+            return cache.get(tree.root(), [this](RE::NiNode*) { return tree.findNode(tree.root(), "L_Pauldron"); });
+        }
+
+        HostNodeTree tree;
+        HostNode* armor;
+        HostNode* pauldron;
+        AttachedNodeCache cache;
+    };
+}
+
+TEST(AttachedNodeCacheTest, IsAttachedUnder)
+{
+    HostNodeTree tree;
+    const auto child = tree.add(tree.root(), "Child");
+    const auto leaf = tree.add(child, "Leaf");
+    EXPECT_TRUE(isAttachedUnder(leaf, tree.root()));
+    EXPECT_TRUE(isAttachedUnder(leaf, child));
+    EXPECT_TRUE(isAttachedUnder(child, child));
+    EXPECT_FALSE(isAttachedUnder(child, leaf));
+    EXPECT_FALSE(isAttachedUnder(nullptr, tree.root()));
+
+    HostNodeTree::detach(child);
+    EXPECT_FALSE(isAttachedUnder(leaf, tree.root()));
+    EXPECT_TRUE(isAttachedUnder(leaf, child));
+}
+
+TEST(AttachedNodeCacheTest, SearchesOnceWhileAttached)
+{
+    ArmorTree armor;
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(armor.get(), armor.pauldron);
+    }
+    EXPECT_EQ(armor.tree.getSearchesCount(), 1u);
+}
+
+TEST(AttachedNodeCacheTest, SearchesAgainRightAwayWhenDetached)
+{
+    ArmorTree armor;
+    armor.get();
+
+    // armor piece re-created by the game, old nodes detached but alive
+    HostNodeTree::detach(armor.armor);
+    const auto newArmor = armor.tree.add(armor.tree.root(), "PA_Torso");
+    const auto newPauldron = armor.tree.add(newArmor, "L_Pauldron");
+
+    EXPECT_EQ(armor.get(), newPauldron);
+    EXPECT_EQ(armor.get(), newPauldron);
+    EXPECT_EQ(armor.tree.getSearchesCount(), 2u);
+}
+
+TEST(AttachedNodeCacheTest, RetriesMissingNodeAtLowFrequency)
+{
+    ArmorTree armor;
+    HostNodeTree::detach(armor.armor);
+
+    for (int i = 0; i < AttachedNodeCache::RETRY_SEARCH_GETS; i++) {
+        EXPECT_EQ(armor.get(), nullptr);
+    }
+    EXPECT_EQ(armor.tree.getSearchesCount(), 1u);
+
+    HostNodeTree::attach(armor.armor, armor.tree.root());
+    EXPECT_EQ(armor.get(), armor.pauldron);
+    EXPECT_EQ(armor.tree.getSearchesCount(), 2u);
+
+    armor.cache.reset();
+    EXPECT_EQ(armor.get(), armor.pauldron);
+    EXPECT_EQ(armor.tree.getSearchesCount(), 3u);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+#include "ConfigWriteBehind.h"
+
+using namespace frik;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    fs::path tempFile(const std::string& name)
+    {
+        const auto path = fs::temp_directory_path() / ("frik_write_behind_" + name);
+        fs::remove(path);
+        fs::remove(path.string() + ".tmp");
+        return path;
+    }
+
+    void writeText(const fs::path& path, const std::string& text)
+    {
+        std::ofstream(path, std::ios::trunc) << text;
+    }
+
+    std::string readText(const fs::path& path)
+    {
+        std::ifstream stream(path);
+        return { std::istreambuf_iterator(stream), std::istreambuf_iterator<char>() };
+    }
+}
+
+TEST(ConfigWriteBehindTest, CoalescesWritesOfSameKey)
+{
+    ConfigWriteBehind writeBehind(10000);
+    std::vector<int> written;
+    for (int i = 0; i < 100; i++) {
+        writeBehind.enqueue("Main:fVrScale", [&written, i] { written.push_back(i); });
+    }
+    writeBehind.enqueue("Main:PipboyScale", [&written] { written.push_back(-1); });
+    writeBehind.flush();
+
+    std::ranges::sort(written);
+    EXPECT_EQ(written, (std::vector<int>{ -1, 99 }));
+
+    // nothing left to write
+    writeBehind.flush();
+    EXPECT_EQ(written.size(), 2u);
+}
+
+TEST(ConfigWriteBehindTest, WorkerWritesAfterDebounce)
+{
+    ConfigWriteBehind writeBehind(50);
+    std::atomic<int> writes = 0;
+    writeBehind.enqueue("key", [&writes] { ++writes; });
+    writeBehind.enqueue("key", [&writes] { ++writes; });
+    EXPECT_EQ(writes, 0);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (writes == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(writes, 1);
+}
+
+TEST(ConfigWriteBehindTest, WriteNowRunsAfterPendingWritesOfSameFile)
+{
+    const auto path = tempFile("write_now.ini");
+    ConfigWriteBehind writeBehind(10000);
+    writeBehind.enqueue("Main:value", [&path] { writeText(path, "old single value"); }, path.string());
+    writeBehind.writeNow([&path] { writeText(path, "full save"); }, path.string());
+    EXPECT_EQ(readText(path), "full save");
+
+    // the pending write was executed before, flush doesn't override the full save
+    writeBehind.flush();
+    EXPECT_EQ(readText(path), "full save");
+}
+
+TEST(ConfigWriteBehindTest, WriteNowIsSerializedWithWorker)
+{
+    ConfigWriteBehind writeBehind(0);
+    std::atomic<int> concurrent = 0;
+    std::atomic<int> maxConcurrent = 0;
+    const auto write = [&] {
+        maxConcurrent = std::max(maxConcurrent.load(), ++concurrent);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --concurrent;
+    };
+    for (int i = 0; i < 50; i++) {
+        writeBehind.enqueue("key" + std::to_string(i % 5), write);
+        writeBehind.writeNow(write);
+    }
+    writeBehind.flush();
+    EXPECT_EQ(maxConcurrent, 1);
+}
+
+TEST(ConfigWriteBehindTest, DestructionDoesNotWritePending)
+{
+    std::atomic<int> writes = 0;
+    {
+        ConfigWriteBehind writeBehind(10000);
+        writeBehind.enqueue("key", [&writes] { ++writes; });
+    }
+    EXPECT_EQ(writes, 0);
+}
+
+TEST(ConfigWriteBehindTest, ReplaceFileAtomically)
+{
+    const auto path = tempFile("offsets.json");
+    writeText(path, "original");
+
+    EXPECT_TRUE(replaceFileAtomically(path.string(), [](const std::string& tempPath) {
+        // temp starts as a copy of the original
+        EXPECT_EQ(readText(tempPath), "original");
+        writeText(tempPath, "updated");
+        return true;
+    }));
+    EXPECT_EQ(readText(path), "updated");
+    EXPECT_FALSE(fs::exists(path.string() + ".tmp"));
+
+    // failed write keeps the original
+    EXPECT_FALSE(replaceFileAtomically(path.string(), [](const std::string& tempPath) {
+        writeText(tempPath, "partial");
+        return false;
+    }));
+    EXPECT_EQ(readText(path), "updated");
+    EXPECT_FALSE(fs::exists(path.string() + ".tmp"));
+
+    // crash mid-write (exception) keeps the original
+    EXPECT_THROW(replaceFileAtomically(path.string(), [](const std::string& tempPath) -> bool {
+        writeText(tempPath, "partial");
+        throw std::runtime_error("crash");
+    }), std::runtime_error);
+    EXPECT_EQ(readText(path), "updated");
+
+    // new file
+    const auto newPath = tempFile("new_offsets.json");
+    EXPECT_TRUE(replaceFileAtomically(newPath.string(), [](const std::string& tempPath) {
+        writeText(tempPath, "new");
+        return true;
+    }));
+    EXPECT_EQ(readText(newPath), "new");
+}
+
+TEST(ConfigWriteBehindTest, WatcherIgnoresOnlySelfWrites)
+{
+    const auto path = tempFile("watched.ini");
+    writeText(path, "user content");
+
+    ConfigWriteBehind writeBehind(10000);
+    // never written by us
+    EXPECT_FALSE(writeBehind.isSelfWrite(path.string()));
+
+    writeBehind.enqueue("Main:value", [&path] { writeText(path, "self write"); }, path.string());
+    EXPECT_FALSE(writeBehind.isSelfWrite(path.string()));
+    writeBehind.flush();
+    EXPECT_TRUE(writeBehind.isSelfWrite(path.string()));
+
+    // external edit after our write
+    writeText(path, "user edit after self write");
+    EXPECT_FALSE(writeBehind.isSelfWrite(path.string()));
+
+    writeBehind.writeNow([&path] { writeText(path, "full save"); }, path.string());
+    EXPECT_TRUE(writeBehind.isSelfWrite(path.string()));
+
+    // external edit with the same size, different time
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(2));
+    EXPECT_FALSE(writeBehind.isSelfWrite(path.string()));
+
+    // file removed
+    writeBehind.writeNow([&path] { writeText(path, "again"); }, path.string());
+    fs::remove(path);
+    EXPECT_FALSE(writeBehind.isSelfWrite(path.string()));
+}
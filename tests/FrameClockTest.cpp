@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "FrameClock.h"
+
+using namespace frik;
+
+TEST(FrameClockTest, FirstTickUsesDefaultFrameTime)
+{
+    FrameClock clock;
+    clock.tick();
+    EXPECT_FLOAT_EQ(clock.getFrameTime(), FrameClock::DEFAULT_FRAME_TIME);
+    EXPECT_EQ(clock.getFrameIndex(), 1u);
+}
+
+TEST(FrameClockTest, FixedStepIgnoresRealClock)
+{
+    FrameClock clock;
+    clock.setFixedStep(0.02f);
+    clock.tick();
+    clock.tick();
+    EXPECT_FLOAT_EQ(clock.getFrameTime(), 0.02f);
+
+    std::chrono::steady_clock::time_point lastLap;
+    EXPECT_FLOAT_EQ(clock.lap(lastLap), 0.02f);
+    EXPECT_FLOAT_EQ(clock.lap(lastLap), 0.02f);
+}
+
+TEST(FrameClockTest, LapIsPerConsumerAndIndependentOfTick)
+{
+    FrameClock clock;
+    std::chrono::steady_clock::time_point consumerA;
+    std::chrono::steady_clock::time_point consumerB;
+
+    EXPECT_FLOAT_EQ(clock.lap(consumerA), FrameClock::DEFAULT_FRAME_TIME);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FLOAT_EQ(clock.lap(consumerB), FrameClock::DEFAULT_FRAME_TIME);
+
+    // ticks in between don't affect the consumers delta
+    clock.tick();
+    clock.tick();
+
+    const float lapA = clock.lap(consumerA);
+    const float lapB = clock.lap(consumerB);
+    EXPECT_GE(lapA, 0.02f);
+    EXPECT_LT(lapB, lapA);
+
+    // consecutive calls of the same consumer don't double count
+    EXPECT_LT(clock.lap(consumerA), 0.01f);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <nlohmann/json.hpp>
+
+#include "WeaponOffsetsBlob.h"
+
+using namespace frik::weapon_offsets_blob;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // set by the tests CMake: the shipped JSON sources and the blob generated from them at build time
+    const fs::path JSON_DIR = FRIK_WEAPONS_OFFSETS_JSON_DIR;
+    const fs::path BLOB_PATH = FRIK_WEAPONS_OFFSETS_BLOB_PATH;
+
+    std::vector<char> readFile(const fs::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        return { std::istreambuf_iterator(stream), std::istreambuf_iterator<char>() };
+    }
+}
+
+TEST(WeaponOffsetsBlobTest, RoundTripAllShippedJsonOffsets)
+{
+    const auto blob = readFile(BLOB_PATH);
+    const View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+
+    std::set<std::string> names;
+    std::size_t filesCount = 0;
+    for (const auto& file : fs::directory_iterator(JSON_DIR)) {
+        if (file.path().extension() != ".json") {
+            continue;
+        }
+        filesCount++;
+        std::ifstream stream(file.path());
+        const auto json = nlohmann::json::parse(stream);
+        for (const auto& [name, value] : json.items()) {
+            SCOPED_TRACE(name);
+            names.insert(name);
+            const auto entry = view.find(name);
+            ASSERT_NE(entry, nullptr);
+            EXPECT_EQ(view.nameOf(*entry), name);
+            for (std::size_t i = 0; i < 12; i++) {
+                EXPECT_EQ(entry->rotation[i], value.at("rotation")[i].get<float>());
+            }
+            EXPECT_EQ(entry->translate[0], value.at("x").get<float>());
+            EXPECT_EQ(entry->translate[1], value.at("y").get<float>());
+            EXPECT_EQ(entry->translate[2], value.at("z").get<float>());
+            EXPECT_EQ(entry->scale, value.at("scale").get<float>());
+        }
+    }
+    EXPECT_GT(filesCount, 200u);
+    EXPECT_EQ(view.size(), names.size());
+}
+
+TEST(WeaponOffsetsBlobTest, EntriesSortedForBinarySearch)
+{
+    const auto blob = readFile(BLOB_PATH);
+    const View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+    for (std::size_t i = 1; i < view.size(); i++) {
+        EXPECT_LT(view.nameOf(view[i - 1]), view.nameOf(view[i]));
+    }
+    EXPECT_EQ(view.find(""), nullptr);
+    EXPECT_EQ(view.find("No Such Weapon"), nullptr);
+    EXPECT_EQ(view.find(view.nameOf(view[0]).substr(1)), nullptr);
+}
+
+TEST(WeaponOffsetsBlobTest, RejectsInvalidBlob)
+{
+    auto blob = readFile(BLOB_PATH);
+    ASSERT_GT(blob.size(), sizeof(Header));
+
+    EXPECT_FALSE(View(nullptr, 0).isValid());
+    EXPECT_FALSE(View(blob.data(), sizeof(Header) - 1).isValid());
+    EXPECT_FALSE(View(blob.data(), blob.size() - 1).isValid());
+
+    auto badVersion = blob;
+    const auto version = VERSION + 1;
+    std::memcpy(badVersion.data() + offsetof(Header, version), &version, sizeof(version));
+    EXPECT_FALSE(View(badVersion.data(), badVersion.size()).isValid());
+
+    blob[0] ^= 0xFF;
+    EXPECT_FALSE(View(blob.data(), blob.size()).isValid());
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <set>
+
+#include "WeaponOffsetsLookup.h"
+
+using namespace frik;
+
+namespace
+{
+    // set by the tests CMake: blob generated from the shipped JSON files at build time
+    const std::string BLOB_PATH = FRIK_WEAPONS_OFFSETS_BLOB_PATH;
+
+    constexpr WeaponOffsetsMode ALL_MODES[] = {
+        WeaponOffsetsMode::Weapon, WeaponOffsetsMode::PrimaryHand, WeaponOffsetsMode::OffHand, WeaponOffsetsMode::Throwable,
+        WeaponOffsetsMode::BackOfHandUI
+    };
+
+    std::vector<char> readBlob()
+    {
+        std::ifstream stream(BLOB_PATH, std::ios::binary);
+        return { std::istreambuf_iterator(stream), std::istreambuf_iterator<char>() };
+    }
+
+    RE::NiTransform makeTransform(const float x)
+    {
+        RE::NiTransform transform;
+        transform.translate = { x, 0, 0 };
+        return transform;
+    }
+}
+
+TEST(WeaponOffsetsLookupTest, ParseRoundTripAllShippedNames)
+{
+    const auto blob = readBlob();
+    const weapon_offsets_blob::View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+    EXPECT_GT(view.size(), 200u);
+
+    std::set<std::string> baseNames;
+    for (std::size_t i = 0; i < view.size(); i++) {
+        const auto fullName = view.nameOf(view[i]);
+        const auto parsed = parseWeaponNameWithMode(fullName);
+        EXPECT_FALSE(parsed.name.empty()) << fullName;
+        EXPECT_EQ(getWeaponNameWithMode(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded), fullName);
+        baseNames.emplace(parsed.name);
+    }
+
+    // every mode combination of every shipped weapon name
+    for (const auto& name : baseNames) {
+        for (const auto mode : ALL_MODES) {
+            for (const bool inPA : { false, true }) {
+                for (const bool leftHanded : { false, true }) {
+                    const auto fullName = getWeaponNameWithMode(name, mode, inPA, leftHanded);
+                    const auto parsed = parseWeaponNameWithMode(fullName);
+                    EXPECT_EQ(parsed.name, name) << fullName;
+                    EXPECT_EQ(parsed.mode, mode) << fullName;
+                    EXPECT_EQ(parsed.inPA, inPA) << fullName;
+                    EXPECT_EQ(parsed.leftHanded, leftHanded) << fullName;
+                }
+            }
+        }
+    }
+}
+
+TEST(WeaponOffsetsLookupTest, FindsAllShippedOffsets)
+{
+    const auto blob = readBlob();
+    const weapon_offsets_blob::View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+
+    WeaponOffsetsLookup lookup;
+    lookup.rebuild(view, {}, {});
+    for (std::size_t i = 0; i < view.size(); i++) {
+        const auto& entry = view[i];
+        const auto parsed = parseWeaponNameWithMode(view.nameOf(entry));
+        const auto found = lookup.find(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded);
+        ASSERT_TRUE(found.has_value()) << view.nameOf(entry);
+        EXPECT_EQ(found->translate.x, entry.translate[0]);
+        EXPECT_EQ(found->rotate.entry[2][1], entry.rotation[9]);
+        EXPECT_EQ(found->scale, entry.scale);
+    }
+}
+
+TEST(WeaponOffsetsLookupTest, CustomOverridesRemovedAndPowerArmorFallback)
+{
+    const auto blob = readBlob();
+    const weapon_offsets_blob::View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+    const auto embeddedName = std::string(view.nameOf(view[0]));
+    const auto parsed = parseWeaponNameWithMode(embeddedName);
+
+    WeaponOffsetsLookup lookup;
+    lookup.rebuild(view, {}, { { embeddedName, makeTransform(1234) }, { "Test Gun", makeTransform(1) }, { "Test Gun-offHand-PowerArmor", makeTransform(2) } });
+    EXPECT_EQ(lookup.find(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded)->translate.x, 1234);
+
+    // PA falls back to non-PA only if there are no PA offsets
+    EXPECT_EQ(lookup.find("Test Gun", WeaponOffsetsMode::Weapon, true, false)->translate.x, 1);
+    EXPECT_EQ(lookup.find("Test Gun", WeaponOffsetsMode::OffHand, true, false)->translate.x, 2);
+    EXPECT_FALSE(lookup.find("Test Gun", WeaponOffsetsMode::OffHand, false, false).has_value());
+    EXPECT_FALSE(lookup.find("Test Gun", WeaponOffsetsMode::Weapon, false, true).has_value());
+    EXPECT_FALSE(lookup.find("Test", WeaponOffsetsMode::Weapon, false, false).has_value());
+
+    lookup.rebuild(view, { embeddedName }, {});
+    EXPECT_FALSE(lookup.find(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded).has_value());
+}
+
+TEST(WeaponOffsetsLookupTest, RemoveThenResetToEmbedded)
+{
+    const auto blob = readBlob();
+    const weapon_offsets_blob::View view(blob.data(), blob.size());
+    ASSERT_TRUE(view.isValid());
+    const auto embeddedName = std::string(view.nameOf(view[0]));
+    const auto embeddedX = view[0].translate[0];
+    const auto parsed = parseWeaponNameWithMode(embeddedName);
+
+    WeaponCustomOffsets custom;
+    WeaponOffsetsLookup lookup;
+    const auto find = [&] {
+        lookup.rebuild(view, custom.embeddedRemoved(), custom.offsets());
+        return lookup.find(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded);
+    };
+
+    custom.save(embeddedName, makeTransform(1234));
+    EXPECT_EQ(find()->translate.x, 1234);
+
+    // remove without replacing hides the embedded offset as well
+    custom.remove(embeddedName, false);
+    EXPECT_FALSE(find().has_value());
+
+    // reset to embedded after the remove brings the embedded offset back
+    custom.remove(embeddedName, true);
+    ASSERT_TRUE(find().has_value());
+    EXPECT_EQ(find()->translate.x, embeddedX);
+
+    // save after remove overrides again
+    custom.remove(embeddedName, false);
+    custom.save(embeddedName, makeTransform(5));
+    EXPECT_EQ(find()->translate.x, 5);
+}
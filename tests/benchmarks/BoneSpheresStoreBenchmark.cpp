@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "skeleton/BoneSpheresStore.h"
+
+using namespace frik;
+
+namespace
+{
+    /**
+     * Bones spread around the player with moving bones every frame, the game moves all the bones every frame.
+     */
+    struct SpheresScene
+    {
+        explicit SpheresScene(const std::size_t count) :
+            bones(count)
+        {
+            std::uniform_real_distribution<float> coord(-100, 100);
+            std::uniform_real_distribution<float> radius(1, 10);
+            std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+            for (auto& bone : bones) {
+                bone.world.translate = { coord(rng), coord(rng), coord(rng) };
+                steps.emplace_back(step(rng), step(rng), step(rng));
+                store.add(&bone, radius(rng), { 0, 0, 1 }, 1);
+            }
+            store.updateCenters();
+        }
+
+        /**
+         * Move back and forth so the order along X changes a bit every frame.
+         */
+        void moveBones()
+        {
+            const float direction = frame++ % 20 < 10 ? 1.0f : -1.0f;
+            for (std::size_t i = 0; i < bones.size(); i++) {
+                bones[i].world.translate += steps[i] * direction;
+            }
+        }
+
+        std::mt19937 rng{ 1 };
+        int frame = 0;
+        std::vector<RE::NiNode> bones;
+        std::vector<RE::NiPoint3> steps;
+        BoneSpheresStore store;
+    };
+}
+
+/**
+ * Frame of the bone spheres handler: update all the centers and query both hands with the broad-phase.
+ */
+static void BM_BoneSpheresFrame(benchmark::State& state)
+{
+    SpheresScene scene(static_cast<std::size_t>(state.range(0)));
+    const std::array<RE::NiPoint3, 2> hands = { RE::NiPoint3(-20, 30, 0), RE::NiPoint3(20, 30, 0) };
+    for (auto _ : state) {
+        scene.moveBones();
+        scene.store.updateCenters();
+        std::size_t hits = 0;
+        for (const auto& hand : hands) {
+            scene.store.forEachNear(hand, 0, [&](const std::size_t i) {
+                hits += (scene.store.center(i) - hand).Length() <= scene.store.radius(i) ? 1 : 0;
+            });
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Same frame with a linear scan of all the spheres per hand, the broad-phase baseline.
+ */
+static void BM_BoneSpheresFrameLinear(benchmark::State& state)
+{
+    SpheresScene scene(static_cast<std::size_t>(state.range(0)));
+    const std::array<RE::NiPoint3, 2> hands = { RE::NiPoint3(-20, 30, 0), RE::NiPoint3(20, 30, 0) };
+    for (auto _ : state) {
+        scene.moveBones();
+        scene.store.updateCenters();
+        std::size_t hits = 0;
+        for (const auto& hand : hands) {
+            for (std::size_t i = 0; i < scene.store.size(); i++) {
+                hits += (scene.store.center(i) - hand).Length() <= scene.store.radius(i) ? 1 : 0;
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Churn of add/remove with handle lookups, Papyrus scripts register and destroy spheres at runtime.
+ */
+static void BM_BoneSpheresAddRemove(benchmark::State& state)
+{
+    SpheresScene scene(1000);
+    std::vector<std::uint32_t> handles;
+    for (std::size_t i = 0; i < scene.store.size(); i++) {
+        handles.push_back(scene.store.handle(i));
+    }
+    std::size_t next = 0;
+    for (auto _ : state) {
+        auto& handle = handles[next++ % handles.size()];
+        scene.store.remove(handle);
+        handle = scene.store.add(&scene.bones[next % scene.bones.size()], 5, {}, 1);
+        benchmark::DoNotOptimize(scene.store.indexOf(handle));
+    }
+}
+
+BENCHMARK(BM_BoneSpheresFrame)->Arg(100)->Arg(1000);
+BENCHMARK(BM_BoneSpheresFrameLinear)->Arg(100)->Arg(1000);
+BENCHMARK(BM_BoneSpheresAddRemove);
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include "skeleton/BoneTreeTransformsKernel.h"
+#include "skeleton/HostBoneTree.h"
+
+using namespace frik;
+using namespace frik::test;
+
+/**
+ * Per entry update in tree order, the kernel baseline.
+ */
+static void BM_BoneTreeNaive(benchmark::State& state)
+{
+    std::mt19937 rng(1);
+    auto [tree, positions] = makeHandsBoneTree(static_cast<int>(state.range(0)), rng);
+    for (auto _ : state) {
+        updateBoneTreeNaive(tree, positions);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(positions.size()));
+}
+
+/**
+ * Kernel update including the gather and scatter, with the SIMD (1) or scalar (0) level calculation.
+ */
+static void BM_BoneTreeKernel(benchmark::State& state)
+{
+    std::mt19937 rng(1);
+    auto [tree, positions] = makeHandsBoneTree(static_cast<int>(state.range(0)), rng);
+    BoneTreeTransformsKernel kernel;
+    kernel.setSimdEnabled(state.range(1) != 0);
+    kernel.build(&tree, positions);
+    for (auto _ : state) {
+        kernel.update(&tree);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(positions.size()));
+}
+
+// 2 hands is the game skeleton, more to see the scaling
+BENCHMARK(BM_BoneTreeNaive)->Arg(2)->Arg(16);
+BENCHMARK(BM_BoneTreeKernel)->Args({ 2, 0 })->Args({ 2, 1 })->Args({ 16, 0 })->Args({ 16, 1 });
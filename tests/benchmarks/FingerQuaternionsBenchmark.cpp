@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "host/TestMath.h"
+#include "skeleton/FingerQuaternions.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    struct HandPoses
+    {
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> openMatrices;
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> closedMatrices;
+        FingerQuaternions open;
+        FingerQuaternions closed;
+        FingerQuaternions::Weights weights{};
+
+        HandPoses()
+        {
+            std::mt19937 rng(7);
+            for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+                openMatrices[i] = randomRotation(rng, 1.0);
+                closedMatrices[i] = randomRotation(rng, 1.0);
+                open.set(i, openMatrices[i]);
+                closed.set(i, closedMatrices[i]);
+                weights[i] = static_cast<float>(i) / FingerQuaternions::LANES;
+            }
+        }
+    };
+}
+
+/**
+ * Blend of a whole hand from the precomputed pose quaternions (current hand pose update).
+ */
+static void BM_SlerpFingersBatched(benchmark::State& state)
+{
+    const HandPoses poses;
+    FingerQuaternions out;
+    for (auto _ : state) {
+        slerpFingers(poses.closed, poses.open, poses.weights, out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * FingerQuaternions::LANES);
+}
+
+BENCHMARK(BM_SlerpFingersBatched);
+
+/**
+ * Same batched blend on the scalar path, to compare with the SIMD path.
+ */
+static void BM_SlerpFingersBatchedScalar(benchmark::State& state)
+{
+    const HandPoses poses;
+    FingerQuaternions out;
+    for (auto _ : state) {
+        slerpFingers(poses.closed, poses.open, poses.weights, out, false);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * FingerQuaternions::LANES);
+}
+
+BENCHMARK(BM_SlerpFingersBatchedScalar);
+
+/**
+ * Blend of a whole hand per finger from the pose matrices (previous hand pose update): matrix to quaternion of both
+ * poses, slerp, and quaternion back to matrix for every finger.
+ */
+static void BM_SlerpPerFingerFromMatrices(benchmark::State& state)
+{
+    const HandPoses poses;
+    std::array<RE::NiMatrix3, FingerQuaternions::LANES> out;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            FingerQuaternions from;
+            FingerQuaternions to;
+            from.set(0, poses.closedMatrices[i]);
+            to.set(0, poses.openMatrices[i]);
+            FingerQuaternions::Weights t{};
+            t[0] = poses.weights[i];
+            slerpFingers(from, to, t, from);
+            out[i] = from.getMatrix(0);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * FingerQuaternions::LANES);
+}
+
+BENCHMARK(BM_SlerpPerFingerFromMatrices);
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "skeleton/HostSkeletonReplay.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    /**
+     * Replay a capture recorded in game if "FRIK_CAPTURE_FILE" env variable is set, otherwise a synthetic capture.
+     */
+    std::vector<CapturedFrame> loadFrames()
+    {
+        if (const char* path = std::getenv("FRIK_CAPTURE_FILE")) {
+            if (auto frames = readCaptureFile(path)) {
+                return std::move(frames.value());
+            }
+        }
+        return makeSyntheticCapture(900);
+    }
+}
+
+/**
+ * Full replay of the capture through the host skeleton stages including the output diff check.
+ * Arg 0 runs the optimized kernels, arg 1 the reference math.
+ */
+static void BM_FrameReplay(benchmark::State& state)
+{
+    const auto frames = loadFrames();
+    const auto pipeline = state.range(0) == 0 ? ReplayPipeline::Kernels : ReplayPipeline::Reference;
+    for (auto _ : state) {
+        FrameReplaySession session(frames);
+        HostSkeletonReplay skeleton(pipeline);
+        while (!session.isDone()) {
+            session.compareAndAdvance(skeleton.onFrameUpdate(session.getFrame()));
+        }
+        benchmark::DoNotOptimize(session.getMaxRotateDiff());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames.size()));
+}
+
+BENCHMARK(BM_FrameReplay)->Arg(0)->Arg(1);
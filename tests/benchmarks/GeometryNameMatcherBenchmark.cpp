@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "skeleton/GeometryNameMatcher.h"
+
+using namespace frik;
+
+namespace
+{
+    /**
+     * Read the non-empty lines of a shipped hide meshes list.
+     */
+    std::vector<std::string> readList(const std::string& name)
+    {
+        std::vector<std::string> list;
+        std::ifstream stream(std::string(FRIK_CONFIG_DIR) + "/" + name);
+        for (std::string line; std::getline(stream, line);) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (!line.empty()) {
+                list.push_back(line);
+            }
+        }
+        return list;
+    }
+
+    std::string toLower(std::string str)
+    {
+        std::ranges::transform(str, str.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return str;
+    }
+
+    /**
+     * Geometry names of a player in Vault 111 suit with hair, beard, and a helmet, plus a Power Armor set.
+     */
+    const std::vector<std::string> GEOMETRY_NAMES = {
+        "BaseMaleHead:0", "BaseMaleHead_faceBones:0", "MaleEyesHumanAO", "MaleEyesHuman", "MaleHeadHumanRearAO", "HairMale30:0",
+        "HairMale30Hairline:0", "BeardMale01:0", "MaleBrowsHuman:0", "BaseMaleBody:0", "MaleHands:0", "MaleHands_1stPerson:0",
+        "Vault111Suit_YanEdits:0", "Vault111Suit_YanEdits:1", "VaultNumber:0", "PipBoy_Screen:0", "PipBoy_Body:0",
+        "HelmetNeck001:0", "CombatArmorHelmet:0", "Goggles_Lens:0", "PA_T45_Torso:0", "PA_T45_LArm:0", "PA_T45_RArm:0",
+        "PA_T45_LLeg:0", "PA_T45_RLeg:0", "PA_T45_Helmet:0", "PA_T45_Helmet:1", "PA_T45_Helmet:2", "PA_T45_Helmet:3",
+        "Weapon_10mmPistol:0", "Weapon_10mmPistol_Receiver:0", "Weapon_10mmPistol_Barrel:0",
+    };
+
+    struct ShippedPatterns
+    {
+        ShippedPatterns() :
+            face(readList("mesh_hide_face.ini")),
+            skins(readList("mesh_hide_skins.ini"))
+        {
+            for (auto& pattern : face) {
+                lowerFace.push_back(toLower(pattern));
+            }
+            for (auto& pattern : skins) {
+                lowerSkins.push_back(toLower(pattern));
+            }
+        }
+
+        std::vector<std::string> face;
+        std::vector<std::string> skins;
+        std::vector<std::string> lowerFace;
+        std::vector<std::string> lowerSkins;
+    };
+
+    bool containsAnyPerPattern(const std::string& lowerName, const std::vector<std::string>& lowerPatterns)
+    {
+        return std::ranges::any_of(lowerPatterns, [&](const std::string& pattern) { return lowerName.find(pattern) != std::string::npos; });
+    }
+}
+
+/**
+ * Before: every geometry name lower-cased and searched for each face and skin pattern.
+ */
+static void BM_MatchGeometryNamesPerPattern(benchmark::State& state)
+{
+    const ShippedPatterns patterns;
+    for (auto _ : state) {
+        std::size_t hidden = 0;
+        for (const auto& name : GEOMETRY_NAMES) {
+            const auto lowerName = toLower(name);
+            hidden += containsAnyPerPattern(lowerName, patterns.lowerFace) || containsAnyPerPattern(lowerName, patterns.lowerSkins);
+        }
+        benchmark::DoNotOptimize(hidden);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * GEOMETRY_NAMES.size()));
+}
+
+/**
+ * After: every geometry name matched in a single pass by the compiled face and skin matchers.
+ */
+static void BM_MatchGeometryNamesMatcher(benchmark::State& state)
+{
+    const ShippedPatterns patterns;
+    GeometryNameMatcher faceMatcher;
+    GeometryNameMatcher skinMatcher;
+    faceMatcher.build(patterns.face);
+    skinMatcher.build(patterns.skins);
+    for (auto _ : state) {
+        std::size_t hidden = 0;
+        for (const auto& name : GEOMETRY_NAMES) {
+            hidden += faceMatcher.containsAny(name) || skinMatcher.containsAny(name);
+        }
+        benchmark::DoNotOptimize(hidden);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * GEOMETRY_NAMES.size()));
+}
+
+/**
+ * Compile of both matchers from the shipped lists, done only on hide meshes config load.
+ */
+static void BM_BuildGeometryNameMatchers(benchmark::State& state)
+{
+    const ShippedPatterns patterns;
+    for (auto _ : state) {
+        GeometryNameMatcher faceMatcher;
+        GeometryNameMatcher skinMatcher;
+        faceMatcher.build(patterns.face);
+        skinMatcher.build(patterns.skins);
+        benchmark::DoNotOptimize(faceMatcher);
+        benchmark::DoNotOptimize(skinMatcher);
+    }
+}
+
+BENCHMARK(BM_MatchGeometryNamesPerPattern);
+BENCHMARK(BM_MatchGeometryNamesMatcher);
+BENCHMARK(BM_BuildGeometryNameMatchers);
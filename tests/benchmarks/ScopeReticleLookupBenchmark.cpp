@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "AttachedNodeCache.h"
+#include "host/HostNodeTree.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    /**
+     * Synthetic weapon model of ~85 nodes: receiver, barrel, grip, magazine, and stock mods with their parts, and a
+     * BetterScopesVR scope mod with the reticle node added last so the name search walks the whole model.
+     */
+    struct WeaponScene
+    {
+        WeaponScene()
+        {
+            weapon = tree.add(tree.root(), "Weapon");
+            for (const auto mod : { "Receiver", "Barrel", "Grip", "Magazine", "Stock", "Muzzle" }) {
+                const auto modNode = tree.add(weapon, mod);
+                for (int part = 0; part < 4; part++) {
+                    const auto partNode = tree.add(modNode, std::string(mod) + "Part" + std::to_string(part));
+                    for (int i = 0; i < 2; i++) {
+                        tree.add(partNode, std::string(mod) + "Shape" + std::to_string(part * 2 + i));
+                    }
+                }
+            }
+            const auto scope = tree.add(weapon, "ScopeMod");
+            const auto scopeBody = tree.add(scope, "ScopeBody");
+            tree.add(scopeBody, "ScopeLens");
+            tree.add(scopeBody, "ScopeRing");
+            reticle = tree.add(tree.add(scopeBody, "ScopeReticle"), "ReticleNode");
+        }
+
+        HostNodeTree tree;
+        HostNode* weapon;
+        HostNode* reticle;
+    };
+}
+
+/**
+ * Before memoizing: the reticle node searched by name in the weapon model on every scope toggle check.
+ */
+static void BM_FindReticleByName(benchmark::State& state)
+{
+    WeaponScene scene;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scene.tree.findNode(scene.weapon, "ReticleNode"));
+    }
+}
+
+/**
+ * Memoized raw pointer, no check the weapon model still holds the node.
+ */
+static void BM_CachedReticleUnchecked(benchmark::State& state)
+{
+    WeaponScene scene;
+    const RE::NiAVObject* reticle = scene.tree.findNode(scene.weapon, "ReticleNode");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reticle->world.translate.x);
+    }
+}
+
+/**
+ * Memoized node held by reference and verified attached under the weapon before use.
+ */
+static void BM_CachedReticleAttachedCheck(benchmark::State& state)
+{
+    WeaponScene scene;
+    const RE::NiPointer<RE::NiAVObject> reticle(scene.tree.findNode(scene.weapon, "ReticleNode"));
+    for (auto _ : state) {
+        if (isAttachedUnder(reticle.get(), scene.weapon)) {
+            benchmark::DoNotOptimize(reticle->world.translate.x);
+        }
+    }
+}
+
+BENCHMARK(BM_FindReticleByName);
+BENCHMARK(BM_CachedReticleUnchecked);
+BENCHMARK(BM_CachedReticleAttachedCheck);
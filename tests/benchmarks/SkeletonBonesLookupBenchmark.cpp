@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include "AttachedNodeCache.h"
+#include "host/HostSkeletonScene.h"
+#include "skeleton/SkeletonBones.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    /**
+     * Touch the nodes the way the skeleton update does so the lookups aren't optimized away.
+     */
+    void touch(RE::NiNode* node)
+    {
+        if (node) {
+            node->local.translate.z += 0.001f;
+        }
+    }
+}
+
+/**
+ * Before: every skeleton bone and pauldron searched by name from the root each frame.
+ */
+static void BM_FindBonesByNamePerFrame(benchmark::State& state)
+{
+    HostSkeletonScene scene;
+    for (auto _ : state) {
+        for (const auto name : SKELETON_BONE_NAMES) {
+            touch(scene.tree.findNode(scene.tree.root(), name));
+        }
+        touch(scene.tree.findNode(scene.tree.root(), "L_Pauldron"));
+        touch(scene.tree.findNode(scene.tree.root(), "R_Pauldron"));
+    }
+}
+
+/**
+ * After: skeleton bones resolved once into the indexed table, pauldrons cached and verified attached each frame.
+ */
+static void BM_ResolvedBonesPerFrame(benchmark::State& state)
+{
+    HostSkeletonScene scene;
+    std::array<RE::NiNode*, SKELETON_BONES_COUNT> bones{};
+    for (std::size_t i = 0; i < SKELETON_BONES_COUNT; i++) {
+        bones[i] = scene.tree.findNode(scene.tree.root(), SKELETON_BONE_NAMES[i]);
+    }
+    std::array<AttachedNodeCache, 2> pauldrons;
+    for (auto _ : state) {
+        for (const auto bone : bones) {
+            touch(bone);
+        }
+        touch(pauldrons[0].get(scene.tree.root(), [&](RE::NiNode*) { return scene.tree.findNode(scene.tree.root(), "L_Pauldron"); }));
+        touch(pauldrons[1].get(scene.tree.root(), [&](RE::NiNode*) { return scene.tree.findNode(scene.tree.root(), "R_Pauldron"); }));
+    }
+}
+
+BENCHMARK(BM_FindBonesByNamePerFrame);
+BENCHMARK(BM_ResolvedBonesPerFrame);
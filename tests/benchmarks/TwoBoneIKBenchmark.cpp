@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "skeleton/TwoBoneIK.h"
+
+using namespace frik;
+
+/**
+ * Solve of a batch of reachable, stretched, and too close chains (both arms and legs are solved every frame).
+ */
+static void BM_SolveTwoBoneIK(benchmark::State& state)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(-60, 60);
+    std::vector<TwoBoneIKChain> chains;
+    for (int i = 0; i < 256; i++) {
+        chains.push_back({ { coord(rng), coord(rng), coord(rng) }, { coord(rng), coord(rng), coord(rng) }, { 0, 0, 1 }, 30, 25, 27.5f });
+    }
+
+    for (auto _ : state) {
+        for (const auto& chain : chains) {
+            benchmark::DoNotOptimize(solveTwoBoneIK(chain));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chains.size()));
+}
+
+BENCHMARK(BM_SolveTwoBoneIK);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <set>
+
+#include "WeaponOffsetsLookup.h"
+
+using namespace frik;
+
+namespace
+{
+    std::vector<char> readBlob()
+    {
+        std::ifstream stream(FRIK_WEAPONS_OFFSETS_BLOB_PATH, std::ios::binary);
+        return { std::istreambuf_iterator(stream), std::istreambuf_iterator<char>() };
+    }
+
+    struct ShippedOffsets
+    {
+        ShippedOffsets() :
+            blob(readBlob()),
+            view(blob.data(), blob.size())
+        {
+            for (std::size_t i = 0; i < view.size(); i++) {
+                baseNames.emplace(parseWeaponNameWithMode(view.nameOf(view[i])).name);
+            }
+        }
+
+        std::vector<char> blob;
+        weapon_offsets_blob::View view;
+        std::set<std::string> baseNames;
+    };
+}
+
+/**
+ * Rebuild of the lookup table from all the shipped offsets (load, and every offsets save/remove in config mode).
+ */
+static void BM_RebuildWeaponsResolvedOffsets(benchmark::State& state)
+{
+    const ShippedOffsets shipped;
+    WeaponOffsetsLookup lookup;
+    for (auto _ : state) {
+        lookup.rebuild(shipped.view, {}, {});
+        benchmark::DoNotOptimize(lookup.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(shipped.view.size()));
+}
+
+/**
+ * Lookup of every shipped weapon name in all the modes, PA and handedness combinations.
+ */
+static void BM_FindWeaponOffsetsAllModes(benchmark::State& state)
+{
+    const ShippedOffsets shipped;
+    WeaponOffsetsLookup lookup;
+    lookup.rebuild(shipped.view, {}, {});
+    int64_t lookups = 0;
+    for (auto _ : state) {
+        for (const auto& name : shipped.baseNames) {
+            for (int mode = 0; mode <= static_cast<int>(WeaponOffsetsMode::BackOfHandUI); mode++) {
+                for (const int flags : { 0, 1, 2, 3 }) {
+                    benchmark::DoNotOptimize(lookup.find(name, static_cast<WeaponOffsetsMode>(mode), flags & 2, flags & 1));
+                    lookups++;
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(lookups);
+}
+
+/**
+ * Parse and rebuild of the full names for all the shipped names.
+ */
+static void BM_WeaponNameWithModeRoundTrip(benchmark::State& state)
+{
+    const ShippedOffsets shipped;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < shipped.view.size(); i++) {
+            const auto parsed = parseWeaponNameWithMode(shipped.view.nameOf(shipped.view[i]));
+            benchmark::DoNotOptimize(getWeaponNameWithMode(parsed.name, parsed.mode, parsed.inPA, parsed.leftHanded));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(shipped.view.size()));
+}
+
+BENCHMARK(BM_RebuildWeaponsResolvedOffsets);
+BENCHMARK(BM_FindWeaponOffsetsAllModes);
+BENCHMARK(BM_WeaponNameWithModeRoundTrip);
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <string_view>
+
+namespace frik::test
+{
+    /**
+     * Stand-in scene graph node with the name and children the game nodes have.
+     */
+    struct HostNode : RE::NiNode
+    {
+        std::string name;
+        std::vector<HostNode*> children;
+    };
+
+    /**
+     * Stand-in scene graph owning its nodes, with the recursive name search the game utils do (f4vr::findNode) and
+     * counting the searches so tests can check steady state code does none.
+     */
+    class HostNodeTree
+    {
+    public:
+        HostNodeTree() :
+            _root(create("Root")) {}
+
+        HostNode* root() const { return _root; }
+
+        HostNode* add(HostNode* parent, const std::string_view name)
+        {
+            const auto node = create(name);
+            attach(node, parent);
+            return node;
+        }
+
+        static void attach(HostNode* node, HostNode* parent)
+        {
+            node->parent = parent;
+            parent->children.push_back(node);
+        }
+
+        /**
+         * Remove the node and its sub-tree from its parent, the nodes stay alive as held game nodes do.
+         */
+        static void detach(HostNode* node)
+        {
+            auto& siblings = static_cast<HostNode*>(node->parent)->children;
+            siblings.erase(std::ranges::find(siblings, node));
+            node->parent = nullptr;
+        }
+
+        HostNode* findNode(HostNode* root, const std::string_view name)
+        {
+            _searchesCount++;
+            return findNodeRecursive(root, name);
+        }
+
+        std::size_t getSearchesCount() const { return _searchesCount; }
+
+    private:
+        HostNode* create(const std::string_view name)
+        {
+            auto& node = _nodes.emplace_back();
+            node.name = name;
+            return &node;
+        }
+
+        static HostNode* findNodeRecursive(HostNode* node, const std::string_view name)
+        {
+            if (node->name == name) {
+                return node;
+            }
+            for (const auto child : node->children) {
+                if (const auto found = findNodeRecursive(child, name)) {
+                    return found;
+                }
+            }
+            return nullptr;
+        }
+
+        std::deque<HostNode> _nodes;
+        HostNode* _root;
+        std::size_t _searchesCount = 0;
+    };
+}
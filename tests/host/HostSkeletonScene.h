@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "host/HostNodeTree.h"
+
+namespace frik::test
+{
+    /**
+     * Synthetic player skeleton of ~150 nodes: the bones the skeleton update uses at their usual depth, the fingers,
+     * twist and helper bones, and Power Armor pieces with the pauldrons, so searches and updates walk a realistic tree.
+     */
+    struct HostSkeletonScene
+    {
+        HostSkeletonScene()
+        {
+            const auto camera = tree.add(tree.root(), "Camera");
+            const auto com = tree.add(camera, "COM");
+            const auto pelvis = tree.add(com, "Pelvis");
+            for (const auto side : { "L", "R" }) {
+                auto parent = pelvis;
+                for (const auto bone : { "Leg_Thigh", "Leg_Calf", "Leg_Foot", "Leg_Toe1" }) {
+                    parent = tree.add(parent, std::string(side) + bone);
+                    addHelpers(parent, 3);
+                }
+            }
+            const auto spine1 = tree.add(com, "SPINE1");
+            const auto spine2 = tree.add(spine1, "SPINE2");
+            const auto chest = tree.add(spine2, "Chest");
+            const auto neck = tree.add(chest, "Neck");
+            addHelpers(tree.add(neck, "Head"), 10);
+            for (const auto side : { "L", "R" }) {
+                auto parent = tree.add(chest, std::string(side) + "Arm_Collarbone");
+                for (const auto bone : { "Arm_UpperArm", "Arm_UpperTwist1", "Arm_ForeArm1", "Arm_ForeArm2", "Arm_ForeArm3", "Arm_Hand" }) {
+                    parent = tree.add(parent, std::string(side) + bone);
+                    addHelpers(parent, 2);
+                }
+                for (int finger = 1; finger <= 5; finger++) {
+                    auto joint = parent;
+                    for (int i = 1; i <= 3; i++) {
+                        joint = tree.add(joint, std::string(side) + "Arm_Finger" + std::to_string(finger * 10 + i));
+                    }
+                }
+            }
+            // Power Armor pieces are added after the skeleton bones, the pauldrons are the deepest name search
+            const auto armor = tree.add(tree.root(), "PowerArmor");
+            for (const auto piece : { "Torso", "Helmet", "LArm", "RArm", "LLeg", "RLeg" }) {
+                addHelpers(tree.add(armor, std::string("PA_") + piece), 4);
+            }
+            tree.add(armor, "L_Pauldron");
+            tree.add(armor, "R_Pauldron");
+        }
+
+        HostNode* find(const std::string_view name) { return tree.findNode(tree.root(), name); }
+
+        /**
+         * Count the nodes in the node subtree including the node itself.
+         */
+        static std::uint32_t countNodes(const HostNode* node)
+        {
+            std::uint32_t count = 1;
+            for (const auto child : node->children) {
+                count += countNodes(child);
+            }
+            return count;
+        }
+
+        HostNodeTree tree;
+
+    private:
+        void addHelpers(HostNode* parent, const int count)
+        {
+            for (int i = 0; i < count; i++) {
+                tree.add(parent, "Helper" + std::to_string(_helpersCount++));
+            }
+        }
+
+        int _helpersCount = 0;
+    };
+}
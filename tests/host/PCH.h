@@ -0,0 +1,155 @@
+#pragma once
+
+/**
+ * Host (off-target) replacement of src/PCH.h for the unit tests.
+ * Only the minimal subset of the game types used by the portable code under test, with the same layout and operators
+ * semantics as CommonLibF4, so the tested code compiles unchanged.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace RE
+{
+    class NiPoint3
+    {
+    public:
+        constexpr NiPoint3() noexcept = default;
+
+        constexpr NiPoint3(const float x, const float y, const float z) noexcept :
+            x(x), y(y), z(z) {}
+
+        constexpr NiPoint3 operator+(const NiPoint3& other) const noexcept { return { x + other.x, y + other.y, z + other.z }; }
+        constexpr NiPoint3 operator-(const NiPoint3& other) const noexcept { return { x - other.x, y - other.y, z - other.z }; }
+        constexpr NiPoint3 operator*(const float scalar) const noexcept { return { x * scalar, y * scalar, z * scalar }; }
+        constexpr NiPoint3 operator/(const float scalar) const noexcept { return { x / scalar, y / scalar, z / scalar }; }
+        constexpr NiPoint3 operator-() const noexcept { return { -x, -y, -z }; }
+
+        constexpr NiPoint3& operator+=(const NiPoint3& other) noexcept { return *this = *this + other; }
+        constexpr NiPoint3& operator-=(const NiPoint3& other) noexcept { return *this = *this - other; }
+        constexpr NiPoint3& operator*=(const float scalar) noexcept { return *this = *this * scalar; }
+        constexpr NiPoint3& operator/=(const float scalar) noexcept { return *this = *this / scalar; }
+
+        constexpr bool operator==(const NiPoint3&) const noexcept = default;
+
+        [[nodiscard]] float Length() const noexcept { return std::sqrt(x * x + y * y + z * z); }
+
+        float x = 0;
+        float y = 0;
+        float z = 0;
+    };
+
+    class NiMatrix3
+    {
+    public:
+        constexpr NiMatrix3() noexcept = default;
+
+        [[nodiscard]] constexpr NiMatrix3 Transpose() const noexcept
+        {
+            NiMatrix3 result;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    result.entry[r][c] = entry[c][r];
+                }
+            }
+            return result;
+        }
+
+        constexpr NiMatrix3 operator*(const NiMatrix3& other) const noexcept
+        {
+            NiMatrix3 result;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    result.entry[r][c] = entry[r][0] * other.entry[0][c] + entry[r][1] * other.entry[1][c] + entry[r][2] * other.entry[2][c];
+                }
+            }
+            return result;
+        }
+
+        constexpr NiPoint3 operator*(const NiPoint3& point) const noexcept
+        {
+            return {
+                entry[0][0] * point.x + entry[0][1] * point.y + entry[0][2] * point.z,
+                entry[1][0] * point.x + entry[1][1] * point.y + entry[1][2] * point.z,
+                entry[2][0] * point.x + entry[2][1] * point.y + entry[2][2] * point.z
+            };
+        }
+
+        float entry[3][4]{};
+    };
+
+    class NiTransform
+    {
+    public:
+        NiMatrix3 rotate;
+        NiPoint3 translate;
+        float scale = 1.0f;
+    };
+
+    class NiNode;
+
+    class NiAVObject
+    {
+    public:
+        virtual ~NiAVObject() = default;
+
+        virtual NiNode* IsNode() { return nullptr; }
+
+        NiNode* parent = nullptr;
+        NiTransform local;
+        NiTransform world;
+    };
+
+    class NiNode : public NiAVObject
+    {
+    public:
+        NiNode* IsNode() override { return this; }
+    };
+
+    /**
+     * Non-owning stand-in of the game ref-counted smart pointer, host nodes are owned by the test.
+     */
+    template <typename T>
+    class NiPointer
+    {
+    public:
+        constexpr NiPointer() noexcept = default;
+
+        constexpr explicit NiPointer(T* ptr) noexcept :
+            _ptr(ptr) {}
+
+        [[nodiscard]] constexpr T* get() const noexcept { return _ptr; }
+        constexpr void reset(T* ptr = nullptr) noexcept { _ptr = ptr; }
+        constexpr explicit operator bool() const noexcept { return _ptr != nullptr; }
+        constexpr T* operator->() const noexcept { return _ptr; }
+
+    private:
+        T* _ptr = nullptr;
+    };
+}
+
+/**
+ * Logging is a no-op on host, tests assert on behavior not on log output.
+ */
+namespace logger
+{
+    template <typename... Args>
+    void trace(Args&&...) {}
+
+    template <typename... Args>
+    void debug(Args&&...) {}
+
+    template <typename... Args>
+    void info(Args&&...) {}
+
+    template <typename... Args>
+    void warn(Args&&...) {}
+
+    template <typename... Args>
+    void error(Args&&...) {}
+}
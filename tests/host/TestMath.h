@@ -0,0 +1,139 @@
+#pragma once
+
+#include <random>
+
+/**
+ * Reference math used to check the optimized FRIK code, written for clarity in double precision.
+ */
+namespace frik::test
+{
+    /**
+     * Rotation matrix of "angle" radians around the (not necessarily normalized) axis (Rodrigues formula).
+     */
+    inline RE::NiMatrix3 axisAngleMatrix(double ax, double ay, double az, const double angle)
+    {
+        const double len = std::sqrt(ax * ax + ay * ay + az * az);
+        ax /= len;
+        ay /= len;
+        az /= len;
+        const double c = std::cos(angle);
+        const double s = std::sin(angle);
+        const double t = 1 - c;
+
+        RE::NiMatrix3 m;
+        m.entry[0][0] = static_cast<float>(t * ax * ax + c);
+        m.entry[0][1] = static_cast<float>(t * ax * ay - s * az);
+        m.entry[0][2] = static_cast<float>(t * ax * az + s * ay);
+        m.entry[1][0] = static_cast<float>(t * ax * ay + s * az);
+        m.entry[1][1] = static_cast<float>(t * ay * ay + c);
+        m.entry[1][2] = static_cast<float>(t * ay * az - s * ax);
+        m.entry[2][0] = static_cast<float>(t * ax * az - s * ay);
+        m.entry[2][1] = static_cast<float>(t * ay * az + s * ax);
+        m.entry[2][2] = static_cast<float>(t * az * az + c);
+        return m;
+    }
+
+    inline RE::NiMatrix3 randomRotation(std::mt19937& rng, const double maxAngle = 3.1)
+    {
+        std::uniform_real_distribution<double> axis(-1, 1);
+        std::uniform_real_distribution<double> angle(-maxAngle, maxAngle);
+        double x, y, z;
+        do {
+            x = axis(rng);
+            y = axis(rng);
+            z = axis(rng);
+        } while (x * x + y * y + z * z < 0.01);
+        return axisAngleMatrix(x, y, z, angle(rng));
+    }
+
+    inline float maxMatrixDiff(const RE::NiMatrix3& a, const RE::NiMatrix3& b)
+    {
+        float diff = 0;
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                diff = std::max(diff, std::abs(a.entry[r][c] - b.entry[r][c]));
+            }
+        }
+        return diff;
+    }
+
+    /**
+     * Single quaternion slerp the way the per-finger code did it (matrix -> quaternion, slerp, quaternion -> matrix).
+     * Uses the orthonormal basis formulation (independent of the sin ratio one under test) that supports extrapolation.
+     */
+    struct ReferenceQuaternion
+    {
+        double x = 0, y = 0, z = 0, w = 1;
+
+        static ReferenceQuaternion fromMatrix(const RE::NiMatrix3& rot)
+        {
+            const auto& m = rot.entry;
+            ReferenceQuaternion q;
+            const double trace = m[0][0] + m[1][1] + m[2][2];
+            if (trace > 0) {
+                const double s = std::sqrt(trace + 1.0) * 2;
+                q.w = 0.25 * s;
+                q.x = (m[2][1] - m[1][2]) / s;
+                q.y = (m[0][2] - m[2][0]) / s;
+                q.z = (m[1][0] - m[0][1]) / s;
+            } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+                const double s = std::sqrt(1.0 + m[0][0] - m[1][1] - m[2][2]) * 2;
+                q.w = (m[2][1] - m[1][2]) / s;
+                q.x = 0.25 * s;
+                q.y = (m[0][1] + m[1][0]) / s;
+                q.z = (m[0][2] + m[2][0]) / s;
+            } else if (m[1][1] > m[2][2]) {
+                const double s = std::sqrt(1.0 + m[1][1] - m[0][0] - m[2][2]) * 2;
+                q.w = (m[0][2] - m[2][0]) / s;
+                q.x = (m[0][1] + m[1][0]) / s;
+                q.y = 0.25 * s;
+                q.z = (m[1][2] + m[2][1]) / s;
+            } else {
+                const double s = std::sqrt(1.0 + m[2][2] - m[0][0] - m[1][1]) * 2;
+                q.w = (m[1][0] - m[0][1]) / s;
+                q.x = (m[0][2] + m[2][0]) / s;
+                q.y = (m[1][2] + m[2][1]) / s;
+                q.z = 0.25 * s;
+            }
+            return q;
+        }
+
+        RE::NiMatrix3 getMatrix() const
+        {
+            RE::NiMatrix3 rot;
+            rot.entry[0][0] = static_cast<float>(1 - 2 * (y * y + z * z));
+            rot.entry[0][1] = static_cast<float>(2 * (x * y - z * w));
+            rot.entry[0][2] = static_cast<float>(2 * (x * z + y * w));
+            rot.entry[1][0] = static_cast<float>(2 * (x * y + z * w));
+            rot.entry[1][1] = static_cast<float>(1 - 2 * (x * x + z * z));
+            rot.entry[1][2] = static_cast<float>(2 * (y * z - x * w));
+            rot.entry[2][0] = static_cast<float>(2 * (x * z - y * w));
+            rot.entry[2][1] = static_cast<float>(2 * (y * z + x * w));
+            rot.entry[2][2] = static_cast<float>(1 - 2 * (x * x + y * y));
+            return rot;
+        }
+
+        ReferenceQuaternion slerp(ReferenceQuaternion to, const double t) const
+        {
+            double dot = x * to.x + y * to.y + z * to.z + w * to.w;
+            if (dot < 0) {
+                to = { -to.x, -to.y, -to.z, -to.w };
+                dot = -dot;
+            }
+            ReferenceQuaternion r;
+            if (dot > 0.9999) {
+                r = { x + t * (to.x - x), y + t * (to.y - y), z + t * (to.z - z), w + t * (to.w - w) };
+            } else {
+                // "to" component orthogonal to "this"
+                ReferenceQuaternion ortho{ to.x - x * dot, to.y - y * dot, to.z - z * dot, to.w - w * dot };
+                const double orthoLen = std::sqrt(ortho.x * ortho.x + ortho.y * ortho.y + ortho.z * ortho.z + ortho.w * ortho.w);
+                const double theta = std::acos(dot) * t;
+                const double c = std::cos(theta);
+                const double s = std::sin(theta) / orthoLen;
+                r = { x * c + ortho.x * s, y * c + ortho.y * s, z * c + ortho.z * s, w * c + ortho.w * s };
+            }
+            const double len = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+            return { r.x / len, r.y / len, r.z / len, r.w / len };
+        }
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * Host stand-in of the framework matrix utils, only the functions used by the portable code under test.
+ */
+namespace common
+{
+    class MatrixUtils
+    {
+    public:
+        static RE::NiMatrix3 getIdentityMatrix()
+        {
+            RE::NiMatrix3 identity;
+            identity.entry[0][0] = 1;
+            identity.entry[1][1] = 1;
+            identity.entry[2][2] = 1;
+            return identity;
+        }
+    };
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "host/HostNodeTree.h"
+#include "pipboy/PipboyNodes.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    HostNode* findHostNode(HostNode* node, const std::string_view name)
+    {
+        if (node->name == name) {
+            return node;
+        }
+        for (const auto child : node->children) {
+            if (const auto found = findHostNode(child, name)) {
+                return found;
+            }
+        }
+        return nullptr;
+    }
+
+    const PipboyNodesScene HOST_SCENE = {
+        .findNode = [](RE::NiAVObject* root, const char* name, bool) -> RE::NiAVObject* {
+            return findHostNode(static_cast<HostNode*>(root), name);
+        },
+        .getFirstChild = [](RE::NiNode* node) -> RE::NiAVObject* {
+            const auto& children = static_cast<HostNode*>(node)->children;
+            return children.empty() ? nullptr : children.front();
+        }
+    };
+
+    /**
+     * Both arms with the Pipboy bone on the left forearm, the Pipboy model on the bone, and the model controls in a
+     * sub-tree of the model that can be replaced without changing the model itself.
+     */
+    struct ArmTree
+    {
+        ArmTree()
+        {
+            const auto leftShoulder = tree.add(tree.root(), "LArm_Collarbone");
+            const auto rightShoulder = tree.add(tree.root(), "RArm_Collarbone");
+            arm = tree.add(leftShoulder, "LArm_ForeArm3");
+            const auto pipboyBone = tree.add(arm, "PipboyBone");
+            model = tree.add(pipboyBone, "PipboyModel");
+            controls = addControls();
+            tree.add(leftShoulder, "LArm_Hand");
+            tree.add(rightShoulder, "RArm_Hand");
+            roots = { .arm = arm, .leftShoulder = leftShoulder, .rightShoulder = rightShoulder };
+        }
+
+        HostNode* addControls()
+        {
+            const auto node = tree.add(model, "Controls");
+            for (std::size_t i = 1; i < static_cast<std::size_t>(PipboyNode::LeftHand); i++) {
+                tree.add(node, PIPBOY_NODE_NAMES[i]);
+            }
+            return node;
+        }
+
+        HostNodeTree tree;
+        HostNode* arm;
+        HostNode* model;
+        HostNode* controls;
+        PipboyNodesRoots roots;
+    };
+}
+
+TEST(PipboyNodesTest, ResolvesAllNodes)
+{
+    ArmTree arm;
+    PipboyNodes nodes(HOST_SCENE);
+    const auto lookups = PipboyNodes::getNameLookupsCount();
+    nodes.update(arm.roots);
+
+    EXPECT_EQ(PipboyNodes::getNameLookupsCount() - lookups, PIPBOY_NODES_COUNT);
+    for (std::size_t i = 0; i < PIPBOY_NODES_COUNT; i++) {
+        const auto node = nodes.get(static_cast<PipboyNode>(i));
+        ASSERT_NE(node, nullptr) << PIPBOY_NODE_NAMES[i];
+        EXPECT_EQ(static_cast<HostNode*>(node)->name, PIPBOY_NODE_NAMES[i]);
+    }
+    EXPECT_EQ(nodes.get(PipboyNode::PowerDetect)->parent, arm.controls);
+}
+
+TEST(PipboyNodesTest, NoLookupsInSteadyState)
+{
+    ArmTree arm;
+    PipboyNodes nodes(HOST_SCENE);
+    nodes.update(arm.roots);
+
+    const auto lookups = PipboyNodes::getNameLookupsCount();
+    for (int i = 0; i < 1000; i++) {
+        nodes.update(arm.roots);
+    }
+    EXPECT_EQ(PipboyNodes::getNameLookupsCount(), lookups);
+}
+
+TEST(PipboyNodesTest, DetachedSubtreeResolvesOnce)
+{
+    ArmTree arm;
+    PipboyNodes nodes(HOST_SCENE);
+    nodes.update(arm.roots);
+
+    // replace the controls under the same model, caught by the attached check, not the fingerprint
+    HostNodeTree::detach(arm.controls);
+    const auto controls = arm.addControls();
+    const auto lookups = PipboyNodes::getNameLookupsCount();
+    for (int i = 0; i < 1000; i++) {
+        nodes.update(arm.roots);
+    }
+
+    EXPECT_EQ(PipboyNodes::getNameLookupsCount() - lookups, PIPBOY_NODES_COUNT);
+    EXPECT_EQ(nodes.get(PipboyNode::PowerDetect)->parent, controls);
+}
+
+TEST(PipboyNodesTest, PipboyArmChangeResolvesOnce)
+{
+    ArmTree arm;
+    PipboyNodes nodes(HOST_SCENE);
+    nodes.update(arm.roots);
+
+    const auto lookups = PipboyNodes::getNameLookupsCount();
+    nodes.update({ .arm = arm.tree.root(), .leftShoulder = arm.roots.leftShoulder, .rightShoulder = arm.roots.rightShoulder });
+    EXPECT_EQ(PipboyNodes::getNameLookupsCount() - lookups, PIPBOY_NODES_COUNT);
+
+    nodes.update(arm.roots);
+    EXPECT_EQ(PipboyNodes::getNameLookupsCount() - lookups, 2 * PIPBOY_NODES_COUNT);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "skeleton/BoneKinematics.h"
+
+using namespace frik;
+
+namespace
+{
+    // uneven frame times, as with reprojection and hitches
+    const std::vector<float> FRAME_TIMES = { 1 / 90.0f, 1 / 45.0f, 1 / 90.0f, 1 / 60.0f, 1 / 30.0f, 1 / 90.0f, 1 / 72.0f };
+
+    /**
+     * Push the samples of the trajectory "x = position(t)" at the given frame times (first sample at t = 0).
+     */
+    void pushTrajectory(BoneKinematics& kinematics, const BoneKinematics::Handle handle, const std::vector<float>& frameTimes,
+        const std::function<double(double)>& position)
+    {
+        double time = 0;
+        kinematics.push(handle, { static_cast<float>(position(time)), 0, 0 }, 0);
+        for (const auto frameTime : frameTimes) {
+            time += frameTime;
+            kinematics.push(handle, { static_cast<float>(position(time)), 0, 0 }, frameTime);
+        }
+    }
+}
+
+TEST(BoneKinematicsTest, EstimatesAreZeroUntilEnoughSamples)
+{
+    BoneKinematics kinematics;
+    const auto handle = kinematics.addTrack();
+    const std::vector<float> frameTimes = { 0.1f, 0.1f };
+    pushTrajectory(kinematics, handle, frameTimes, [](const double t) { return t * t * t; });
+
+    EXPECT_EQ(kinematics.samplesCount(handle), 3u);
+    EXPECT_NE(kinematics.velocity(handle).x, 0);
+    EXPECT_NE(kinematics.acceleration(handle).x, 0);
+    EXPECT_EQ(kinematics.acceleration(handle, 1).x, 0);
+    EXPECT_EQ(kinematics.jerk(handle).x, 0);
+    EXPECT_EQ(kinematics.position(handle, 3).x, 0);
+}
+
+TEST(BoneKinematicsTest, ConstantVelocity)
+{
+    BoneKinematics kinematics;
+    const auto handle = kinematics.addTrack();
+    pushTrajectory(kinematics, handle, FRAME_TIMES, [](const double t) { return 3 + 40 * t; });
+
+    for (std::uint32_t i = 0; i < 4; i++) {
+        EXPECT_NEAR(kinematics.velocity(handle, i).x, 40, 1e-2) << i;
+        EXPECT_NEAR(kinematics.acceleration(handle, i).x, 0, 1) << i;
+    }
+    EXPECT_NEAR(kinematics.jerk(handle).x, 0, 100);
+    EXPECT_NEAR(kinematics.displacement(handle).x, 40 * FRAME_TIMES.back(), 1e-4);
+}
+
+TEST(BoneKinematicsTest, ConstantAccelerationWithUnevenFrameTimes)
+{
+    BoneKinematics kinematics;
+    const auto handle = kinematics.addTrack();
+    pushTrajectory(kinematics, handle, FRAME_TIMES, [](const double t) { return 5 * t + 0.5 * 300 * t * t; });
+
+    // second order divided difference is exact for a quadratic at any spacing
+    for (std::uint32_t i = 0; i < 4; i++) {
+        EXPECT_NEAR(kinematics.acceleration(handle, i).x, 300, 1) << i;
+    }
+    EXPECT_NEAR(kinematics.jerk(handle).x, 0, 100);
+}
+
+TEST(BoneKinematicsTest, JerkUsesTimeBetweenAccelerationCenters)
+{
+    // Trajectory whose frame velocities are "c^2 / 2" at each frame mid-point c, so the accelerations are exactly
+    // their center times and the jerk is exactly 1 only if the time between the centers is used.
+    std::vector<double> times = { 0 };
+    for (const auto frameTime : FRAME_TIMES) {
+        times.push_back(times.back() + frameTime);
+    }
+    BoneKinematics kinematics;
+    const auto handle = kinematics.addTrack();
+    double x = 0;
+    kinematics.push(handle, { 0, 0, 0 }, 0);
+    for (std::size_t i = 0; i < FRAME_TIMES.size(); i++) {
+        const double center = (times[i] + times[i + 1]) / 2;
+        x += center * center / 2 * FRAME_TIMES[i];
+        kinematics.push(handle, { static_cast<float>(x), 0, 0 }, FRAME_TIMES[i]);
+    }
+
+    const double acceleration0 = (times[times.size() - 1] + 2 * times[times.size() - 2] + times[times.size() - 3]) / 4;
+    EXPECT_NEAR(kinematics.acceleration(handle).x, acceleration0, 1e-2);
+    EXPECT_NEAR(kinematics.jerk(handle).x, 1, 0.05);
+}
+
+TEST(BoneKinematicsTest, UniformCubicJerk)
+{
+    BoneKinematics kinematics;
+    const auto handle = kinematics.addTrack();
+    const std::vector<float> frameTimes(BoneKinematics::HISTORY_SIZE, 0.05f);
+    pushTrajectory(kinematics, handle, frameTimes, [](const double t) { return 10 * t * t * t; });
+
+    EXPECT_NEAR(kinematics.jerk(handle).x, 60, 0.5);
+}
+
+TEST(BoneKinematicsTest, HistoryWrapsAndResets)
+{
+    BoneKinematics kinematics;
+    const auto first = kinematics.addTrack();
+    const auto second = kinematics.addTrack();
+    for (int i = 0; i < 20; i++) {
+        kinematics.push(first, { static_cast<float>(i), 0, 0 }, 0.1f);
+    }
+    kinematics.push(second, { 1, 2, 3 }, 0.1f);
+
+    EXPECT_EQ(kinematics.samplesCount(first), BoneKinematics::HISTORY_SIZE);
+    EXPECT_EQ(kinematics.position(first).x, 19);
+    EXPECT_EQ(kinematics.position(first, BoneKinematics::HISTORY_SIZE - 1).x, 20 - static_cast<float>(BoneKinematics::HISTORY_SIZE));
+    EXPECT_EQ(kinematics.position(first, BoneKinematics::HISTORY_SIZE).x, 0);
+    EXPECT_NEAR(kinematics.velocity(first, BoneKinematics::HISTORY_SIZE - 2).x, 10, 1e-4);
+    EXPECT_EQ(kinematics.velocity(first, BoneKinematics::HISTORY_SIZE - 1).x, 0);
+    EXPECT_EQ(kinematics.position(second).y, 2);
+
+    kinematics.resetHistory();
+    EXPECT_EQ(kinematics.samplesCount(first), 0u);
+    EXPECT_EQ(kinematics.samplesCount(second), 0u);
+    EXPECT_EQ(kinematics.velocity(first).x, 0);
+}
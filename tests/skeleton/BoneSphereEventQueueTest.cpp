@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "skeleton/BoneSphereEventQueue.h"
+
+using namespace frik;
+
+namespace
+{
+    std::vector<BoneSphereQueuedEvent> flushAll(BoneSphereEventQueue& queue, const std::size_t maxEvents = 0)
+    {
+        std::vector<BoneSphereQueuedEvent> events;
+        queue.flush(maxEvents, [&](const BoneSphereQueuedEvent& evt) { events.push_back(evt); });
+        return events;
+    }
+
+    bool isEvent(const BoneSphereQueuedEvent& evt, const BoneSphereEvent event, const std::uint32_t handle, const std::uint32_t device)
+    {
+        return evt.event == event && evt.handle == handle && evt.device == device;
+    }
+}
+
+TEST(BoneSphereEventQueueTest, EnterThenExitCancels)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    queue.push(BoneSphereEvent::Exit, 1, 0);
+    EXPECT_EQ(queue.pending(), 0u);
+    EXPECT_TRUE(flushAll(queue).empty());
+}
+
+TEST(BoneSphereEventQueueTest, ExitThenEnterIsKept)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Exit, 1, 0);
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    const auto events = flushAll(queue);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_TRUE(isEvent(events[0], BoneSphereEvent::Exit, 1, 0));
+    EXPECT_TRUE(isEvent(events[1], BoneSphereEvent::Enter, 1, 0));
+}
+
+TEST(BoneSphereEventQueueTest, DuplicateEventIsDropped)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    queue.push(BoneSphereEvent::Enter, 2, 0);
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    const auto events = flushAll(queue);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_TRUE(isEvent(events[0], BoneSphereEvent::Enter, 1, 0));
+    EXPECT_TRUE(isEvent(events[1], BoneSphereEvent::Enter, 2, 0));
+}
+
+TEST(BoneSphereEventQueueTest, CoalescesOnlySameHandleAndDevice)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    queue.push(BoneSphereEvent::Exit, 1, 1);
+    queue.push(BoneSphereEvent::Exit, 2, 0);
+    queue.push(BoneSphereEvent::Enter, 1, 1);
+    queue.push(BoneSphereEvent::Exit, 1, 0);
+
+    const auto events = flushAll(queue);
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_TRUE(isEvent(events[0], BoneSphereEvent::Exit, 1, 1));
+    EXPECT_TRUE(isEvent(events[1], BoneSphereEvent::Exit, 2, 0));
+    EXPECT_TRUE(isEvent(events[2], BoneSphereEvent::Enter, 1, 1));
+}
+
+TEST(BoneSphereEventQueueTest, CapCarriesOverInDetectionOrder)
+{
+    BoneSphereEventQueue queue;
+    for (std::uint32_t handle = 1; handle <= 10; handle++) {
+        queue.push(BoneSphereEvent::Enter, handle, handle % 2);
+    }
+
+    std::vector<std::uint32_t> order;
+    const auto record = [&](const BoneSphereQueuedEvent& evt) { order.push_back(evt.handle); };
+    EXPECT_EQ(queue.flush(4, record), 4u);
+    EXPECT_EQ(queue.pending(), 6u);
+
+    // next frame events are after the carried over ones
+    queue.push(BoneSphereEvent::Enter, 11, 0);
+    EXPECT_EQ(queue.flush(4, record), 4u);
+    EXPECT_EQ(queue.flush(4, record), 3u);
+    EXPECT_EQ(queue.flush(4, record), 0u);
+    EXPECT_EQ(order, (std::vector<std::uint32_t>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }));
+}
+
+TEST(BoneSphereEventQueueTest, ExitCancelsCarriedOverEnter)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    queue.push(BoneSphereEvent::Enter, 2, 0);
+    queue.push(BoneSphereEvent::Enter, 3, 0);
+    EXPECT_EQ(flushAll(queue, 1).size(), 1u);
+
+    // enter of handle 2 still pending from the previous frame
+    queue.push(BoneSphereEvent::Exit, 2, 0);
+    // enter of handle 1 was dispatched so the exit must be queued
+    queue.push(BoneSphereEvent::Exit, 1, 0);
+
+    const auto events = flushAll(queue);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_TRUE(isEvent(events[0], BoneSphereEvent::Enter, 3, 0));
+    EXPECT_TRUE(isEvent(events[1], BoneSphereEvent::Exit, 1, 0));
+}
+
+TEST(BoneSphereEventQueueTest, ClearDropsPending)
+{
+    BoneSphereEventQueue queue;
+    queue.push(BoneSphereEvent::Enter, 1, 0);
+    queue.clear();
+    EXPECT_EQ(queue.pending(), 0u);
+    EXPECT_TRUE(flushAll(queue).empty());
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "skeleton/BoneSpheresStore.h"
+
+using namespace frik;
+
+namespace
+{
+    std::set<std::size_t> nearByBruteForce(const BoneSpheresStore& store, const RE::NiPoint3& point, const float margin)
+    {
+        std::set<std::size_t> result;
+        for (std::size_t i = 0; i < store.size(); i++) {
+            if (std::abs(store.center(i).x - point.x) <= store.radius(i) + margin) {
+                result.insert(i);
+            }
+        }
+        return result;
+    }
+
+    std::set<std::size_t> nearBy(const BoneSpheresStore& store, const RE::NiPoint3& point, const float margin)
+    {
+        std::set<std::size_t> result;
+        store.forEachNear(point, margin, [&](const std::size_t i) { result.insert(i); });
+        return result;
+    }
+}
+
+TEST(BoneSpheresStoreTest, RemovedHandleIsNotValidAfterSlotReuse)
+{
+    RE::NiNode bone;
+    BoneSpheresStore store;
+    const auto first = store.add(&bone, 1, {}, BONE_SPHERE_PAPYRUS_OWNER);
+    ASSERT_NE(first, 0u);
+    EXPECT_EQ(store.indexOf(first), 0);
+
+    EXPECT_TRUE(store.remove(first));
+    EXPECT_EQ(store.indexOf(first), -1);
+    EXPECT_FALSE(store.remove(first));
+
+    // same slot with the next generation
+    const auto second = store.add(&bone, 2, {}, BONE_SPHERE_PAPYRUS_OWNER);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second & 0xFFFFF, first & 0xFFFFF);
+    EXPECT_EQ(store.indexOf(first), -1);
+    EXPECT_EQ(store.indexOf(second), 0);
+    EXPECT_EQ(store.radius(0), 2);
+}
+
+TEST(BoneSpheresStoreTest, HandlesAreNeverZeroOrNegative)
+{
+    RE::NiNode bone;
+    BoneSpheresStore store;
+    std::uint32_t handle = 0;
+    // cycle slots through all their generations to retirement
+    for (int i = 0; i < 5000; i++) {
+        handle = store.add(&bone, 1, {}, 1);
+        ASSERT_NE(handle, 0u);
+        ASSERT_GE(static_cast<std::int32_t>(handle), 0);
+        ASSERT_TRUE(store.remove(handle));
+    }
+    EXPECT_EQ(store.indexOf(0), -1);
+    EXPECT_EQ(store.indexOf(0xFFFFFFFF), -1);
+}
+
+TEST(BoneSpheresStoreTest, RetiredSlotNeverRepeatsHandle)
+{
+    RE::NiNode bone;
+    BoneSpheresStore store;
+    std::set<std::uint32_t> handles;
+    std::set<std::uint32_t> slots;
+    for (int i = 0; i < 5000; i++) {
+        const auto handle = store.add(&bone, 1, {}, 1);
+        ASSERT_TRUE(handles.insert(handle).second) << "handle repeated after " << i << " reuses";
+        slots.insert(handle & 0xFFFFF);
+        ASSERT_TRUE(store.remove(handle));
+    }
+    // 2048 generations per slot before moving to a new slot
+    EXPECT_EQ(slots.size(), 3u);
+
+    // a destroyed handle of a retired slot stays invalid
+    EXPECT_EQ(store.indexOf(*handles.begin()), -1);
+}
+
+TEST(BoneSpheresStoreTest, SwapRemoveKeepsHandlesMappedToTheirData)
+{
+    std::array<RE::NiNode, 5> bones;
+    BoneSpheresStore store;
+    std::vector<std::uint32_t> handles;
+    for (std::size_t i = 0; i < bones.size(); i++) {
+        handles.push_back(store.add(&bones[i], static_cast<float>(i + 1), { static_cast<float>(i), 0, 0 }, static_cast<std::uint32_t>(i)));
+    }
+    store.setSticky(4, 1, true);
+    store.setDebugOn(4, true);
+
+    // the last sphere is moved into the removed index
+    ASSERT_TRUE(store.remove(handles[1]));
+    ASSERT_EQ(store.size(), 4u);
+    EXPECT_EQ(store.indexOf(handles[4]), 1);
+    EXPECT_EQ(store.indexOf(handles[1]), -1);
+
+    for (const auto i : { 0, 2, 3, 4 }) {
+        const auto index = store.indexOf(handles[i]);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(store.handle(index), handles[i]);
+        EXPECT_EQ(store.bone(index), &bones[i]);
+        EXPECT_EQ(store.radius(index), static_cast<float>(i + 1));
+        EXPECT_EQ(store.owner(index), static_cast<std::uint32_t>(i));
+        EXPECT_EQ(store.offset(index).x, static_cast<float>(i));
+    }
+    EXPECT_TRUE(store.isSticky(1, 1));
+    EXPECT_FALSE(store.isSticky(1, 0));
+    EXPECT_TRUE(store.isDebugOn(1));
+
+    // removing the last dense index
+    ASSERT_TRUE(store.remove(handles[3]));
+    EXPECT_EQ(store.indexOf(handles[2]), 2);
+    EXPECT_EQ(store.indexOf(handles[4]), 1);
+
+    ASSERT_TRUE(store.remove(handles[0]));
+    ASSERT_TRUE(store.remove(handles[2]));
+    ASSERT_TRUE(store.remove(handles[4]));
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST(BoneSpheresStoreTest, BroadPhaseMatchesBruteForce)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(-200, 200);
+    std::uniform_real_distribution<float> radius(1, 15);
+
+    std::vector<RE::NiNode> bones(300);
+    BoneSpheresStore store;
+    std::vector<std::uint32_t> handles;
+    for (auto& bone : bones) {
+        bone.world.translate = { coord(rng), coord(rng), coord(rng) };
+        handles.push_back(store.add(&bone, radius(rng), { 0, 0, 2 }, 1));
+    }
+
+    for (int frame = 0; frame < 50; frame++) {
+        // bones move a bit every frame, spheres come and go
+        for (auto& bone : bones) {
+            bone.world.translate += RE::NiPoint3(coord(rng), coord(rng), coord(rng)) * 0.02f;
+        }
+        if (frame % 10 == 5) {
+            store.remove(handles[frame]);
+            handles[frame] = store.add(&bones[frame], radius(rng), {}, 1);
+        }
+        store.updateCenters();
+
+        for (int query = 0; query < 20; query++) {
+            const RE::NiPoint3 point(coord(rng), coord(rng), coord(rng));
+            EXPECT_EQ(nearBy(store, point, 3), nearByBruteForce(store, point, 3));
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "skeleton/BoneTreeTransformsKernel.h"
+#include "skeleton/HostBoneTree.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    float maxWorldDiff(const HostBoneTree& a, const HostBoneTree& b)
+    {
+        float diff = 0;
+        for (std::size_t i = 0; i < a.transforms.size(); i++) {
+            diff = std::max(diff, maxMatrixDiff(a.transforms[i].world.rotate, b.transforms[i].world.rotate));
+            diff = std::max(diff, (a.transforms[i].world.translate - b.transforms[i].world.translate).Length());
+        }
+        return diff;
+    }
+
+    HostBoneTree updateWithKernel(HostBoneTree tree, const std::vector<int>& positions, const bool simd)
+    {
+        BoneTreeTransformsKernel kernel;
+        kernel.setSimdEnabled(simd);
+        kernel.build(&tree, positions);
+        kernel.update(&tree);
+        return tree;
+    }
+}
+
+TEST(BoneTreeTransformsKernelTest, ResolvesLevelsFromSubsetParents)
+{
+    std::mt19937 rng(1);
+    auto [tree, positions] = makeHandsBoneTree(2, rng);
+
+    BoneTreeTransformsKernel kernel;
+    kernel.build(&tree, positions);
+    EXPECT_EQ(kernel.size(), 40u);
+    // 4 joints chain per finger, first joint parent is the arm entry outside the subset
+    EXPECT_EQ(kernel.levelsCount(), 4u);
+}
+
+TEST(BoneTreeTransformsKernelTest, MatchesNaivePerEntryUpdate)
+{
+    for (const int hands : { 1, 2, 7 }) {
+        std::mt19937 rng(hands);
+        auto [tree, positions] = makeHandsBoneTree(hands, rng);
+
+        auto expected = tree;
+        updateBoneTreeNaive(expected, positions);
+
+        EXPECT_LT(maxWorldDiff(updateWithKernel(tree, positions, false), expected), 1e-3f) << hands;
+        EXPECT_LT(maxWorldDiff(updateWithKernel(tree, positions, true), expected), 1e-3f) << hands;
+    }
+}
+
+TEST(BoneTreeTransformsKernelTest, SimdMatchesScalarExactly)
+{
+    if (!BoneTreeTransformsKernel::isSimdAvailable()) {
+        GTEST_SKIP() << "no SIMD path in this build";
+    }
+    // odd counts so the levels have a scalar tail after the groups of 4
+    for (const int hands : { 1, 2, 3, 5 }) {
+        std::mt19937 rng(100 + hands);
+        auto [tree, positions] = makeHandsBoneTree(hands, rng);
+        positions.pop_back();
+
+        const auto scalar = updateWithKernel(tree, positions, false);
+        const auto simd = updateWithKernel(tree, positions, true);
+        for (std::size_t i = 0; i < tree.transforms.size(); i++) {
+            const auto& a = scalar.transforms[i].world;
+            const auto& b = simd.transforms[i].world;
+            EXPECT_EQ(std::memcmp(a.rotate.entry, b.rotate.entry, sizeof(a.rotate.entry)), 0) << i;
+            EXPECT_EQ(a.translate, b.translate) << i;
+        }
+    }
+}
+
+TEST(BoneTreeTransformsKernelTest, LeavesEntriesOutsideSubsetUntouched)
+{
+    std::mt19937 rng(3);
+    auto [tree, positions] = makeHandsBoneTree(1, rng);
+    const auto updated = updateWithKernel(tree, positions, true);
+    for (int pos = 0; pos < 3; pos++) {
+        EXPECT_EQ(std::memcmp(&updated.transforms[pos].world, &tree.transforms[pos].world, sizeof(RE::NiTransform)), 0);
+    }
+    for (const auto pos : positions) {
+        EXPECT_EQ(updated.transforms[pos].world.scale, tree.transforms[pos].world.scale);
+    }
+}
+
+TEST(BoneTreeTransformsKernelTest, EmptySubsetDoesNothing)
+{
+    std::mt19937 rng(4);
+    auto [tree, positions] = makeHandsBoneTree(1, rng);
+    BoneTreeTransformsKernel kernel;
+    kernel.build(&tree, {});
+    kernel.update(&tree);
+    EXPECT_EQ(kernel.size(), 0u);
+    EXPECT_EQ(kernel.getUpdatesCount(), 0u);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "host/HostSkeletonScene.h"
+#include "skeleton/DirtySubtrees.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    struct BoundScene
+    {
+        BoundScene()
+        {
+            nodes = { scene.tree.root(), scene.find("Head"), scene.find("SPINE2"), scene.find("LLeg_Thigh"), scene.find("RLeg_Thigh"),
+                scene.find("LArm_Collarbone"), scene.find("RArm_Collarbone") };
+            for (std::size_t i = 0; i < DIRTY_SUBTREES_COUNT; i++) {
+                counts[i] = HostSkeletonScene::countNodes(static_cast<HostNode*>(nodes[i]));
+            }
+            dirty.bind(nodes, counts);
+        }
+
+        std::vector<RE::NiAVObject*> flush()
+        {
+            std::vector<RE::NiAVObject*> updated;
+            dirty.flush([&](RE::NiAVObject* node) { updated.push_back(node); });
+            return updated;
+        }
+
+        RE::NiAVObject* node(const DirtySubtree subtree) const { return nodes[static_cast<std::size_t>(subtree)]; }
+        std::uint32_t count(const DirtySubtree subtree) const { return counts[static_cast<std::size_t>(subtree)]; }
+
+        HostSkeletonScene scene;
+        DirtySubtrees::Nodes nodes{};
+        DirtySubtrees::NodesCounts counts{};
+        DirtySubtrees dirty;
+    };
+}
+
+TEST(DirtySubtreesTest, DirtyAncestorCoversDescendants)
+{
+    BoundScene bound;
+    bound.dirty.markDirty(DirtySubtree::Head);
+    bound.dirty.markDirty(DirtySubtree::LeftShoulder);
+    bound.dirty.markDirty(DirtySubtree::Root);
+    EXPECT_EQ(bound.flush(), std::vector{ bound.node(DirtySubtree::Root) });
+    EXPECT_EQ(bound.dirty.takeNodeUpdates(), bound.count(DirtySubtree::Root));
+
+    // the shoulders and the head are under the spine, the thighs are not
+    bound.dirty.markDirty(DirtySubtree::RightShoulder);
+    bound.dirty.markDirty(DirtySubtree::Head);
+    bound.dirty.markDirty(DirtySubtree::LeftThigh);
+    bound.dirty.markDirty(DirtySubtree::Spine);
+    EXPECT_EQ(bound.flush(), (std::vector{ bound.node(DirtySubtree::Spine), bound.node(DirtySubtree::LeftThigh) }));
+    EXPECT_EQ(bound.dirty.takeNodeUpdates(), bound.count(DirtySubtree::Spine) + bound.count(DirtySubtree::LeftThigh));
+}
+
+TEST(DirtySubtreesTest, FlushClearsDirtyAndSiblingsUpdateOnce)
+{
+    BoundScene bound;
+    bound.dirty.markDirty(DirtySubtree::LeftShoulder);
+    bound.dirty.markDirty(DirtySubtree::LeftShoulder);
+    bound.dirty.markDirty(DirtySubtree::RightShoulder);
+    EXPECT_TRUE(bound.dirty.isDirty(DirtySubtree::LeftShoulder));
+    EXPECT_EQ(bound.flush(), (std::vector{ bound.node(DirtySubtree::LeftShoulder), bound.node(DirtySubtree::RightShoulder) }));
+    EXPECT_FALSE(bound.dirty.isDirty(DirtySubtree::LeftShoulder));
+
+    EXPECT_TRUE(bound.flush().empty());
+    EXPECT_EQ(bound.dirty.takeNodeUpdates(), bound.count(DirtySubtree::LeftShoulder) + bound.count(DirtySubtree::RightShoulder));
+    EXPECT_EQ(bound.dirty.takeNodeUpdates(), 0u);
+}
+
+TEST(DirtySubtreesTest, MissingNodeIsSkipped)
+{
+    BoundScene bound;
+    bound.nodes[static_cast<std::size_t>(DirtySubtree::Head)] = nullptr;
+    bound.dirty.bind(bound.nodes, bound.counts);
+    bound.dirty.markDirty(DirtySubtree::Head);
+    EXPECT_TRUE(bound.flush().empty());
+    EXPECT_EQ(bound.dirty.takeNodeUpdates(), 0u);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "skeleton/EquipmentSlotsTracker.h"
+
+using namespace frik;
+
+namespace
+{
+    /**
+     * Fake equipment source, the events change the slots the same way the game does on equip/unequip/3D load.
+     */
+    class FakeEquipment
+    {
+    public:
+        struct Slot
+        {
+            const int* item = nullptr;
+            const int* node = nullptr;
+        };
+
+        void equip(const int slotId)
+        {
+            slots[slotId].item = &_items[slotId];
+            slots[slotId].node = nullptr;
+        }
+
+        void load3D(const int slotId) { slots[slotId].node = &_nodes[_nodesLoaded++ % 2][slotId]; }
+
+        void unequip(const int slotId) { slots[slotId] = {}; }
+
+        std::array<Slot, 32> slots{};
+
+    private:
+        std::array<int, 32> _items{};
+        std::array<std::array<int, 32>, 2> _nodes{};
+        int _nodesLoaded = 0;
+    };
+
+    const std::vector<int> HIDDEN_SLOTS = { 0, 1, 2, 16, 17 };
+}
+
+TEST(EquipmentSlotsTrackerTest, AppliesOnFirstUpdateThenOnlyOnEvents)
+{
+    FakeEquipment equipment;
+    equipment.equip(0);
+    equipment.load3D(0);
+
+    EquipmentSlotsTracker tracker;
+    EXPECT_FALSE(tracker.isApplied());
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 0, 0));
+    EXPECT_TRUE(tracker.isApplied());
+
+    // steady state, many frames without events
+    for (std::uint64_t frame = 1; frame < 1000; frame++) {
+        EXPECT_FALSE(tracker.update(equipment.slots, HIDDEN_SLOTS, frame * 11, 0));
+    }
+
+    equipment.equip(16);
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20000, 0));
+    EXPECT_FALSE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20011, 0));
+
+    // 3D loaded later than the equip
+    equipment.load3D(16);
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20022, 0));
+
+    // 3D re-loaded for the same item
+    equipment.load3D(16);
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20033, 0));
+
+    equipment.unequip(0);
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20044, 0));
+    EXPECT_FALSE(tracker.update(equipment.slots, HIDDEN_SLOTS, 20055, 0));
+}
+
+TEST(EquipmentSlotsTrackerTest, IgnoresEventsInNotHiddenSlots)
+{
+    FakeEquipment equipment;
+    EquipmentSlotsTracker tracker;
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 0, 0));
+
+    equipment.equip(5);
+    equipment.load3D(5);
+    EXPECT_FALSE(tracker.update(equipment.slots, HIDDEN_SLOTS, 11, 0));
+}
+
+TEST(EquipmentSlotsTrackerTest, PeriodicVerification)
+{
+    FakeEquipment equipment;
+    equipment.equip(1);
+    equipment.load3D(1);
+
+    EquipmentSlotsTracker tracker;
+    int applies = 0;
+    for (std::uint64_t now = 0; now < 10000; now += 11) {
+        applies += tracker.update(equipment.slots, HIDDEN_SLOTS, now, 2000) ? 1 : 0;
+    }
+    // first apply and every 2 seconds
+    EXPECT_EQ(applies, 5);
+}
+
+TEST(EquipmentSlotsTrackerTest, ResetReappliesOnNextUpdate)
+{
+    FakeEquipment equipment;
+    equipment.equip(2);
+    equipment.load3D(2);
+
+    EquipmentSlotsTracker tracker;
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 0, 0));
+    tracker.reset();
+    EXPECT_FALSE(tracker.isApplied());
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 11, 0));
+}
+
+TEST(EquipmentSlotsTrackerTest, HiddenSlotsConfigChange)
+{
+    FakeEquipment equipment;
+    equipment.equip(17);
+    equipment.load3D(17);
+
+    EquipmentSlotsTracker tracker;
+    EXPECT_TRUE(tracker.update(equipment.slots, { 0, 1 }, 0, 0));
+    EXPECT_TRUE(tracker.update(equipment.slots, HIDDEN_SLOTS, 11, 0));
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "host/TestMath.h"
+#include "skeleton/FingerQuaternions.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    constexpr float MATRIX_EPSILON = 1e-4f;
+
+    FingerQuaternions randomFingers(std::mt19937& rng, std::array<RE::NiMatrix3, FingerQuaternions::LANES>& matrices)
+    {
+        FingerQuaternions fingers;
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            matrices[i] = randomRotation(rng);
+            fingers.set(i, matrices[i]);
+        }
+        return fingers;
+    }
+}
+
+TEST(FingerQuaternionsTest, MatrixRoundTrip)
+{
+    std::mt19937 rng(1);
+    for (int iter = 0; iter < 200; iter++) {
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> matrices;
+        const auto fingers = randomFingers(rng, matrices);
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            EXPECT_LT(maxMatrixDiff(fingers.getMatrix(i), matrices[i]), MATRIX_EPSILON) << "lane " << i;
+        }
+    }
+}
+
+TEST(FingerQuaternionsTest, DefaultIsIdentity)
+{
+    const FingerQuaternions fingers;
+    EXPECT_LT(maxMatrixDiff(fingers.getMatrix(3), axisAngleMatrix(1, 0, 0, 0)), MATRIX_EPSILON);
+}
+
+TEST(FingerQuaternionsTest, SlerpMatchesPerFingerReference)
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> weight(-1.0f, 2.0f);
+    for (int iter = 0; iter < 500; iter++) {
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> fromMatrices;
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> toMatrices;
+        const auto from = randomFingers(rng, fromMatrices);
+        const auto to = randomFingers(rng, toMatrices);
+        FingerQuaternions::Weights t;
+        for (auto& lane : t) {
+            lane = weight(rng);
+        }
+
+        FingerQuaternions out;
+        slerpFingers(from, to, t, out);
+
+        for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+            const auto expected = ReferenceQuaternion::fromMatrix(fromMatrices[i]).slerp(ReferenceQuaternion::fromMatrix(toMatrices[i]), t[i]).getMatrix();
+            EXPECT_LT(maxMatrixDiff(out.getMatrix(i), expected), MATRIX_EPSILON) << "lane " << i << " t " << t[i];
+        }
+    }
+}
+
+TEST(FingerQuaternionsTest, SlerpEndpoints)
+{
+    std::mt19937 rng(3);
+    std::array<RE::NiMatrix3, FingerQuaternions::LANES> fromMatrices;
+    std::array<RE::NiMatrix3, FingerQuaternions::LANES> toMatrices;
+    const auto from = randomFingers(rng, fromMatrices);
+    const auto to = randomFingers(rng, toMatrices);
+
+    FingerQuaternions out;
+    FingerQuaternions::Weights t{};
+    slerpFingers(from, to, t, out);
+    for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+        EXPECT_LT(maxMatrixDiff(out.getMatrix(i), fromMatrices[i]), MATRIX_EPSILON);
+    }
+
+    t.fill(1.0f);
+    slerpFingers(from, to, t, out);
+    for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+        EXPECT_LT(maxMatrixDiff(out.getMatrix(i), toMatrices[i]), MATRIX_EPSILON);
+    }
+}
+
+TEST(FingerQuaternionsTest, SlerpTakesShortestPath)
+{
+    FingerQuaternions from;
+    from.set(0, axisAngleMatrix(0, 0, 1, 0.2));
+    FingerQuaternions to;
+    to.set(0, axisAngleMatrix(0, 0, 1, 0.6));
+    // same rotation with the opposite quaternion sign
+    FingerQuaternions negatedTo = to;
+    negatedTo.x[0] = -to.x[0];
+    negatedTo.y[0] = -to.y[0];
+    negatedTo.z[0] = -to.z[0];
+    negatedTo.w[0] = -to.w[0];
+
+    FingerQuaternions::Weights t{};
+    t[0] = 0.5f;
+    FingerQuaternions out;
+    FingerQuaternions negatedOut;
+    slerpFingers(from, to, t, out);
+    slerpFingers(from, negatedTo, t, negatedOut);
+
+    EXPECT_LT(maxMatrixDiff(out.getMatrix(0), axisAngleMatrix(0, 0, 1, 0.4)), MATRIX_EPSILON);
+    EXPECT_LT(maxMatrixDiff(negatedOut.getMatrix(0), axisAngleMatrix(0, 0, 1, 0.4)), MATRIX_EPSILON);
+}
+
+TEST(FingerQuaternionsTest, SlerpNearlyEqualUsesLinearFallback)
+{
+    FingerQuaternions from;
+    from.set(0, axisAngleMatrix(1, 1, 0, 0.5));
+    FingerQuaternions to;
+    to.set(0, axisAngleMatrix(1, 1, 0, 0.501));
+
+    FingerQuaternions::Weights t{};
+    t[0] = 0.5f;
+    FingerQuaternions out;
+    slerpFingers(from, to, t, out);
+
+    EXPECT_LT(maxMatrixDiff(out.getMatrix(0), axisAngleMatrix(1, 1, 0, 0.5005)), MATRIX_EPSILON);
+    const float len = out.x[0] * out.x[0] + out.y[0] * out.y[0] + out.z[0] * out.z[0] + out.w[0] * out.w[0];
+    EXPECT_NEAR(len, 1.0f, 1e-5f);
+}
+
+TEST(FingerQuaternionsTest, SlerpOutputCanAliasInput)
+{
+    std::mt19937 rng(4);
+    std::array<RE::NiMatrix3, FingerQuaternions::LANES> fromMatrices;
+    std::array<RE::NiMatrix3, FingerQuaternions::LANES> toMatrices;
+    auto current = randomFingers(rng, fromMatrices);
+    const auto to = randomFingers(rng, toMatrices);
+
+    FingerQuaternions::Weights t;
+    t.fill(0.3f);
+    FingerQuaternions expected;
+    slerpFingers(current, to, t, expected);
+    slerpFingers(current, to, t, current);
+
+    for (std::size_t i = 0; i < FingerQuaternions::LANES; i++) {
+        EXPECT_LT(maxMatrixDiff(current.getMatrix(i), expected.getMatrix(i)), 1e-6f);
+    }
+}
+
+TEST(FingerQuaternionsTest, SimdMatchesScalarExactly)
+{
+    if (!isSlerpFingersSimdAvailable()) {
+        GTEST_SKIP() << "no SIMD path in this build";
+    }
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> weight(-1.0f, 2.0f);
+    for (int iter = 0; iter < 500; iter++) {
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> fromMatrices;
+        std::array<RE::NiMatrix3, FingerQuaternions::LANES> toMatrices;
+        const auto from = randomFingers(rng, fromMatrices);
+        // every few iterations nearly equal quaternions to cover the linear fallback
+        const auto to = iter % 4 == 0 ? from : randomFingers(rng, toMatrices);
+        FingerQuaternions::Weights t;
+        for (auto& lane : t) {
+            lane = weight(rng);
+        }
+
+        FingerQuaternions simdOut;
+        FingerQuaternions scalarOut;
+        slerpFingers(from, to, t, simdOut, true);
+        slerpFingers(from, to, t, scalarOut, false);
+        EXPECT_EQ(simdOut.x, scalarOut.x);
+        EXPECT_EQ(simdOut.y, scalarOut.y);
+        EXPECT_EQ(simdOut.z, scalarOut.z);
+        EXPECT_EQ(simdOut.w, scalarOut.w);
+    }
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "skeleton/HostSkeletonReplay.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    std::string writeCapture(const std::string& name, const std::vector<CapturedFrame>& frames)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        writeCaptureHeader(stream);
+        for (const auto& frame : frames) {
+            writeCapturedFrame(stream, frame);
+        }
+        return path;
+    }
+
+    // max difference of the kernels from the reference math over a whole session
+    constexpr float KERNELS_TRANSLATE_EPSILON = 1e-3f;
+    constexpr float KERNELS_ROTATE_EPSILON = 1e-4f;
+
+    FrameReplaySession replay(std::vector<CapturedFrame> frames)
+    {
+        FrameReplaySession session(std::move(frames));
+        HostSkeletonReplay skeleton(ReplayPipeline::Kernels);
+        while (!session.isDone()) {
+            session.compareAndAdvance(skeleton.onFrameUpdate(session.getFrame()));
+        }
+        return session;
+    }
+
+    /**
+     * Replay only the first frames of the capture, to tell which frame a change of the input first shows up in.
+     */
+    FrameReplaySession replayFirst(const std::vector<CapturedFrame>& frames, const std::size_t count)
+    {
+        return replay({ frames.begin(), frames.begin() + static_cast<std::ptrdiff_t>(count) });
+    }
+}
+
+TEST(FrameCaptureReplayTest, FileRoundTrip)
+{
+    const auto frames = makeSyntheticCapture(50);
+    const auto loaded = readCaptureFile(writeCapture("frik_capture_round_trip.bin", frames));
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->size(), frames.size());
+    EXPECT_EQ(std::memcmp(loaded->data(), frames.data(), frames.size() * sizeof(CapturedFrame)), 0);
+}
+
+TEST(FrameCaptureReplayTest, KernelsReplayMatchesReferenceRecording)
+{
+    const auto loaded = readCaptureFile(writeCapture("frik_capture_replay.bin", makeSyntheticCapture(300)));
+    ASSERT_TRUE(loaded.has_value());
+
+    const auto session = replay(loaded.value());
+    EXPECT_EQ(session.getFrameIndex(), 300u);
+    EXPECT_LT(session.getMaxTranslateDiff(), KERNELS_TRANSLATE_EPSILON);
+    EXPECT_LT(session.getMaxRotateDiff(), KERNELS_ROTATE_EPSILON);
+}
+
+TEST(FrameCaptureReplayTest, ReplayUsesRecordedControllersAndConfig)
+{
+    auto frames = makeSyntheticCapture(200);
+
+    // finger closed by controller on a single frame changes that frame and the following blended frames
+    frames[120].input.controllers[0].buttonsTouched |= 1ull << HostSkeletonReplay::BUTTON_TOUCHPAD;
+    EXPECT_LT(replayFirst(frames, 120).getMaxRotateDiff(), KERNELS_ROTATE_EPSILON);
+    EXPECT_GT(replayFirst(frames, 121).getMaxRotateDiff(), 0.01f);
+
+    // config is per frame input, not read from a global config
+    frames = makeSyntheticCapture(200);
+    frames[40].input.config.armLength = 50;
+    EXPECT_LT(replayFirst(frames, 40).getMaxTranslateDiff(), KERNELS_TRANSLATE_EPSILON);
+    EXPECT_GT(replayFirst(frames, 41).getMaxTranslateDiff(), 0.1f);
+
+    // hands dampening is read from the frame config, disabling it moves the hands to the raw tracking position
+    frames = makeSyntheticCapture(200);
+    frames[60].input.config.dampenHands = false;
+    EXPECT_LT(replayFirst(frames, 60).getMaxTranslateDiff(), KERNELS_TRANSLATE_EPSILON);
+    EXPECT_GT(replayFirst(frames, 61).getMaxTranslateDiff(), 0.01f);
+
+    // left-handed mode swaps the wands of the hands
+    frames = makeSyntheticCapture(200);
+    frames[80].input.config.leftHandedMode = true;
+    EXPECT_LT(replayFirst(frames, 80).getMaxTranslateDiff(), KERNELS_TRANSLATE_EPSILON);
+    EXPECT_GT(replayFirst(frames, 81).getMaxTranslateDiff(), 10);
+}
+
+TEST(FrameCaptureReplayTest, NodeUpdatesPerFrame)
+{
+    auto frames = makeSyntheticCapture(3);
+    frames[1].cameraPosition = frames[0].cameraPosition;
+    frames[2].input.config.hideHead = false;
+
+    HostSkeletonReplay skeleton;
+    const std::uint32_t nodesCount = skeleton.getSkeletonNodesCount();
+    std::vector<std::uint32_t> nodeUpdates;
+    for (const auto& frame : frames) {
+        skeleton.onFrameUpdate(frame);
+        nodeUpdates.push_back(skeleton.getFrameNodeUpdates());
+    }
+
+    // before dirty tracking every stage updated the whole skeleton: restore, body under HMD, posture, legs, and arms
+    const std::uint32_t fullUpdates = 5 * nodesCount;
+    EXPECT_EQ(nodesCount, 152u);
+    EXPECT_EQ(fullUpdates, 760u);
+    EXPECT_EQ(nodeUpdates[0], 404u); // standing: 2 full, thighs, and shoulders
+    EXPECT_EQ(nodeUpdates[1], 404u);
+    EXPECT_EQ(nodeUpdates[2], 486u); // walking adds the spine, the shown head is covered by the root update
+    for (const auto count : nodeUpdates) {
+        EXPECT_LT(count, fullUpdates * 2 / 3);
+    }
+}
+
+TEST(FrameCaptureReplayTest, RejectsMissingOrDifferentFormat)
+{
+    EXPECT_FALSE(readCaptureFile("/nonexistent/frik_capture.bin").has_value());
+
+    const auto path = (std::filesystem::temp_directory_path() / "frik_capture_bad.bin").string();
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        const uint32_t header[3] = { 0x434B5246, 1, 100 };
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+    EXPECT_FALSE(readCaptureFile(path).has_value());
+
+    // header only, no frames
+    EXPECT_FALSE(readCaptureFile(writeCapture("frik_capture_empty.bin", {})).has_value());
+}
+
+TEST(FrameCaptureReplayTest, IgnoresTruncatedLastFrame)
+{
+    const auto frames = makeSyntheticCapture(10);
+    const auto path = writeCapture("frik_capture_truncated.bin", frames);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - sizeof(CapturedFrame) / 2);
+
+    const auto loaded = readCaptureFile(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->size(), 9u);
+}
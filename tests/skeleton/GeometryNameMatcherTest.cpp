@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "skeleton/GeometryNameMatcher.h"
+
+using namespace frik;
+
+namespace
+{
+    GeometryNameMatcher build(const std::vector<std::string>& patterns)
+    {
+        GeometryNameMatcher matcher;
+        matcher.build(patterns);
+        return matcher;
+    }
+}
+
+TEST(GeometryNameMatcherTest, EmptyListMatchesNothing)
+{
+    const GeometryNameMatcher notBuilt;
+    EXPECT_FALSE(notBuilt.containsAny("BaseMaleHead"));
+
+    const auto empty = build({});
+    EXPECT_FALSE(empty.containsAny("BaseMaleHead"));
+    EXPECT_FALSE(empty.containsAny(""));
+
+    const auto emptyPattern = build({ "" });
+    EXPECT_FALSE(emptyPattern.containsAny("BaseMaleHead"));
+}
+
+TEST(GeometryNameMatcherTest, PrefixSuffixAndMiddleHits)
+{
+    const auto matcher = build({ "Hair", "Head", "Eyes", "Vault111Suit_YanEdits:0" });
+    EXPECT_TRUE(matcher.containsAny("HairMale30"));
+    EXPECT_TRUE(matcher.containsAny("BaseMaleHead"));
+    EXPECT_TRUE(matcher.containsAny("MaleEyesHumanAO"));
+    EXPECT_TRUE(matcher.containsAny("Vault111Suit_YanEdits:0"));
+    EXPECT_FALSE(matcher.containsAny("Vault111Suit_YanEdits:1"));
+    EXPECT_FALSE(matcher.containsAny("Outfit_Body"));
+    EXPECT_FALSE(matcher.containsAny("Hai"));
+    EXPECT_FALSE(matcher.containsAny(""));
+}
+
+TEST(GeometryNameMatcherTest, CaseInsensitive)
+{
+    const auto matcher = build({ "helmet", "PA_T45" });
+    EXPECT_TRUE(matcher.containsAny("HELMETNECK001:0"));
+    EXPECT_TRUE(matcher.containsAny("pa_t45_Torso"));
+    EXPECT_FALSE(matcher.containsAny("PA_T51_Torso"));
+}
+
+TEST(GeometryNameMatcherTest, OverlappingPatterns)
+{
+    // a pattern inside a longer pattern is matched by the fail link of the longer pattern state
+    const auto nested = build({ "abcd", "bc" });
+    EXPECT_TRUE(nested.containsAny("xabce"));
+    EXPECT_TRUE(nested.containsAny("abcd"));
+    EXPECT_FALSE(nested.containsAny("abdc"));
+
+    // a mismatch continues from the longest suffix that is a prefix of another pattern
+    const auto shifted = build({ "abcd", "bcx" });
+    EXPECT_TRUE(shifted.containsAny("abcx"));
+    EXPECT_FALSE(shifted.containsAny("abcbc"));
+
+    // the game mesh names overlap by prefix: Helm, Helmet, HelmetNeck
+    const auto prefixes = build({ "HelmetNeck", "Helm", "Helmet" });
+    EXPECT_TRUE(prefixes.containsAny("PA_T45_Helmet:2"));
+    EXPECT_TRUE(prefixes.containsAny("XHelmX"));
+    EXPECT_FALSE(prefixes.containsAny("HeLX"));
+}
+
+TEST(GeometryNameMatcherTest, RebuildReplacesPatterns)
+{
+    GeometryNameMatcher matcher;
+    matcher.build({ "Hair" });
+    EXPECT_TRUE(matcher.containsAny("HairMale30"));
+
+    matcher.build({ "Beard" });
+    EXPECT_FALSE(matcher.containsAny("HairMale30"));
+    EXPECT_TRUE(matcher.containsAny("MaleBeard01"));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <random>
+
+#include "host/TestMath.h"
+
+namespace frik::test
+{
+    /**
+     * Stand-in of the flattened bone tree with the fields used by the bone tree kernels (parent position, local, world).
+     */
+    struct HostBoneTree
+    {
+        struct Transform
+        {
+            RE::NiTransform local;
+            RE::NiTransform world;
+            int parPos = -1;
+        };
+
+        std::vector<Transform> transforms;
+    };
+
+    /**
+     * Tree shaped like the hands in the game skeleton: a chain of arm entries (with nodes, world set by the game) and for
+     * each hand 5 fingers of 3 joints plus a tip, all without nodes. Returns the tree and the no-node positions.
+     */
+    inline std::pair<HostBoneTree, std::vector<int>> makeHandsBoneTree(const int handsCount, std::mt19937& rng)
+    {
+        HostBoneTree tree;
+        std::vector<int> noNodePositions;
+        std::uniform_real_distribution<float> coord(-10, 10);
+        std::uniform_real_distribution<float> scale(0.8f, 1.2f);
+
+        const auto add = [&](const int parent, const bool hasNode) {
+            HostBoneTree::Transform transform;
+            transform.parPos = parent;
+            transform.local.rotate = randomRotation(rng, 1.5);
+            transform.local.translate = { coord(rng), coord(rng), coord(rng) };
+            transform.world.rotate = randomRotation(rng, 3);
+            transform.world.translate = { coord(rng) * 10, coord(rng) * 10, coord(rng) * 10 };
+            transform.world.scale = scale(rng);
+            tree.transforms.push_back(transform);
+            const int pos = static_cast<int>(tree.transforms.size()) - 1;
+            if (!hasNode) {
+                noNodePositions.push_back(pos);
+            }
+            return pos;
+        };
+
+        const int root = add(-1, true);
+        for (int hand = 0; hand < handsCount; hand++) {
+            const int arm = add(add(root, true), true);
+            for (int finger = 0; finger < 5; finger++) {
+                int parent = arm;
+                for (int joint = 0; joint < 4; joint++) {
+                    parent = add(parent, false);
+                }
+            }
+        }
+        return { tree, noNodePositions };
+    }
+
+    /**
+     * Straightforward per entry "world = parent.world * local" in tree order, the kernel reference.
+     */
+    inline void updateBoneTreeNaive(HostBoneTree& tree, const std::vector<int>& positions)
+    {
+        for (const auto pos : positions) {
+            auto& transform = tree.transforms[pos];
+            const auto& parent = tree.transforms[transform.parPos].world;
+            transform.world.rotate = transform.local.rotate * parent.rotate;
+            transform.world.translate = parent.translate + parent.rotate.Transpose() * (transform.local.translate * parent.scale);
+        }
+    }
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <algorithm>
+
+#include "host/HostSkeletonScene.h"
+#include "host/TestMath.h"
+#include "skeleton/BoneTreeTransformsKernel.h"
+#include "skeleton/DirtySubtrees.h"
+#include "skeleton/FingerQuaternions.h"
+#include "skeleton/FrameCaptureFile.h"
+#include "skeleton/HostBoneTree.h"
+#include "skeleton/TwoBoneIK.h"
+
+namespace frik::test
+{
+    /**
+     * Which implementation the host replay runs the extracted skeleton calculations with.
+     */
+    enum class ReplayPipeline : uint8_t
+    {
+        // the optimized FRIK kernels: solveTwoBoneIK, batched slerpFingers, BoneTreeTransformsKernel
+        Kernels,
+        // independent double precision reference math: law of cosines IK, per finger quaternion slerp, naive tree update
+        Reference,
+    };
+
+    /**
+     * Host replay driver of the skeleton calculations on stand-in nodes.
+     * Skeleton::onFrameUpdate can't be built off-target (game runtime, scene graph, framework math), so this is a
+     * STAND-IN of it: the body placement, shoulder positions, and elbow pole are simplified fixed rules, not the game
+     * skeleton code. What it does run for real are the calculations extracted from the skeleton into portable kernels, in
+     * the same stage order (restore, body under HMD, hands dampening, arms IK, hand pose, hand bones tree update), fed
+     * only from the captured frame input (tracking transforms, config, controllers, frame time).
+     * Recording with the Reference pipeline and replaying with the Kernels pipeline is a regression check of the kernels
+     * against independent math over a whole session. Replaying a game capture gives kernel timing numbers, its diff
+     * against the game recorded output is not meaningful as the body placement is not the game one.
+     */
+    class HostSkeletonReplay
+    {
+    public:
+        // OpenVR button ids used by the fingers (touchpad, trigger, grip)
+        static constexpr int BUTTON_TOUCHPAD = 32;
+        static constexpr int BUTTON_TRIGGER = 33;
+        static constexpr int BUTTON_GRIP = 2;
+
+        explicit HostSkeletonReplay(const ReplayPipeline pipeline = ReplayPipeline::Kernels) :
+            _pipeline(pipeline)
+        {
+            for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                const double bend = 0.2 + 0.05 * static_cast<double>(i % 3);
+                _openPose.set(i, axisAngleMatrix(0, 1, 0.1, 0.05));
+                _closedPose.set(i, axisAngleMatrix(0, 1, 0.1, bend * 6));
+            }
+            _hands = { _openPose, _openPose };
+            for (auto& hand : _referenceHands) {
+                for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                    hand[i] = ReferenceQuaternion::fromMatrix(_openPose.getMatrix(i));
+                }
+            }
+            buildHandsBoneTree();
+            bindDirtySubtrees();
+        }
+
+        CapturedOutputBones onFrameUpdate(const CapturedFrame& frame)
+        {
+            CapturedOutputBones output{};
+            restoreNodesToDefault();
+            setBodyUnderHMD(frame);
+            for (const bool isLeft : { true, false }) {
+                dampenHand(frame, isLeft);
+                setArms(frame, isLeft);
+                setHandPose(frame, isLeft);
+            }
+            updateHandsBoneTree();
+            updateSkeletonWorld(frame);
+
+            output[static_cast<std::size_t>(SkeletonBone::COM)] = _root.local;
+            for (std::size_t i = 0; i < 6; i++) {
+                output[SKELETON_BONES_COUNT + i] = _arms[i].local;
+            }
+            for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+                output[CAPTURED_OUTPUT_FINGERS_START + i] = _handsTree.transforms[_fingerTreePositions[i]].world;
+            }
+            return output;
+        }
+
+        /**
+         * Number of skeleton nodes world updated in the last frame by the dirty subtrees flushes.
+         */
+        std::uint32_t getFrameNodeUpdates() const { return _frameNodeUpdates; }
+
+        /**
+         * Number of nodes in the stand-in skeleton scene, a full skeleton world update updates all of them.
+         */
+        std::uint32_t getSkeletonNodesCount() const { return HostSkeletonScene::countNodes(_scene.tree.root()); }
+
+    private:
+        void bindDirtySubtrees()
+        {
+            const DirtySubtrees::Nodes nodes = { _scene.tree.root(), _scene.find("Head"), _scene.find("SPINE2"), _scene.find("LLeg_Thigh"),
+                _scene.find("RLeg_Thigh"), _scene.find("LArm_Collarbone"), _scene.find("RArm_Collarbone") };
+            DirtySubtrees::NodesCounts nodesCounts{};
+            for (std::size_t i = 0; i < DIRTY_SUBTREES_COUNT; i++) {
+                nodesCounts[i] = HostSkeletonScene::countNodes(static_cast<HostNode*>(nodes[i]));
+            }
+            _dirtySubtrees.bind(nodes, nodesCounts);
+        }
+
+        /**
+         * The dirty marks and flushes of the skeleton frame update stages on the stand-in skeleton scene, only counting the
+         * updated nodes: restore and body under HMD (head only if shown), body posture, walk and legs, then arms.
+         */
+        void updateSkeletonWorld(const CapturedFrame& frame)
+        {
+            const auto noWorldData = [](RE::NiAVObject*) {};
+            _dirtySubtrees.markDirty(DirtySubtree::Root);
+            if (!frame.input.config.hideHead) {
+                _dirtySubtrees.markDirty(DirtySubtree::Head);
+            }
+            _dirtySubtrees.flush(noWorldData);
+
+            _dirtySubtrees.markDirty(DirtySubtree::Root);
+            _dirtySubtrees.flush(noWorldData);
+
+            // the walk sways the spine only while the player moves
+            if (frame.cameraPosition.x != _prevCameraPosition.x || frame.cameraPosition.y != _prevCameraPosition.y) {
+                _dirtySubtrees.markDirty(DirtySubtree::Spine);
+            }
+            _prevCameraPosition = frame.cameraPosition;
+            _dirtySubtrees.markDirty(DirtySubtree::LeftThigh);
+            _dirtySubtrees.markDirty(DirtySubtree::RightThigh);
+            _dirtySubtrees.flush(noWorldData);
+
+            _dirtySubtrees.markDirty(DirtySubtree::LeftShoulder);
+            _dirtySubtrees.markDirty(DirtySubtree::RightShoulder);
+            _dirtySubtrees.flush(noWorldData);
+            _frameNodeUpdates = _dirtySubtrees.takeNodeUpdates();
+        }
+
+        void restoreNodesToDefault()
+        {
+            _root.local = RE::NiTransform{};
+            for (auto& node : _arms) {
+                node.local = RE::NiTransform{};
+            }
+        }
+
+        /**
+         * Stand-in: place the root under the camera, scaled by the player height and rotated by the HMD yaw.
+         */
+        void setBodyUnderHMD(const CapturedFrame& frame)
+        {
+            const auto& config = frame.input.config;
+            const auto& hmd = frame.hmdWorld.rotate;
+            const float yaw = std::atan2(hmd.entry[1][0], hmd.entry[1][1]);
+            _root.local.rotate = axisAngleMatrix(0, 0, 1, yaw);
+            _root.local.scale = config.playerHeight / 120.4828f;
+            _root.local.translate = frame.cameraPosition - RE::NiPoint3(0, 0, config.playerHMDOffsetUp + config.playerBodyOffsetUp)
+                + _root.local.rotate * RE::NiPoint3(0, config.playerBodyOffsetForward, 0);
+        }
+
+        /**
+         * Move the hand only part of the way from the previous frame, by the captured dampen config (not in scope).
+         */
+        void dampenHand(const CapturedFrame& frame, const bool isLeft)
+        {
+            const auto& config = frame.input.config;
+            auto hand = isLeft ^ config.leftHandedMode ? frame.secondaryWandWorld : frame.primaryWandWorld;
+            auto& prev = _prevHands[isLeft ? 0 : 1];
+            if (config.dampenHands && _hasPrevHand[isLeft ? 0 : 1]) {
+                const auto rotate = ReferenceQuaternion::fromMatrix(prev.rotate).slerp(ReferenceQuaternion::fromMatrix(hand.rotate), 1 - config.dampenHandsRotation);
+                hand.rotate = rotate.getMatrix();
+                hand.translate -= (hand.translate - prev.translate) * config.dampenHandsTranslation;
+            }
+            prev = hand;
+            _hasPrevHand[isLeft ? 0 : 1] = true;
+            _dampenedHands[isLeft ? 0 : 1] = hand;
+        }
+
+        /**
+         * Stand-in shoulder and elbow pole, the elbow position is solved by the IK of the selected pipeline.
+         */
+        void setArms(const CapturedFrame& frame, const bool isLeft)
+        {
+            const auto& config = frame.input.config;
+            const auto& hand = _dampenedHands[isLeft ? 0 : 1];
+            const float scale = _root.local.scale;
+            const auto shoulder = _root.local.translate + _root.local.rotate * RE::NiPoint3((isLeft ? -18.0f : 18.0f) * scale, 0, -15 * scale);
+
+            const float boneLen = config.armLength / 2 * scale;
+            const TwoBoneIKChain chain{ { shoulder.x, shoulder.y, shoulder.z }, { hand.translate.x, hand.translate.y, hand.translate.z }, { 0, 0, -1 },
+                boneLen, boneLen, boneLen };
+            const auto elbow = _pipeline == ReplayPipeline::Kernels ? solveTwoBoneIK(chain).midJoint : referenceTwoBoneIK(chain);
+
+            auto* arm = &_arms[isLeft ? 0 : 3];
+            arm[0].local.translate = shoulder;
+            arm[1].local.translate = { elbow.x, elbow.y, elbow.z };
+            arm[2].local = hand;
+        }
+
+        /**
+         * Blend each finger between closed and open by the controller state, then move the current pose toward it.
+         */
+        void setHandPose(const CapturedFrame& frame, const bool isLeft)
+        {
+            const auto& controller = frame.input.getController(isLeft);
+            const float gripProx = controller.axisX(2);
+
+            FingerQuaternions::Weights weights{};
+            for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                const int button = i < 3 ? BUTTON_TOUCHPAD : i < 6 ? BUTTON_TRIGGER : BUTTON_GRIP;
+                const bool closed = controller.buttonsTouched & 1ull << button;
+                weights[i] = closed ? 0.0f : button == BUTTON_GRIP ? 1.0f - gripProx : 1.0f;
+            }
+            const float blend = std::clamp(frame.frameTime * 7, -1.0f, 2.0f);
+            const std::size_t hand = isLeft ? 0 : 1;
+
+            if (_pipeline == ReplayPipeline::Kernels) {
+                FingerQuaternions target;
+                slerpFingers(_closedPose, _openPose, weights, target);
+                FingerQuaternions::Weights blendWeights;
+                blendWeights.fill(blend);
+                slerpFingers(_hands[hand], target, blendWeights, _hands[hand]);
+                return;
+            }
+            for (std::size_t i = 0; i < FINGERS_COUNT; i++) {
+                const auto target = ReferenceQuaternion::fromMatrix(_closedPose.getMatrix(i)).slerp(ReferenceQuaternion::fromMatrix(_openPose.getMatrix(i)), weights[i]);
+                _referenceHands[hand][i] = _referenceHands[hand][i].slerp(target, blend);
+            }
+        }
+
+        RE::NiMatrix3 getFingerMatrix(const std::size_t fingerBoneIdx) const
+        {
+            const std::size_t hand = isLeftHandFingerBoneIndex(fingerBoneIdx) ? 0 : 1;
+            const std::size_t finger = fingerBoneIdx % FINGERS_COUNT;
+            return _pipeline == ReplayPipeline::Kernels ? _hands[hand].getMatrix(finger) : _referenceHands[hand][finger].getMatrix();
+        }
+
+        /**
+         * Hand bones tree of both hands: hand entry (world set from the arm hand) and 5 fingers of 3 joints without nodes.
+         */
+        void buildHandsBoneTree()
+        {
+            const auto add = [this](const int parent, const RE::NiPoint3& translate) {
+                HostBoneTree::Transform transform;
+                transform.parPos = parent;
+                transform.local.translate = translate;
+                _handsTree.transforms.push_back(transform);
+                return static_cast<int>(_handsTree.transforms.size()) - 1;
+            };
+
+            const int root = add(-1, {});
+            std::size_t fingerBoneIdx = 0;
+            for (std::size_t hand = 0; hand < 2; hand++) {
+                _handTreePositions[hand] = add(root, {});
+                for (int finger = 0; finger < 5; finger++) {
+                    int parent = _handTreePositions[hand];
+                    for (int joint = 0; joint < 3; joint++) {
+                        parent = add(parent, joint == 0 ? RE::NiPoint3(8, 2.0f * static_cast<float>(finger - 2), 0) : RE::NiPoint3(3, 0, 0));
+                        _fingerTreePositions[fingerBoneIdx++] = parent;
+                    }
+                }
+            }
+            _fingerPositions.assign(_fingerTreePositions.begin(), _fingerTreePositions.end());
+            _handsTreeKernel.build(&_handsTree, _fingerPositions);
+        }
+
+        void updateHandsBoneTree()
+        {
+            for (std::size_t hand = 0; hand < 2; hand++) {
+                auto& world = _handsTree.transforms[_handTreePositions[hand]].world;
+                world = _arms[hand == 0 ? 2 : 5].local;
+                world.scale = _root.local.scale;
+            }
+            for (std::size_t i = 0; i < FINGER_BONES_COUNT; i++) {
+                _handsTree.transforms[_fingerTreePositions[i]].local.rotate = getFingerMatrix(i);
+            }
+            if (_pipeline == ReplayPipeline::Kernels) {
+                _handsTreeKernel.update(&_handsTree);
+            } else {
+                updateBoneTreeNaive(_handsTree, _fingerPositions);
+            }
+        }
+
+        /**
+         * Law of cosines elbow position in double precision, same stretch and fallback rules as the IK kernel.
+         */
+        static IKVec3 referenceTwoBoneIK(const TwoBoneIKChain& chain)
+        {
+            const std::array<double, 3> root = { chain.root.x, chain.root.y, chain.root.z };
+            const std::array<double, 3> target = { chain.target.x, chain.target.y, chain.target.z };
+            const std::array<double, 3> pole = { chain.pole.x, chain.pole.y, chain.pole.z };
+            std::array<double, 3> xDir{};
+            for (int i = 0; i < 3; i++) {
+                xDir[i] = root[i] - target[i];
+            }
+            const double rawDistance = std::sqrt(xDir[0] * xDir[0] + xDir[1] * xDir[1] + xDir[2] * xDir[2]);
+            const double distance = std::max(rawDistance, 0.1);
+
+            double upper = chain.upperLen;
+            double lower = chain.lowerLen;
+            if (distance > upper + lower) {
+                const double diff = distance - upper - lower;
+                const double ratio = lower / (lower + upper);
+                lower += ratio * diff + 0.1;
+                upper += (1 - ratio) * diff + 0.1;
+            }
+            double cosAngle = (lower * lower + distance * distance - upper * upper) / (2 * lower * distance);
+            if (std::abs(cosAngle) > 1) {
+                lower = upper = chain.fallbackLen;
+                cosAngle = (lower * lower + distance * distance - upper * upper) / (2 * lower * distance);
+            }
+            const double sinAngle = std::sqrt(std::max(0.0, 1 - cosAngle * cosAngle));
+
+            for (auto& v : xDir) {
+                v /= rawDistance;
+            }
+            const double poleDot = pole[0] * xDir[0] + pole[1] * xDir[1] + pole[2] * xDir[2];
+            std::array<double, 3> yDir{};
+            for (int i = 0; i < 3; i++) {
+                yDir[i] = pole[i] - xDir[i] * poleDot;
+            }
+            const double yLen = std::sqrt(yDir[0] * yDir[0] + yDir[1] * yDir[1] + yDir[2] * yDir[2]);
+
+            IKVec3 mid;
+            float* out[3] = { &mid.x, &mid.y, &mid.z };
+            for (int i = 0; i < 3; i++) {
+                *out[i] = static_cast<float>(target[i] + xDir[i] * cosAngle * lower + yDir[i] / yLen * sinAngle * lower);
+            }
+            return mid;
+        }
+
+        ReplayPipeline _pipeline;
+        RE::NiNode _root;
+        // left upper, forearm, hand, then right
+        std::array<RE::NiNode, 6> _arms;
+        std::array<RE::NiTransform, 2> _dampenedHands;
+        std::array<RE::NiTransform, 2> _prevHands;
+        std::array<bool, 2> _hasPrevHand{};
+
+        FingerQuaternions _openPose;
+        FingerQuaternions _closedPose;
+        std::array<FingerQuaternions, 2> _hands;
+        std::array<std::array<ReferenceQuaternion, FINGERS_COUNT>, 2> _referenceHands;
+
+        HostBoneTree _handsTree;
+        BoneTreeTransformsKernel _handsTreeKernel;
+        std::array<int, 2> _handTreePositions{};
+        std::array<int, FINGER_BONES_COUNT> _fingerTreePositions{};
+        std::vector<int> _fingerPositions;
+
+        HostSkeletonScene _scene;
+        DirtySubtrees _dirtySubtrees;
+        RE::NiPoint3 _prevCameraPosition;
+        std::uint32_t _frameNodeUpdates = 0;
+    };
+
+    /**
+     * Synthetic capture of a player walking forward, swinging the arms, and closing the fingers over time.
+     * The output bones are recorded by running the frames through the host replay Reference pipeline.
+     */
+    inline std::vector<CapturedFrame> makeSyntheticCapture(const std::size_t framesCount)
+    {
+        std::vector<CapturedFrame> frames(framesCount);
+        HostSkeletonReplay recorder(ReplayPipeline::Reference);
+        for (std::size_t i = 0; i < framesCount; i++) {
+            auto& frame = frames[i];
+            const float t = static_cast<float>(i) / 90.0f;
+            frame.frameTime = 1 / 90.0f;
+            frame.hmdWorld.rotate = axisAngleMatrix(0, 0, 1, 0.3 * std::sin(t));
+            frame.cameraPosition = { 0, 40 * t, 120 };
+            frame.primaryWandWorld.rotate = axisAngleMatrix(1, 0, 0, t);
+            frame.primaryWandWorld.translate = frame.cameraPosition + RE::NiPoint3(20, 30 + 10 * std::sin(3 * t), -30);
+            frame.secondaryWandWorld.rotate = axisAngleMatrix(0, 1, 0, t);
+            frame.secondaryWandWorld.translate = frame.cameraPosition + RE::NiPoint3(-20, 30 + 10 * std::cos(3 * t), -30);
+            frame.input.config = {
+                .playerHeight = 120.4828f, .armLength = 36.74f, .headBackPositionOffset = 0, .playerHMDOffsetUp = 0,
+                .playerBodyOffsetUp = 0, .playerBodyOffsetForward = -2, .comfortSneakHackStaticBodyPitchAngle = 0,
+                .dampenHandsRotation = 0.3f, .dampenHandsTranslation = 0.3f, .dampenHandsRotationInVanillaScope = 0.2f,
+                .dampenHandsTranslationInVanillaScope = 0.2f, .hideHead = true, .leftHandedMode = false, .inPowerArmor = false,
+                .disableSmoothMovement = false, .selfieIgnoreHideFlags = false, .dampenHands = true, .dampenHandsInVanillaScope = false
+            };
+            for (auto& controller : frame.input.controllers) {
+                controller.axes[4] = std::clamp(std::sin(t), 0.0f, 1.0f);
+                controller.buttonsTouched = i % 180 > 90 ? 1ull << HostSkeletonReplay::BUTTON_TRIGGER : 0;
+            }
+            frame.outputBones = recorder.onFrameUpdate(frame);
+        }
+        return frames;
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "skeleton/TwoBoneIK.h"
+
+using namespace frik;
+
+namespace
+{
+    constexpr float EPSILON = 1e-3f;
+
+    float distance(const IKVec3& a, const IKVec3& b)
+    {
+        return (a - b).length();
+    }
+}
+
+TEST(TwoBoneIKTest, ReachableTargetKeepsBoneLengths)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(-30, 30);
+    int solved = 0;
+    for (int iter = 0; iter < 1000; iter++) {
+        const IKVec3 root{ coord(rng), coord(rng), coord(rng) };
+        const IKVec3 target{ coord(rng), coord(rng), coord(rng) };
+        const IKVec3 pole{ coord(rng), coord(rng), coord(rng) };
+        const float dist = distance(root, target);
+        // reachable and not too close to the root for the triangle to exist
+        if (dist > 50 || dist < 10) {
+            continue;
+        }
+        solved++;
+
+        const auto ik = solveTwoBoneIK({ root, target, pole, 30, 25, 27.5f });
+        EXPECT_FLOAT_EQ(ik.upperLen, 30);
+        EXPECT_FLOAT_EQ(ik.lowerLen, 25);
+        EXPECT_NEAR(distance(ik.midJoint, root), 30, EPSILON);
+        EXPECT_NEAR(distance(ik.midJoint, target), 25, EPSILON);
+    }
+    EXPECT_GT(solved, 100);
+}
+
+TEST(TwoBoneIKTest, MidJointBendsTowardPole)
+{
+    const IKVec3 root{ 0, 0, 0 };
+    const IKVec3 target{ 40, 0, 0 };
+
+    // pole doesn't need to be perpendicular to the chain
+    const auto up = solveTwoBoneIK({ root, target, { 3, 0, 1 }, 30, 25, 27.5f });
+    EXPECT_GT(up.midJoint.z, 1);
+    EXPECT_NEAR(up.midJoint.y, 0, EPSILON);
+
+    const auto side = solveTwoBoneIK({ root, target, { 0, -1, 0 }, 30, 25, 27.5f });
+    EXPECT_LT(side.midJoint.y, -1);
+    EXPECT_NEAR(side.midJoint.z, 0, EPSILON);
+}
+
+TEST(TwoBoneIKTest, UnreachableTargetStretchesBonesProportionally)
+{
+    const IKVec3 root{ 0, 0, 0 };
+    const IKVec3 target{ 0, 110, 0 };
+    const auto ik = solveTwoBoneIK({ root, target, { 0, 0, 1 }, 30, 25, 27.5f });
+
+    // 55 missing length split by the bones ratio (+0.1 each to keep a tiny bend)
+    EXPECT_NEAR(ik.upperLen, 30 + 55 * 30.0f / 55 + 0.1f, EPSILON);
+    EXPECT_NEAR(ik.lowerLen, 25 + 55 * 25.0f / 55 + 0.1f, EPSILON);
+    EXPECT_NEAR(distance(ik.midJoint, target), ik.lowerLen, EPSILON);
+    EXPECT_NEAR(distance(ik.midJoint, root), ik.upperLen, 0.01f);
+    // almost straight
+    EXPECT_NEAR(ik.midJoint.y, 60, 0.5f);
+}
+
+TEST(TwoBoneIKTest, TooCloseTargetUsesFallbackLength)
+{
+    const IKVec3 root{ 0, 0, 0 };
+    // closer than upper - lower so there is no triangle
+    const IKVec3 target{ 5, 0, 0 };
+    const auto ik = solveTwoBoneIK({ root, target, { 0, 0, 1 }, 40, 10, 25 });
+
+    EXPECT_FLOAT_EQ(ik.upperLen, 25);
+    EXPECT_FLOAT_EQ(ik.lowerLen, 25);
+    EXPECT_NEAR(distance(ik.midJoint, root), 25, EPSILON);
+    EXPECT_NEAR(distance(ik.midJoint, target), 25, EPSILON);
+    EXPECT_GT(ik.midJoint.z, 0);
+}
+
+TEST(TwoBoneIKTest, TargetOnRootIsFinite)
+{
+    const IKVec3 root{ 1, 2, 3 };
+    const auto ik = solveTwoBoneIK({ root, root, { 0, 0, 1 }, 30, 25, 27.5f });
+    EXPECT_TRUE(std::isfinite(ik.midJoint.x) && std::isfinite(ik.midJoint.y) && std::isfinite(ik.midJoint.z));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "host/TestMath.h"
+#include "weapon-position/WeaponOffsetsBundle.h"
+
+using namespace frik;
+using namespace frik::test;
+
+namespace
+{
+    const std::string EMPTY_HAND = "EmptyHand";
+
+    /**
+     * Fake config weapon offsets, counting the lookups.
+     */
+    struct FakeConfig
+    {
+        std::optional<RE::NiTransform> getWeaponOffsets(const std::string& name, const WeaponOffsetsMode mode)
+        {
+            lookups++;
+            const auto it = offsets.find({ name, mode });
+            return it != offsets.end() ? std::optional(it->second) : std::nullopt;
+        }
+
+        void set(const std::string& name, const WeaponOffsetsMode mode, const RE::NiMatrix3& rotate, const float x = 0)
+        {
+            RE::NiTransform transform;
+            transform.rotate = rotate;
+            transform.translate = { x, 0, 0 };
+            offsets[{ name, mode }] = transform;
+        }
+
+        WeaponOffsetsBundle build(const std::string& weaponName)
+        {
+            return buildWeaponOffsetsBundle(weaponName, EMPTY_HAND, [this](const std::string& name, const WeaponOffsetsMode mode) {
+                return getWeaponOffsets(name, mode);
+            });
+        }
+
+        std::map<std::pair<std::string, WeaponOffsetsMode>, RE::NiTransform> offsets;
+        int lookups = 0;
+    };
+
+    bool isIdentity(const RE::NiMatrix3& matrix)
+    {
+        return maxMatrixDiff(matrix, common::MatrixUtils::getIdentityMatrix()) == 0;
+    }
+}
+
+TEST(WeaponOffsetsBundleTest, BuildsAllOffsetsOfWeapon)
+{
+    FakeConfig config;
+    const auto primary = axisAngleMatrix(1, 0, 0, 0.3);
+    const auto offhand = axisAngleMatrix(0, 1, 0, 0.7);
+    config.set("10mm", WeaponOffsetsMode::Weapon, axisAngleMatrix(0, 0, 1, 0.1), 5);
+    config.set("10mm", WeaponOffsetsMode::PrimaryHand, primary);
+    config.set("10mm", WeaponOffsetsMode::OffHand, offhand);
+    config.set("10mm", WeaponOffsetsMode::BackOfHandUI, {}, 7);
+    config.set(EMPTY_HAND, WeaponOffsetsMode::BackOfHandUI, {}, 99);
+
+    const auto bundle = config.build("10mm");
+    ASSERT_TRUE(bundle.weaponOffset.has_value());
+    EXPECT_EQ(bundle.weaponOffset->translate.x, 5);
+    ASSERT_TRUE(bundle.primaryHandOffsetRot.has_value());
+    EXPECT_EQ(maxMatrixDiff(bundle.primaryHandOffsetRot.value(), primary), 0);
+    ASSERT_TRUE(bundle.offhandOffsetRot.has_value());
+    EXPECT_EQ(maxMatrixDiff(bundle.offhandOffsetRot.value(), offhand), 0);
+    EXPECT_EQ(maxMatrixDiff(bundle.offhandOffsetRotTransposed, offhand.Transpose()), 0);
+    // weapon own back of hand offset wins over the empty hand default
+    ASSERT_TRUE(bundle.backOfHandUIOffset.has_value());
+    EXPECT_EQ(bundle.backOfHandUIOffset->translate.x, 7);
+    EXPECT_EQ(config.lookups, 4);
+}
+
+TEST(WeaponOffsetsBundleTest, MissingOffsetsAreEmptyWithDefaults)
+{
+    FakeConfig config;
+    config.set(EMPTY_HAND, WeaponOffsetsMode::BackOfHandUI, {}, 99);
+
+    const auto bundle = config.build("Unknown Gun");
+    EXPECT_FALSE(bundle.weaponOffset.has_value());
+    EXPECT_FALSE(bundle.primaryHandOffsetRot.has_value());
+    EXPECT_FALSE(bundle.offhandOffsetRot.has_value());
+    EXPECT_TRUE(isIdentity(bundle.offhandOffsetRotTransposed));
+    // back of hand UI falls back to the empty hand offset
+    ASSERT_TRUE(bundle.backOfHandUIOffset.has_value());
+    EXPECT_EQ(bundle.backOfHandUIOffset->translate.x, 99);
+    EXPECT_EQ(config.lookups, 5);
+
+    FakeConfig emptyConfig;
+    EXPECT_FALSE(emptyConfig.build("Unknown Gun").backOfHandUIOffset.has_value());
+}
+
+TEST(WeaponOffsetsBundleTest, CacheBuildsOncePerKeyAndVersion)
+{
+    FakeConfig config;
+    config.set("10mm", WeaponOffsetsMode::Weapon, {}, 1);
+    WeaponOffsetsBundleCache cache;
+    int builds = 0;
+    const auto get = [&](const WeaponOffsetsBundleKey& key, const std::uint32_t version) -> const WeaponOffsetsBundle& {
+        return cache.get(key, version, [&] {
+            builds++;
+            return config.build(key.weaponName);
+        });
+    };
+
+    EXPECT_EQ(get({ "10mm", false, false }, 1).weaponOffset->translate.x, 1);
+    EXPECT_EQ(get({ "10mm", false, false }, 1).weaponOffset->translate.x, 1);
+    EXPECT_EQ(builds, 1);
+
+    // PA and handedness are different bundles
+    get({ "10mm", true, false }, 1);
+    get({ "10mm", false, true }, 1);
+    EXPECT_EQ(builds, 3);
+
+    // config offsets changed, everything is rebuilt
+    config.set("10mm", WeaponOffsetsMode::Weapon, {}, 2);
+    EXPECT_EQ(get({ "10mm", false, false }, 2).weaponOffset->translate.x, 2);
+    get({ "10mm", true, false }, 2);
+    EXPECT_EQ(builds, 5);
+}
+
+TEST(WeaponOffsetsBundleTest, CacheEvictsLeastRecentlyUsed)
+{
+    WeaponOffsetsBundleCache cache;
+    std::vector<std::string> built;
+    const auto get = [&](const std::string& name) {
+        cache.get({ name, false, false }, 1, [&] {
+            built.push_back(name);
+            return WeaponOffsetsBundle{};
+        });
+    };
+
+    for (std::size_t i = 0; i < WeaponOffsetsBundleCache::CAPACITY; i++) {
+        get("weapon" + std::to_string(i));
+    }
+    EXPECT_EQ(built.size(), WeaponOffsetsBundleCache::CAPACITY);
+
+    // use the oldest so the second oldest is the least recently used
+    get("weapon0");
+    get("new weapon");
+    EXPECT_EQ(built.size(), WeaponOffsetsBundleCache::CAPACITY + 1);
+
+    built.clear();
+    get("weapon0");
+    for (std::size_t i = 2; i < WeaponOffsetsBundleCache::CAPACITY; i++) {
+        get("weapon" + std::to_string(i));
+    }
+    EXPECT_TRUE(built.empty());
+
+    get("weapon1");
+    EXPECT_EQ(built, std::vector<std::string>{ "weapon1" });
+}
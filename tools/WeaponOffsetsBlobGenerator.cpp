@@ -0,0 +1,113 @@
+/**
+ * Build-time tool: convert all the weapon offsets JSON files in a folder into a single sorted binary table.
+ * See "src/WeaponOffsetsBlob.h" for the format.
+ * Usage: WeaponOffsetsBlobGenerator <weapons offsets json folder> <output blob file>
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "WeaponOffsetsBlob.h"
+
+namespace fs = std::filesystem;
+using namespace frik::weapon_offsets_blob;
+
+namespace
+{
+    Entry toEntry(const nlohmann::json& value)
+    {
+        Entry entry{};
+        const auto& rotation = value.at("rotation");
+        if (rotation.size() != 12) {
+            throw std::runtime_error("rotation must have 12 values");
+        }
+        for (std::size_t i = 0; i < 12; i++) {
+            entry.rotation[i] = rotation[i].get<float>();
+        }
+        entry.translate[0] = value.at("x").get<float>();
+        entry.translate[1] = value.at("y").get<float>();
+        entry.translate[2] = value.at("z").get<float>();
+        entry.scale = value.at("scale").get<float>();
+        return entry;
+    }
+
+    template <typename T>
+    void write(std::ofstream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "Usage: WeaponOffsetsBlobGenerator <weapons offsets json folder> <output blob file>\n";
+        return 1;
+    }
+
+    // sorted file order for deterministic output, std::map keeps the entries sorted by name for the binary search
+    std::vector<fs::path> files;
+    for (const auto& file : fs::directory_iterator(argv[1])) {
+        if (file.is_regular_file() && file.path().extension() == ".json") {
+            files.push_back(file.path());
+        }
+    }
+    std::ranges::sort(files);
+
+    std::map<std::string, Entry> entries;
+    for (const auto& file : files) {
+        try {
+            std::ifstream stream(file);
+            const auto json = nlohmann::json::parse(stream);
+            for (const auto& [name, value] : json.items()) {
+                if (entries.contains(name)) {
+                    std::cout << "Duplicate weapon offset '" << name << "' in '" << file.filename().string() << "', overriding\n";
+                }
+                entries[name] = toEntry(value);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to convert weapon offsets file '" << file.string() << "': " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::string names;
+    for (auto& [name, entry] : entries) {
+        entry.nameOffset = static_cast<std::uint32_t>(names.size());
+        entry.nameLength = static_cast<std::uint32_t>(name.size());
+        names += name;
+    }
+
+    const Header header{
+        .magic = MAGIC,
+        .version = VERSION,
+        .entriesCount = static_cast<std::uint32_t>(entries.size()),
+        .entriesOffset = sizeof(Header),
+        .namesOffset = static_cast<std::uint32_t>(sizeof(Header) + entries.size() * sizeof(Entry)),
+        .namesSize = static_cast<std::uint32_t>(names.size())
+    };
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open output file '" << argv[2] << "'\n";
+        return 1;
+    }
+    write(out, header);
+    for (const auto& entry : entries | std::views::values) {
+        write(out, entry);
+    }
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    if (!out) {
+        std::cerr << "Failed to write output file '" << argv[2] << "'\n";
+        return 1;
+    }
+
+    std::cout << "Weapon offsets blob: " << entries.size() << " entries from " << files.size() << " files\n";
+    return 0;
+}